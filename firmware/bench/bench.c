@@ -0,0 +1,257 @@
+/*
+ * bench.c - Imagem de benchmark (make bench -> bench.bin)
+ * Mede em ciclos os núcleos do firmware e, com COREMARK_DIR, o CoreMark.
+ * Roda no boot e de novo a cada 'r' na serial; a saída é um bloco CSV
+ * entre "BENCH BEGIN" e "BENCH END" para o tools/bench_run.py. A mesma
+ * fonte compila contra o SoC da placa ou o simulado (litex/colorlight_i5_sim.py).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <irq.h>
+#include <uart.h>
+#include <generated/csr.h>
+#include <generated/soc.h>
+#include <system.h>
+
+#include "time_driver.h"
+#include "i2c_driver.h"
+#include "max3010x.h"
+#include "ST7789.h"
+#include "gfx.h"
+#include "gfx_font.h"
+#include "color565.h"
+#include "fastmem.h"
+#include "prof.h"
+
+#ifndef CONFIG_L2_SIZE
+#define CONFIG_L2_SIZE 0
+#endif
+
+typedef bool (*bench_fn)(uint32_t param);
+
+typedef struct {
+    const char *name;
+    const char *label;     // Coluna param do CSV
+    uint32_t    param;     // Argumento do núcleo (tamanho, modo...)
+    uint32_t    units;     // Itens por repetição: amostras, pixels, bytes...
+    uint16_t    reps;
+    bench_fn    fn;        // false: não mediu nada útil (ex.: I2C sem resposta)
+} bench_t;
+
+/* ================= RELÓGIO ================= */
+
+static uint32_t overhead;   // Custo de um par de leituras do relógio
+
+static void calibra(void) {
+    uint32_t best = UINT32_MAX;
+
+    for (int i = 0; i < 16; i++) {
+        uint64_t t0 = time_get_cycles();
+        uint32_t d = (uint32_t)(time_get_cycles() - t0);
+        if (d < best) best = d;
+    }
+    overhead = best;
+}
+
+/* ================= NÚCLEOS ================= */
+
+/* RGB565: lote de leituras C/R/G/B sintéticas; o modo é trocado fora da medida */
+#define COR_N 256
+static color_raw_t cor_in[COR_N];
+static uint16_t cor_out[COR_N];
+
+static bool k_rgb565(uint32_t mode) {
+    color565_convert_batch(cor_in, cor_out, COR_N);
+    (void)mode;
+    return true;
+}
+
+/* PPG: forma de onda triangular a 1,2 Hz (100 Hz), acima do limiar de dedo */
+#define PPG_N     1000
+#define PPG_BLOCK 32
+static max3010x_ctx_t ppg;
+static max3010x_sample_t ppg_in[PPG_N];
+
+static bool k_ppg(uint32_t block) {
+    for (uint32_t i = 0; i + block <= PPG_N; i += block)
+        max3010x_process_block(&ppg, &ppg_in[i], (int)block);
+    return true;
+}
+
+/* Texto: 20 caracteres com a fonte clássica (tamanho 2) e a 7 segmentos */
+static const char texto[] = "12:34 -56.78 90:12.3";
+
+static bool k_texto(uint32_t seg7) {
+    gfx_set_font(seg7 ? &gfx_font_seg7 : NULL);
+    gfx_set_text_size(seg7 ? 1 : 2);
+    gfx_set_text_colors(ST77XX_WHITE, ST77XX_BLACK);
+    gfx_set_cursor(0, 100);
+    gfx_print(texto);
+    gfx_set_font(NULL);
+    return true;
+}
+
+/* fill_rect: lado codificado como (w << 16) | h */
+static bool k_fill(uint32_t wh) {
+    gfx_fill_rect(0, 0, (int16_t)(wh >> 16), (int16_t)(wh & 0xFFFF), ST77XX_BLUE);
+    return true;
+}
+
+/* I2C: leitura em rajada do MAX3010x (sem ponteiro: continua de onde parou) */
+static uint8_t i2c_buf[255];
+
+static bool k_i2c(uint32_t len) {
+    return bb_i2c_read(MAX3010X_I2C_ADDR, i2c_buf, (uint8_t)len);
+}
+
+/* memcpy/memset: 4 KB na SRAM (FAST_DATA) contra a SDRAM, dentro e fora do L2 */
+#define SRAM_BUF  4096
+#define SDRAM_BUF (64 * 1024)
+static FAST_DATA uint8_t sram_buf[SRAM_BUF] __attribute__((aligned(4)));
+static uint8_t sdram_buf[SDRAM_BUF] __attribute__((aligned(4)));
+
+static bool k_memset_sram(uint32_t n)  { memset(sram_buf, 0x5A, n); return true; }
+static bool k_memcpy_sram(uint32_t n)  { memcpy(sram_buf, sram_buf + n, n); return true; }
+static bool k_memset_sdram(uint32_t n) { memset(sdram_buf, 0x5A, n); return true; }
+static bool k_memcpy_sdram(uint32_t n) { memcpy(sdram_buf, sdram_buf + n, n); return true; }
+
+#ifdef BENCH_COREMARK
+/* bench/coremark/core_portme.c: roda o CoreMark uma vez (COREMARK_ITERATIONS) */
+extern int coremark_main(void);
+
+static bool k_coremark(uint32_t iters) {
+    (void)iters;
+    coremark_main();
+    return true;
+}
+#endif
+
+#define WH(w, h) (((uint32_t)(w) << 16) | (h))
+
+static const bench_t benches[] = {
+#ifdef BENCH_COREMARK
+    { "coremark",     "iter",     COREMARK_ITERATIONS, COREMARK_ITERATIONS, 1, k_coremark },
+#endif
+    { "rgb565",       "norm",     COLOR565_NORM,     COR_N,             8,  k_rgb565 },
+    { "rgb565",       "gamma",    COLOR565_GAMMA,    COR_N,             8,  k_rgb565 },
+    { "rgb565",       "wb_gamma", COLOR565_WB_GAMMA, COR_N,             8,  k_rgb565 },
+    { "ppg_sample",   "block32",  PPG_BLOCK,         PPG_N / PPG_BLOCK * PPG_BLOCK, 4, k_ppg },
+    { "text",         "5x7x2",    0,                 sizeof(texto) - 1, 4,  k_texto },
+    { "text",         "seg7",     1,                 sizeof(texto) - 1, 4,  k_texto },
+    { "fill_rect",    "1x1",      WH(1, 1),          1,                 16, k_fill },
+    { "fill_rect",    "16x16",    WH(16, 16),        16 * 16,           8,  k_fill },
+    { "fill_rect",    "64x64",    WH(64, 64),        64 * 64,           4,  k_fill },
+    { "fill_rect",    "320x30",   WH(320, 30),       320 * 30,          4,  k_fill },
+    { "fill_rect",    "320x240",  WH(320, 240),      320 * 240,         2,  k_fill },
+    { "i2c_read",     "6",        6,                 6,                 8,  k_i2c },
+    { "i2c_read",     "192",      192,               192,               4,  k_i2c },
+    { "memset_sram",  "4096",     SRAM_BUF,          SRAM_BUF,          8,  k_memset_sram },
+    { "memcpy_sram",  "2048",     SRAM_BUF / 2,      SRAM_BUF / 2,      8,  k_memcpy_sram },
+    { "memset_sdram", "4096",     SRAM_BUF,          SRAM_BUF,          8,  k_memset_sdram },
+    { "memcpy_sdram", "2048",     SRAM_BUF / 2,      SRAM_BUF / 2,      8,  k_memcpy_sdram },
+    { "memset_sdram", "65536",    SDRAM_BUF,         SDRAM_BUF,         4,  k_memset_sdram },
+    { "memcpy_sdram", "32768",    SDRAM_BUF / 2,     SDRAM_BUF / 2,     4,  k_memcpy_sdram },
+};
+
+/* ================= EXECUÇÃO ================= */
+
+static void prepara(void) {
+    const max3010x_config_t cfg = MAX3010X_CONFIG_DEFAULT;
+
+    for (int i = 0; i < COR_N; i++) {
+        cor_in[i].c = (uint16_t)(4000 + i * 97);
+        cor_in[i].r = (uint16_t)(cor_in[i].c / 3 + i);
+        cor_in[i].g = (uint16_t)(cor_in[i].c / 4 + 2 * i);
+        cor_in[i].b = (uint16_t)(cor_in[i].c / 5 + 3 * i);
+    }
+
+    for (int i = 0; i < PPG_N; i++) {
+        int fase = i % 83;                         // ~1,2 Hz a 100 Hz
+        int tri = fase < 41 ? fase : 83 - fase;
+        ppg_in[i].ir = 120000u + (uint32_t)tri * 150u;
+        ppg_in[i].red = 90000u + (uint32_t)tri * 110u;
+    }
+
+    /* Sem sensor o I2C não responde, mas a configuração zera o estado do PPG */
+    memset(&ppg, 0, sizeof(ppg));
+    ppg.i2c_addr = MAX3010X_I2C_ADDR;
+    max3010x_configure(&ppg, &cfg);
+
+    st7789_init(240, 320);
+    st7789_set_rotation(1);
+}
+
+static void roda(const bench_t *b) {
+    uint32_t min = UINT32_MAX, per_x100;
+    uint64_t total = 0;
+    bool ok;
+
+    if (b->fn == k_rgb565) color565_set_mode((color565_mode_t)b->param);
+
+    ok = b->fn(b->param);   // Aquecimento: caches, LUTs, fontes
+    for (int r = 0; r < b->reps; r++) {
+        uint64_t t0 = time_get_cycles();
+        ok = b->fn(b->param) && ok;
+        uint32_t d = (uint32_t)(time_get_cycles() - t0);
+
+        d = d > overhead ? d - overhead : 0;
+        total += d;
+        if (d < min) min = d;
+    }
+
+    per_x100 = (uint32_t)(((uint64_t)min * 100 + b->units / 2) / b->units);
+    printf("%s,%s,%d,%u,%lu,%lu,%lu,%lu.%02lu\n", b->name, b->label,
+           ok, b->reps, (unsigned long)b->units, (unsigned long)min,
+           (unsigned long)(total / b->reps),
+           (unsigned long)(per_x100 / 100), (unsigned long)(per_x100 % 100));
+}
+
+static void roda_todos(void) {
+    printf("BENCH BEGIN ident=\"%s\" cpu=%s clk=%lu l2=%lu fastmem=%d\n",
+           CONFIG_IDENTIFIER, CONFIG_CPU_HUMAN_NAME, (unsigned long)CONFIG_CLOCK_FREQUENCY,
+           (unsigned long)CONFIG_L2_SIZE, FASTMEM);
+    printf("kernel,param,ok,reps,units,cycles_min,cycles_mean,cycles_per_unit\n");
+    for (unsigned i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+        roda(&benches[i]);
+    printf("BENCH END\n");
+}
+
+// ============================================
+// === main ===
+// ============================================
+
+int main(void) {
+
+    fastmem_init();
+
+#ifdef CONFIG_CPU_HAS_INTERRUPT
+    irq_setmask(0);
+    irq_setie(1);
+#endif
+
+    uart_init();
+    bb_i2c_init();
+
+#ifdef CSR_TIMER0_BASE
+    timer0_en_write(0);
+    timer0_reload_write(0);
+    timer0_load_write(CONFIG_CLOCK_FREQUENCY / 1000000);
+    timer0_en_write(1);
+    timer0_update_value_write(1);
+#endif
+
+    calibra();
+    prepara();
+    roda_todos();
+
+    // 'r' repete (o bench_run.py usa para pegar um bloco inteiro)
+    while (1) {
+        if (uart_read_nonblock() && uart_read() == 'r') roda_todos();
+    }
+
+    return 0;
+}
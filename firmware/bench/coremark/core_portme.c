@@ -0,0 +1,59 @@
+/*
+ * core_portme.c - Tempo e sementes do CoreMark no SoC LiteX
+ * Um único contexto, memória estática; o bench.c chama coremark_main()
+ * e mede por fora as COREMARK_ITERATIONS iterações.
+ */
+
+#include "coremark.h"
+#include "core_portme.h"
+#include "time_driver.h"
+
+#include <generated/soc.h>   // CONFIG_CLOCK_FREQUENCY
+
+#if VALIDATION_RUN
+volatile ee_s32 seed1_volatile = 0x3415;
+volatile ee_s32 seed2_volatile = 0x3415;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PERFORMANCE_RUN
+volatile ee_s32 seed1_volatile = 0x0;
+volatile ee_s32 seed2_volatile = 0x0;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PROFILE_RUN
+volatile ee_s32 seed1_volatile = 0x8;
+volatile ee_s32 seed2_volatile = 0x8;
+volatile ee_s32 seed3_volatile = 0x8;
+#endif
+volatile ee_s32 seed4_volatile = ITERATIONS;
+volatile ee_s32 seed5_volatile = 0;
+
+ee_u32 default_num_contexts = 1;
+
+static CORE_TICKS start_time_val, stop_time_val;
+
+void start_time(void) {
+    start_time_val = (CORE_TICKS)time_get_cycles();
+}
+
+void stop_time(void) {
+    stop_time_val = (CORE_TICKS)time_get_cycles();
+}
+
+CORE_TICKS get_time(void) {
+    return stop_time_val - start_time_val;
+}
+
+secs_ret time_in_secs(CORE_TICKS ticks) {
+    return (secs_ret)(ticks / CONFIG_CLOCK_FREQUENCY);
+}
+
+void portable_init(core_portable *p, int *argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    p->portable_id = 1;
+}
+
+void portable_fini(core_portable *p) {
+    p->portable_id = 0;
+}
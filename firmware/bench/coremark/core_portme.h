@@ -0,0 +1,78 @@
+/*
+ * core_portme.h - Porte do CoreMark (EEMBC) para o SoC LiteX deste projeto
+ * As fontes do CoreMark não vêm no repositório: make bench COREMARK_DIR=<checkout>
+ * compila core_*.c de lá com este porte. Tempo pelo uptime do timer0.
+ */
+
+#ifndef CORE_PORTME_H
+#define CORE_PORTME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HAS_FLOAT   0        // printf da picolibc só com inteiros (PICOLIBC_FORMAT=integer)
+#define HAS_TIME_H  0
+#define USE_CLOCK   0
+#define HAS_STDIO   1
+#define HAS_PRINTF  1
+
+#ifndef COMPILER_VERSION
+#ifdef __GNUC__
+#define COMPILER_VERSION "GCC"__VERSION__
+#else
+#define COMPILER_VERSION "?"
+#endif
+#endif
+#ifndef COMPILER_FLAGS
+#define COMPILER_FLAGS "CFLAGS do common.mak (LiteX)"
+#endif
+#ifndef MEM_LOCATION
+#define MEM_LOCATION "STATIC (main_ram)"
+#endif
+
+typedef int16_t   ee_s16;
+typedef uint16_t  ee_u16;
+typedef int32_t   ee_s32;
+typedef float     ee_f32;
+typedef uint8_t   ee_u8;
+typedef uint32_t  ee_u32;
+typedef uintptr_t ee_ptr_int;
+typedef size_t    ee_size_t;
+
+#define NULL_PTR ((void *)0)
+
+#define align_mem(x) (void *)(4 + (((ee_ptr_int)(x) - 1) & ~3))
+
+/* Ciclos de CONFIG_CLOCK_FREQUENCY; 32 bits bastam para ~70 s a 60 MHz */
+#define CORETIMETYPE ee_u32
+typedef ee_u32 CORE_TICKS;
+
+#define SEED_METHOD       SEED_VOLATILE
+#define MEM_METHOD        MEM_STATIC
+#define MULTITHREAD       1
+#define USE_PTHREAD       0
+#define USE_FORK          0
+#define USE_SOCKET        0
+#define MAIN_HAS_NOARGC   1  // core_main.c compila com -Dmain=coremark_main
+#define MAIN_HAS_NORETURN 0
+
+extern ee_u32 default_num_contexts;
+
+typedef struct CORE_PORTABLE_S {
+    ee_u8 portable_id;
+} core_portable;
+
+void portable_init(core_portable *p, int *argc, char *argv[]);
+void portable_fini(core_portable *p);
+
+#if !defined(PROFILE_RUN) && !defined(PERFORMANCE_RUN) && !defined(VALIDATION_RUN)
+#if (TOTAL_DATA_SIZE == 1200)
+#define PROFILE_RUN 1
+#elif (TOTAL_DATA_SIZE == 2000)
+#define PERFORMANCE_RUN 1
+#else
+#define VALIDATION_RUN 1
+#endif
+#endif
+
+#endif // CORE_PORTME_H
@@ -0,0 +1,180 @@
+/*
+ * gfx_bench.c - Benchmark de banda das primitivas gfx_* no PC
+ *
+ * Executa cada primitiva sobre o modelo do painel (st7789_host.c) e imprime,
+ * em CSV, o tráfego SPI gerado e um hash do quadro resultante. O hash permite
+ * comparar pixel a pixel a saída antes/depois de uma mudança no desenho.
+ *
+ * Com --check, confere o hash de cada primitiva contra o arquivo de
+ * referência (linhas "op,hash", ver gfx_golden.csv) e sai com erro se algum
+ * quadro mudou ou faltou; o tráfego SPI pode mudar à vontade.
+ *
+ * Uso: ./gfx_bench [--check gfx_golden.csv] [snapshot.png | snapshot.ppm]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ST7789.h"
+#include "gfx.h"
+#include "st7789_host.h"
+
+/* FNV-1a sobre a tela inteira na orientação atual */
+static uint32_t frame_hash(void) {
+    uint32_t h = 2166136261u;
+    for (int y = 0; y < st7789_host_height(); y++) {
+        for (int x = 0; x < st7789_host_width(); x++) {
+            uint16_t p = st7789_host_get_pixel(x, y);
+            h = (h ^ (p & 0xFF)) * 16777619u;
+            h = (h ^ (p >> 8)) * 16777619u;
+        }
+    }
+    return h;
+}
+
+/* Hashes de referência (--check) */
+#define GOLDEN_MAX 64
+
+static struct {
+    char op[32];
+    uint32_t hash;
+    int seen;
+} golden[GOLDEN_MAX];
+static int golden_n;
+static int falhas;
+
+static int golden_load(const char *path) {
+    char line[96];
+    FILE *f = fopen(path, "r");
+
+    if (!f) return -1;
+    while (fgets(line, sizeof(line), f) && golden_n < GOLDEN_MAX) {
+        char *sep = strchr(line, ',');
+
+        if (line[0] == '#' || !sep) continue;
+        *sep = '\0';
+        snprintf(golden[golden_n].op, sizeof(golden[0].op), "%.31s", line);
+        golden[golden_n].hash = (uint32_t)strtoul(sep + 1, NULL, 16);
+        golden[golden_n].seen = 0;
+        golden_n++;
+    }
+    fclose(f);
+    return 0;
+}
+
+static void golden_check(const char *op, uint32_t hash) {
+    for (int i = 0; i < golden_n; i++) {
+        if (strcmp(golden[i].op, op) != 0) continue;
+        golden[i].seen = 1;
+        if (golden[i].hash != hash) {
+            fprintf(stderr, "FALHA %s: hash %08x, referência %08x\n", op, hash, golden[i].hash);
+            falhas++;
+        }
+        return;
+    }
+    fprintf(stderr, "FALHA %s: sem referência\n", op);
+    falhas++;
+}
+
+static void report(const char *op) {
+    st7789_host_stats_t s = st7789_host_get_stats();
+    uint32_t hash = frame_hash();
+
+    printf("%s,%u,%u,%u,%u,%u,%u,%08x\n", op,
+           s.spi_bytes, s.cmd_bytes, s.data_bytes,
+           s.cs_toggles, s.commands, s.pixels, hash);
+    if (golden_n) golden_check(op, hash);
+}
+
+#define BENCH(op, code) do { st7789_host_reset_stats(); code; report(op); } while (0)
+
+static uint16_t sprite[32 * 32];
+
+int main(int argc, char **argv) {
+    const char *snapshot = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            if (golden_load(argv[++i]) || golden_n == 0) {
+                fprintf(stderr, "Erro lendo %s\n", argv[i]);
+                return 1;
+            }
+        } else snapshot = argv[i];
+    }
+
+    for (int i = 0; i < 32 * 32; i++) {
+        sprite[i] = (uint16_t)(((i & 31) << 11) | ((i >> 5) << 6) | (i & 31));
+    }
+
+    printf("op,spi_bytes,cmd_bytes,data_bytes,cs_toggles,commands,pixels,frame_hash\n");
+
+    BENCH("st7789_init", {
+        st7789_init(240, 320);
+        st7789_set_rotation(1);
+    });
+
+    BENCH("fill_screen",          gfx_fill_screen(ST77XX_BLACK));
+    BENCH("fill_rect_8x8",        gfx_fill_rect(10, 10, 8, 8, ST77XX_RED));
+    BENCH("fill_rect_32x32",      gfx_fill_rect(30, 10, 32, 32, ST77XX_GREEN));
+    BENCH("fill_rect_100x100",    gfx_fill_rect(70, 10, 100, 100, ST77XX_BLUE));
+    BENCH("fill_rect_offscreen",  gfx_fill_rect(300, 200, 100, 100, ST77XX_YELLOW));
+    BENCH("draw_pixel",           gfx_draw_pixel(5, 5, ST77XX_WHITE));
+    BENCH("hline_320",            gfx_draw_fast_hline(0, 120, 320, ST77XX_WHITE));
+    BENCH("vline_240",            gfx_draw_fast_vline(160, 0, 240, ST77XX_WHITE));
+    BENCH("draw_line_diag",       gfx_draw_line(0, 0, 319, 239, ST77XX_CYAN));
+    BENCH("draw_rect_320x240",    gfx_draw_rect(0, 0, 320, 240, ST77XX_WHITE));
+    BENCH("draw_circle_r30",      gfx_draw_circle(240, 60, 30, ST77XX_MAGENTA));
+    BENCH("fill_circle_r30",      gfx_fill_circle(240, 170, 30, ST77XX_ORANGE));
+    BENCH("bitmap_32x32",         gfx_draw_bitmap(190, 120, sprite, 32, 32));
+    BENCH("bitmap_32x32_clipped", gfx_draw_bitmap(304, 224, sprite, 32, 32));
+
+    BENCH("print_glcd_s1_10ch", {
+        gfx_set_font(NULL);
+        gfx_set_text_size(1);
+        gfx_set_text_color(ST77XX_WHITE);
+        gfx_set_cursor(10, 130);
+        gfx_print("Hello GFX!");
+    });
+    BENCH("print_glcd_s2_10ch", {
+        gfx_set_text_size(2);
+        gfx_set_cursor(10, 145);
+        gfx_print("Hello GFX!");
+    });
+    BENCH("print_10x14_10ch", {
+        gfx_set_font(&gfx_font_10x14);
+        gfx_set_cursor(10, 170);
+        gfx_print("Hello GFX!");
+    });
+    BENCH("print_prop_10ch", {
+        gfx_set_font(&gfx_font_prop);
+        gfx_set_cursor(10, 190);
+        gfx_print("Hello GFX!");
+    });
+    BENCH("print_seg7_opaque_6ch", {
+        gfx_set_font(&gfx_font_seg7);
+        gfx_set_text_colors(ST77XX_WHITE, ST77XX_BLACK);
+        gfx_set_cursor(10, 205);
+        gfx_print("123.45");
+        gfx_set_font(NULL);
+        gfx_set_text_color(ST77XX_WHITE);
+    });
+
+    if (snapshot) {
+        size_t n = strlen(snapshot);
+        int png = n > 4 && strcmp(snapshot + n - 4, ".png") == 0;
+        int err = png ? st7789_host_write_png(snapshot) : st7789_host_write_ppm(snapshot);
+        if (err) {
+            fprintf(stderr, "Erro gravando %s\n", snapshot);
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < golden_n; i++) {
+        if (golden[i].seen) continue;
+        fprintf(stderr, "FALHA %s: primitiva da referência não rodou\n", golden[i].op);
+        falhas++;
+    }
+    if (golden_n) fprintf(stderr, "gfx_bench: %s\n", falhas ? "FALHOU" : "ok");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * ring_bench.c - Vazão do buffer SPSC (incs/ring/ring.h) no PC
+ *
+ * Mede push/pop unitário, bulk e reserve/commit numa thread só, e o caso
+ * real de produtor e consumidor em threads separadas. Cada leitura confere
+ * a sequência produzida; qualquer elemento fora de ordem, perdido ou
+ * duplicado encerra com erro, então o benchmark também serve de checagem
+ * do cabeçalho no PC.
+ *
+ * Uso: ./ring_bench [milhões de elementos, padrão 20]
+ * Saída: CSV op,elements,ns_per_elem,melems_per_s,checksum
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ring.h"
+
+RING_DEFINE(ring_u32, uint32_t, 1024)
+
+typedef struct {
+    uint16_t red[3], ir[3];
+    uint64_t t;
+} sample_t;
+
+RING_DEFINE(ring_smp, sample_t, 64)
+
+static ring_u32_t r32;
+static ring_smp_t rsmp;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fail(const char *op, uint64_t got, uint64_t want) {
+    fprintf(stderr, "%s: sequência quebrada (lido %llu, esperado %llu)\n",
+            op, (unsigned long long)got, (unsigned long long)want);
+    exit(1);
+}
+
+static void report(const char *op, uint64_t n, double dt, uint64_t sum) {
+    printf("%s,%llu,%.2f,%.1f,%016llx\n", op, (unsigned long long)n,
+           dt * 1e9 / n, n / dt / 1e6, (unsigned long long)sum);
+}
+
+/* ================= UMA THREAD ================= */
+
+static void bench_single(uint64_t n) {
+    uint32_t in = 0, out = 0, v;
+    uint64_t sum = 0;
+    double t0 = now_s();
+
+    ring_u32_init(&r32);
+    while (out < n) {
+        while (in < n && ring_u32_push(&r32, &in)) in++;
+        while (ring_u32_pop(&r32, &v)) {
+            if (v != out) fail("push_pop", v, out);
+            sum += v;
+            out++;
+        }
+    }
+    report("push_pop", n, now_s() - t0, sum);
+}
+
+static void bench_bulk(uint64_t n, uint32_t chunk) {
+    uint32_t src[256], dst[256];
+    uint32_t in = 0, out = 0;
+    uint64_t sum = 0;
+    char op[32];
+    double t0 = now_s();
+
+    ring_u32_init(&r32);
+    while (out < n) {
+        uint32_t k = (n - in < chunk) ? (uint32_t)(n - in) : chunk, got;
+
+        for (uint32_t i = 0; i < k; i++) src[i] = in + i;
+        in += ring_u32_push_n(&r32, src, k);
+
+        got = ring_u32_pop_n(&r32, dst, chunk - 3);   // Fora de fase com o push
+        for (uint32_t i = 0; i < got; i++, out++) {
+            if (dst[i] != out) fail("bulk", dst[i], out);
+            sum += dst[i];
+        }
+    }
+    snprintf(op, sizeof(op), "bulk_%u", chunk);
+    report(op, n, now_s() - t0, sum);
+}
+
+static void bench_reserve(uint64_t n) {
+    uint64_t in = 0, out = 0, sum = 0;
+    double t0 = now_s();
+
+    ring_smp_init(&rsmp);
+    while (out < n) {
+        sample_t *w;
+        const sample_t *r;
+
+        while (in < n && (w = ring_smp_reserve(&rsmp)) != NULL) {
+            w->red[0] = (uint16_t)in;
+            w->ir[0] = (uint16_t)~in;
+            w->t = in++;
+            ring_smp_commit(&rsmp);
+        }
+        while ((r = ring_smp_peek(&rsmp)) != NULL) {
+            if (r->t != out || r->red[0] != (uint16_t)out) fail("reserve_commit", r->t, out);
+            sum += r->t;
+            out++;
+            ring_smp_release(&rsmp);
+        }
+    }
+    report("reserve_commit", n, now_s() - t0, sum);
+}
+
+/* ================= DUAS THREADS ================= */
+
+static uint64_t spsc_n;
+
+static void *producer(void *arg) {
+    (void)arg;
+    for (uint32_t i = 0; i < spsc_n; ) {
+        uint32_t *slot = ring_u32_reserve(&r32);
+        if (!slot) {
+            sched_yield();   // Cheio: cede a CPU (máquinas de um núcleo)
+            continue;
+        }
+        *slot = i++;
+        ring_u32_commit(&r32);
+    }
+    return NULL;
+}
+
+static void bench_spsc(uint64_t n) {
+    pthread_t th;
+    uint32_t buf[64], out = 0;
+    uint64_t sum = 0;
+    double t0;
+
+    ring_u32_init(&r32);
+    spsc_n = n;
+    t0 = now_s();
+    pthread_create(&th, NULL, producer, NULL);
+    while (out < n) {
+        uint32_t got = ring_u32_pop_n(&r32, buf, 64);
+        if (got == 0) sched_yield();
+        for (uint32_t i = 0; i < got; i++, out++) {
+            if (buf[i] != out) fail("spsc_threads", buf[i], out);
+            sum += buf[i];
+        }
+    }
+    pthread_join(th, NULL);
+    report("spsc_threads", n, now_s() - t0, sum);
+}
+
+int main(int argc, char **argv) {
+    uint64_t n = (argc > 1 ? strtoull(argv[1], NULL, 0) : 20) * 1000000ull;
+
+    printf("op,elements,ns_per_elem,melems_per_s,checksum\n");
+    bench_single(n);
+    bench_bulk(n, 16);
+    bench_bulk(n, 256);
+    bench_reserve(n);
+    bench_spsc(n);
+    return 0;
+}
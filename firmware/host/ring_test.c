@@ -0,0 +1,173 @@
+// ring_test.c - Testes de incs/ring/ring.h (buffer SPSC) numa thread só:
+// cheio/vazio, flush, count/space, bulk e reserve/commit na borda do
+// buffer, e a volta dos índices de 32 bits (head/tail perto de 0xFFFFFFFF).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ring.h"
+
+RING_DEFINE(ring8, uint32_t, 8)
+
+static int falhas;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FALHA %s:%d: ", __FILE__, __LINE__);            \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        falhas++;                                               \
+    }                                                           \
+} while (0)
+
+/* Ring com os dois índices em base (vazio); o conteúdo não importa */
+static void init_em(ring8_t *r, uint32_t base) {
+    ring8_init(r);
+    r->head = base;
+    r->tail = base;
+}
+
+/* Ocupação coerente nos três acessores */
+static void check_count(const ring8_t *r, uint32_t n, const char *ctx) {
+    CHECK(ring8_count(r) == n, "%s: count %u, esperado %u", ctx, ring8_count(r), n);
+    CHECK(ring8_space(r) == ring8_CAPACITY - n, "%s: space %u", ctx, ring8_space(r));
+    CHECK(ring8_empty(r) == (n == 0), "%s: empty", ctx);
+}
+
+static void test_cheio_vazio(uint32_t base) {
+    ring8_t r;
+    uint32_t v;
+
+    init_em(&r, base);
+    check_count(&r, 0, "novo");
+    CHECK(!ring8_pop(&r, &v), "pop no vazio");
+    CHECK(ring8_peek(&r) == NULL, "peek no vazio");
+    CHECK(ring8_pop_n(&r, &v, 1) == 0, "pop_n no vazio");
+
+    for (uint32_t i = 0; i < ring8_CAPACITY; i++) {
+        CHECK(ring8_push(&r, &i), "push %u", i);
+        check_count(&r, i + 1, "enchendo");
+    }
+    v = 99;
+    CHECK(!ring8_push(&r, &v), "push no cheio");
+    CHECK(ring8_reserve(&r) == NULL, "reserve no cheio");
+    CHECK(ring8_push_n(&r, &v, 1) == 0, "push_n no cheio");
+    check_count(&r, ring8_CAPACITY, "cheio");
+
+    for (uint32_t i = 0; i < ring8_CAPACITY; i++) {
+        CHECK(ring8_pop(&r, &v) && v == i, "pop %u: %u", i, v);
+        check_count(&r, ring8_CAPACITY - i - 1, "esvaziando");
+    }
+    CHECK(!ring8_pop(&r, &v), "pop depois de esvaziar");
+    CHECK(r.head == base + ring8_CAPACITY && r.tail == r.head, "indices depois de uma volta");
+}
+
+static void test_flush(uint32_t base) {
+    ring8_t r;
+    uint32_t v = 0;
+
+    init_em(&r, base);
+    for (int i = 0; i < 5; i++) ring8_push(&r, &v);
+    ring8_flush(&r);
+    check_count(&r, 0, "flush");
+    CHECK(ring8_peek(&r) == NULL, "peek depois do flush");
+
+    /* Continua usável com os índices onde o flush deixou */
+    v = 42;
+    CHECK(ring8_push(&r, &v), "push depois do flush");
+    CHECK(ring8_pop(&r, &v) && v == 42, "pop depois do flush");
+}
+
+/* push_n/pop_n começando em cada posição: cobre a cópia em dois pedaços */
+static void test_bulk(uint32_t base) {
+    for (uint32_t ofs = 0; ofs < ring8_CAPACITY; ofs++) {
+        ring8_t r;
+        uint32_t in[ring8_CAPACITY + 2], out[ring8_CAPACITY + 2];
+        uint32_t n;
+
+        init_em(&r, base + ofs);
+        for (uint32_t i = 0; i < ring8_CAPACITY + 2; i++) in[i] = 1000 * ofs + i;
+
+        n = ring8_push_n(&r, in, ring8_CAPACITY + 2);   // Mais que o espaço
+        CHECK(n == ring8_CAPACITY, "ofs %u: push_n aceitou %u", ofs, n);
+        check_count(&r, ring8_CAPACITY, "push_n");
+
+        n = ring8_pop_n(&r, out, 3);
+        CHECK(n == 3, "ofs %u: pop_n parcial %u", ofs, n);
+        n = ring8_push_n(&r, in + ring8_CAPACITY, 2);
+        CHECK(n == 2, "ofs %u: push_n no espaço liberado %u", ofs, n);
+
+        n = ring8_pop_n(&r, out + 3, ring8_CAPACITY + 2);   // Mais que o conteúdo
+        CHECK(n == ring8_CAPACITY - 1, "ofs %u: pop_n devolveu %u", ofs, n);
+        for (uint32_t i = 0; i < ring8_CAPACITY + 2; i++)
+            CHECK(out[i] == in[i], "ofs %u: out[%u] = %u, esperado %u", ofs, i, out[i], in[i]);
+        check_count(&r, 0, "pop_n");
+    }
+}
+
+/* reserve/commit e peek/release cruzando o fim do buffer */
+static void test_reserve(uint32_t base) {
+    ring8_t r;
+    uint32_t *w;
+    const uint32_t *p;
+
+    init_em(&r, base + ring8_CAPACITY - 2);   // Índice físico 6 (ou o da base)
+    for (uint32_t i = 0; i < ring8_CAPACITY; i++) {
+        w = ring8_reserve(&r);
+        CHECK(w != NULL, "reserve %u", i);
+        if (!w) return;
+        CHECK(w == &r.buf[(base + ring8_CAPACITY - 2 + i) & (ring8_CAPACITY - 1)],
+              "reserve %u fora do slot", i);
+        *w = 500 + i;
+        CHECK(ring8_count(&r) == i, "reserve publicou antes do commit");
+        ring8_commit(&r);
+    }
+    CHECK(ring8_reserve(&r) == NULL, "reserve no cheio");
+
+    for (uint32_t i = 0; i < ring8_CAPACITY; i++) {
+        p = ring8_peek(&r);
+        CHECK(p != NULL && *p == 500 + i, "peek %u", i);
+        if (!p) return;
+        CHECK(ring8_peek(&r) == p, "peek repetido mudou de slot");
+        ring8_release(&r);
+    }
+    check_count(&r, 0, "release");
+}
+
+/* Muitas voltas com head/tail passando por 0xFFFFFFFF -> 0: a ordem e a
+ * ocupação não podem perceber a virada */
+static void test_virada(void) {
+    ring8_t r;
+    uint32_t prox_in = 0, prox_out = 0, v;
+
+    init_em(&r, 0xFFFFFFF0u);
+    for (int passo = 0; passo < 64; passo++) {
+        uint32_t n_in = 1 + passo % ring8_CAPACITY, n_out = 1 + (passo * 3) % ring8_CAPACITY;
+
+        for (uint32_t i = 0; i < n_in && ring8_push(&r, &prox_in); i++) prox_in++;
+        CHECK(ring8_count(&r) == prox_in - prox_out, "passo %d: count %u, esperado %u",
+              passo, ring8_count(&r), prox_in - prox_out);
+        CHECK(ring8_count(&r) <= ring8_CAPACITY, "passo %d: count além da capacidade", passo);
+        for (uint32_t i = 0; i < n_out && ring8_pop(&r, &v); i++) {
+            CHECK(v == prox_out, "passo %d: pop %u, esperado %u", passo, v, prox_out);
+            prox_out++;
+        }
+    }
+    CHECK(r.head < 0xFFFFFFF0u, "head não virou (0x%08X)", r.head);
+}
+
+int main(void) {
+    /* Do zero, perto da virada e com a virada no meio do buffer */
+    static const uint32_t bases[] = { 0, 0xFFFFFFF0u, 0xFFFFFFFCu };
+
+    for (unsigned i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+        test_cheio_vazio(bases[i]);
+        test_flush(bases[i]);
+        test_bulk(bases[i]);
+        test_reserve(bases[i]);
+    }
+    test_virada();
+
+    printf("ring_test: %s\n", falhas ? "FALHOU" : "ok");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+/*
+ * st7789_host.c - HAL do ST7789 para PC com modelo do painel em memória
+ *
+ * O fluxo DC/CS/SPI gerado por ST7789.c e gfx.c é decodificado como no
+ * controlador real: CASET/RASET definem a janela, RAMWR grava pixels RGB565
+ * (coluna primeiro, depois linha) e MADCTL define o mapeamento para a GRAM.
+ * Considera-se um painel IPS, em que INVON resulta nas cores corretas.
+ */
+
+#include "st7789_host.h"
+#include "ST7789.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* ================= Estado do painel ================= */
+
+static uint16_t gram[ST7789_HOST_GRAM_H][ST7789_HOST_GRAM_W];
+
+static int dc;            // 0 = comando, 1 = dado
+static int cs;            // 1 = selecionado
+static uint8_t cmd;       // Último comando recebido
+static uint8_t args[4];   // Parâmetros do comando atual
+static int nargs;
+
+static uint8_t madctl;
+static uint16_t xs, xe, ys, ye;   // Janela (CASET/RASET)
+static uint16_t cur_x, cur_y;     // Ponteiro de escrita do RAMWR
+static uint8_t pix_hi;
+static int pix_half;              // 1 = primeiro byte do pixel já recebido
+
+static st7789_host_stats_t stats;
+
+/* ================= Mapeamento MADCTL ================= */
+
+/* Converte coordenadas do controlador (coluna, linha) em posição na GRAM */
+static int map_to_gram(int c, int r, int *gx, int *gy) {
+    int x = c, y = r;
+
+    if (madctl & ST77XX_MADCTL_MV) { x = r; y = c; }
+    if (madctl & ST77XX_MADCTL_MX) x = ST7789_HOST_GRAM_W - 1 - x;
+    if (madctl & ST77XX_MADCTL_MY) y = ST7789_HOST_GRAM_H - 1 - y;
+
+    if (x < 0 || x >= ST7789_HOST_GRAM_W || y < 0 || y >= ST7789_HOST_GRAM_H) return 0;
+    *gx = x;
+    *gy = y;
+    return 1;
+}
+
+/* ================= Decodificador ================= */
+
+static void ramwr_pixel(uint16_t color) {
+    int gx, gy;
+
+    if (map_to_gram(cur_x, cur_y, &gx, &gy)) {
+        gram[gy][gx] = color;
+    }
+    stats.pixels++;
+
+    if (++cur_x > xe) {
+        cur_x = xs;
+        if (++cur_y > ye) cur_y = ys;
+    }
+}
+
+static void decode_command(uint8_t c) {
+    cmd = c;
+    nargs = 0;
+    pix_half = 0;
+    stats.commands++;
+
+    if (c == ST77XX_RAMWR) {
+        cur_x = xs;
+        cur_y = ys;
+    }
+}
+
+static void decode_data(uint8_t d) {
+    switch (cmd) {
+    case ST77XX_CASET:
+    case ST77XX_RASET:
+        if (nargs < 4) args[nargs++] = d;
+        if (nargs == 4) {
+            uint16_t start = (args[0] << 8) | args[1];
+            uint16_t end   = (args[2] << 8) | args[3];
+            if (cmd == ST77XX_CASET) { xs = start; xe = end; }
+            else                     { ys = start; ye = end; }
+        }
+        break;
+    case ST77XX_MADCTL:
+        madctl = d;
+        break;
+    case ST77XX_RAMWR:
+        if (!pix_half) {
+            pix_hi = d;
+            pix_half = 1;
+        } else {
+            ramwr_pixel((pix_hi << 8) | d);
+            pix_half = 0;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* ================= HAL (mesma interface de ST7789_hal.c) ================= */
+
+void st7789_dc_set(int val) {
+    dc = val;
+}
+
+void st7789_reset_set(int val) {
+    if (val == 0) {
+        madctl = 0;
+        xs = ys = 0;
+        xe = ST7789_HOST_GRAM_W - 1;
+        ye = ST7789_HOST_GRAM_H - 1;
+        cmd = ST77XX_NOP;
+    }
+}
+
+void st7789_set_backlight(int val) {
+    (void)val;
+}
+
+void st7789_spi_cs_set(int val) {
+    if (val && !cs) stats.cs_toggles++;
+    cs = val;
+}
+
+void st7789_spi_write_byte(uint8_t data) {
+    if (!cs) return;   // Sem CS o controlador ignora o barramento
+
+    stats.spi_bytes++;
+    if (dc) {
+        stats.data_bytes++;
+        decode_data(data);
+    } else {
+        stats.cmd_bytes++;
+        decode_command(data);
+    }
+}
+
+void st7789_delay_us(uint32_t us) {
+    (void)us;
+}
+
+/* ================= Consulta e snapshots ================= */
+
+void st7789_host_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+st7789_host_stats_t st7789_host_get_stats(void) {
+    return stats;
+}
+
+int st7789_host_width(void) {
+    return (madctl & ST77XX_MADCTL_MV) ? ST7789_HOST_GRAM_H : ST7789_HOST_GRAM_W;
+}
+
+int st7789_host_height(void) {
+    return (madctl & ST77XX_MADCTL_MV) ? ST7789_HOST_GRAM_W : ST7789_HOST_GRAM_H;
+}
+
+uint16_t st7789_host_get_pixel(int x, int y) {
+    int gx, gy;
+    if (!map_to_gram(x, y, &gx, &gy)) return 0;
+    return gram[gy][gx];
+}
+
+static void rgb565_to_rgb888(uint16_t c, uint8_t out[3]) {
+    uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+    if (madctl & 0x08) {   // Bit BGR: o painel troca R e B
+        uint8_t t = out[0]; out[0] = out[2]; out[2] = t;
+    }
+}
+
+int st7789_host_write_ppm(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return -1;
+
+    int w = st7789_host_width(), h = st7789_host_height();
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint8_t rgb[3];
+            rgb565_to_rgb888(st7789_host_get_pixel(x, y), rgb);
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    return fclose(f);
+}
+
+/* --- PNG sem dependências: deflate com blocos "stored" (sem compressão) --- */
+
+static uint32_t crc_table[256];
+
+static uint32_t png_crc(uint32_t crc, const uint8_t *p, size_t n) {
+    if (!crc_table[1]) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crc_table[i] = c;
+        }
+    }
+    for (size_t i = 0; i < n; i++) crc = crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static void put_be32(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static void png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len) {
+    uint8_t hdr[8];
+    put_be32(hdr, len);
+    memcpy(hdr + 4, type, 4);
+    fwrite(hdr, 1, 8, f);
+    if (len) fwrite(data, 1, len, f);
+
+    uint32_t crc = png_crc(0xFFFFFFFFu, hdr + 4, 4);
+    crc = png_crc(crc, data, len) ^ 0xFFFFFFFFu;
+    put_be32(hdr, crc);
+    fwrite(hdr, 1, 4, f);
+}
+
+int st7789_host_write_png(const char *path) {
+    static uint8_t raw[ST7789_HOST_GRAM_H * (1 + ST7789_HOST_GRAM_W * 3)];
+    static uint8_t idat[sizeof(raw) + sizeof(raw) / 65535 * 5 + 5 + 6];
+
+    int w = st7789_host_width(), h = st7789_host_height();
+    size_t n = 0;
+    for (int y = 0; y < h; y++) {
+        raw[n++] = 0;   // Filtro "None"
+        for (int x = 0; x < w; x++) {
+            rgb565_to_rgb888(st7789_host_get_pixel(x, y), &raw[n]);
+            n += 3;
+        }
+    }
+
+    // zlib: cabeçalho, blocos stored de até 65535 bytes e Adler-32
+    size_t m = 0;
+    idat[m++] = 0x78;
+    idat[m++] = 0x01;
+    for (size_t off = 0; off < n; ) {
+        size_t len = (n - off > 65535) ? 65535 : n - off;
+        idat[m++] = (off + len == n) ? 1 : 0;
+        idat[m++] = len & 0xFF;
+        idat[m++] = len >> 8;
+        idat[m++] = ~len & 0xFF;
+        idat[m++] = (~len >> 8) & 0xFF;
+        memcpy(&idat[m], &raw[off], len);
+        m += len;
+        off += len;
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < n; i++) {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    put_be32(&idat[m], (b << 16) | a);
+    m += 4;
+
+    FILE *f = fopen(path, "wb");
+    if (!f) return -1;
+
+    static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint8_t ihdr[13];
+    put_be32(ihdr, w);
+    put_be32(ihdr + 4, h);
+    ihdr[8] = 8;    // Bits por canal
+    ihdr[9] = 2;    // RGB
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+
+    fwrite(sig, 1, 8, f);
+    png_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    png_chunk(f, "IDAT", idat, m);
+    png_chunk(f, "IEND", NULL, 0);
+    return fclose(f);
+}
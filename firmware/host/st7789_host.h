@@ -0,0 +1,42 @@
+/*
+ * st7789_host.h - Backend do ST7789 para PC (fora da placa)
+ * Implementa a HAL do ST7789 decodificando o fluxo de comandos SPI em um
+ * modelo do painel em memória, com contadores de tráfego e snapshots PPM/PNG.
+ */
+
+#ifndef ST7789_HOST_H
+#define ST7789_HOST_H
+
+#include <stdint.h>
+
+#define ST7789_HOST_GRAM_W 240
+#define ST7789_HOST_GRAM_H 320
+
+/* Contadores de tráfego no barramento */
+typedef struct {
+    uint32_t spi_bytes;   // Total de bytes enviados (comando + dado)
+    uint32_t cmd_bytes;   // Bytes com DC = 0
+    uint32_t data_bytes;  // Bytes com DC = 1
+    uint32_t cs_toggles;  // Ativações de CS
+    uint32_t commands;    // Comandos decodificados
+    uint32_t pixels;      // Pixels gravados na GRAM (RAMWR)
+} st7789_host_stats_t;
+
+/* Zera os contadores (chamar antes de cada operação medida) */
+void st7789_host_reset_stats(void);
+
+/* Contadores acumulados desde o último reset */
+st7789_host_stats_t st7789_host_get_stats(void);
+
+/* Largura/altura da imagem na orientação atual (MADCTL) */
+int st7789_host_width(void);
+int st7789_host_height(void);
+
+/* Pixel RGB565 na orientação atual (coordenadas de tela, como no gfx) */
+uint16_t st7789_host_get_pixel(int x, int y);
+
+/* Snapshot da tela na orientação atual. Retorna 0 em caso de sucesso. */
+int st7789_host_write_ppm(const char *path);
+int st7789_host_write_png(const char *path);
+
+#endif // ST7789_HOST_H
@@ -0,0 +1,142 @@
+// stats_test.c - Testes de incs/stats/stream_stats (média, variância, EWMA)
+// contra a conta em double, incluindo um degrau depois de muitas amostras.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "stream_stats.h"
+
+static int falhas;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FALHA %s:%d: ", __FILE__, __LINE__);            \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        falhas++;                                               \
+    }                                                           \
+} while (0)
+
+/* Referência: soma e soma dos quadrados em long double, que para estes
+ * tamanhos não perde nada */
+typedef struct {
+    long double sum, sum2;
+    long n;
+} ref_t;
+
+static void ref_add(ref_t *r, int32_t x) {
+    r->sum += x;
+    r->sum2 += (long double)x * x;
+    r->n++;
+}
+
+static double ref_mean(const ref_t *r) {
+    return (double)(r->sum / r->n);
+}
+
+static double ref_var(const ref_t *r) {
+    return (double)((r->sum2 - r->sum * r->sum / r->n) / (r->n - 1));
+}
+
+static void check_against(const stream_stats_t *s, const ref_t *r, const char *nome) {
+    double m = ref_mean(r), v = ref_var(r);
+
+    CHECK(fabs(stream_stats_mean(s) - m) <= 0.5 + 1e-9,
+          "%s: media %ld, esperado %.3f", nome, (long)stream_stats_mean(s), m);
+    CHECK(fabs(stream_stats_variance(s) - v) <= 0.5 + v * 1e-6,
+          "%s: variancia %lu, esperado %.3f", nome, (unsigned long)stream_stats_variance(s), v);
+    CHECK(fabs(stream_stats_stddev(s) - sqrt(v)) <= 1.0,
+          "%s: desvio %lu, esperado %.3f", nome, (unsigned long)stream_stats_stddev(s), sqrt(v));
+}
+
+/* Degrau depois de muitas amostras: a média tem que andar até o meio */
+static void test_degrau(void) {
+    stream_stats_t s;
+    ref_t r = { 0 };
+
+    stream_stats_init(&s, 4);
+    for (int i = 0; i < 200000; i++) {
+        int32_t x = 2500 + (i & 1);
+        stream_stats_add(&s, x);
+        ref_add(&r, x);
+    }
+    for (int i = 0; i < 200000; i++) {
+        int32_t x = 2520 + (i & 1);
+        stream_stats_add(&s, x);
+        ref_add(&r, x);
+    }
+    check_against(&s, &r, "degrau");
+    CHECK(stream_stats_ewma(&s) == 2520 || stream_stats_ewma(&s) == 2521,
+          "degrau: ewma %ld", (long)stream_stats_ewma(&s));
+    CHECK(s.min == 2500 && s.max == 2521, "degrau: min %ld max %ld", (long)s.min, (long)s.max);
+}
+
+/* Uniforme 0..6: variância 4 (amostral ~4) */
+static void test_uniforme(void) {
+    stream_stats_t s;
+    ref_t r = { 0 };
+
+    stream_stats_init(&s, 4);
+    for (int i = 0; i < 70000; i++) {
+        stream_stats_add(&s, i % 7);
+        ref_add(&r, i % 7);
+    }
+    check_against(&s, &r, "uniforme");
+    CHECK(stream_stats_variance(&s) == 4, "uniforme: variancia %lu", (unsigned long)stream_stats_variance(&s));
+}
+
+/* Nível alto com espalhamento moderado (PPG de 18 bits, lux * 100) e valores
+ * negativos; a variância em si tem que caber nos 32 bits da API */
+static void test_faixa(void) {
+    static const int32_t niveis[2] = { 1 << 22, -(1 << 20) };
+
+    srand(1);
+    for (int k = 0; k < 2; k++) {
+        stream_stats_t s;
+        ref_t r = { 0 };
+
+        stream_stats_init(&s, 3);
+        for (int i = 0; i < 100000; i++) {
+            int32_t x = niveis[k] + rand() % 65536;
+            stream_stats_add(&s, x);
+            ref_add(&r, x);
+        }
+        check_against(&s, &r, k ? "negativo" : "nivel alto");
+    }
+}
+
+/* IR cru do MAX3010x (18 bits) com o dedo entrando e saindo: variância
+ * ~1e10, além dos 32 bits; tem que saturar, não dar a volta */
+static void test_satura(void) {
+    stream_stats_t s;
+
+    stream_stats_init(&s, 3);
+    for (int i = 0; i < 1000; i++) stream_stats_add(&s, (i & 1) ? 200000 : 0);
+    CHECK(stream_stats_variance(&s) == UINT32_MAX, "variancia %u, esperado UINT32_MAX",
+          stream_stats_variance(&s));
+    CHECK(stream_stats_stddev(&s) == 65535, "dp %u, esperado 65535", stream_stats_stddev(&s));
+    CHECK(stream_stats_mean(&s) == 100000, "media %d", stream_stats_mean(&s));
+}
+
+static void test_vazio(void) {
+    stream_stats_t s;
+
+    stream_stats_init(&s, 4);
+    CHECK(stream_stats_mean(&s) == 0 && stream_stats_variance(&s) == 0, "vazio");
+    stream_stats_add(&s, -7);
+    CHECK(stream_stats_mean(&s) == -7 && stream_stats_variance(&s) == 0, "uma amostra");
+    stream_stats_reset(&s);
+    CHECK(s.n == 0 && stream_stats_mean(&s) == 0 && s.ewma_shift == 4, "reset");
+}
+
+int main(void) {
+    test_vazio();
+    test_uniforme();
+    test_degrau();
+    test_faixa();
+    test_satura();
+
+    printf("stats_test: %s\n", falhas ? "FALHOU" : "ok");
+    return falhas ? 1 : 0;
+}
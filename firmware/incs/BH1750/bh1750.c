@@ -10,6 +10,54 @@
 
 #define BH1750_POWER_ON   0x01
 #define BH1750_RESET      0x07
+#define BH1750_MT_HIGH    0x40    // 01000 + MTreg[7:5]
+#define BH1750_MT_LOW     0x60    // 011 + MTreg[4:0]
+
+/*
+ * Degraus do auto-range, do menos para o mais sensível. Cada um vale entre
+ * down_x100 (abaixo: próximo degrau) e up_x100 (acima: degrau anterior);
+ * as faixas se sobrepõem para não oscilar.
+ */
+static const struct {
+    bh1750_mode_t mode;
+    uint8_t  mtreg;
+    uint32_t down_x100;
+    uint32_t up_x100;
+} ranges[] = {
+    { BH1750_CONT_H_RES,  31,  4000000, 0xFFFFFFFF }, // até ~121 klx
+    { BH1750_CONT_L_RES,  69,    30000,    5000000 }, // 24 ms, passo 4 lx
+    { BH1750_CONT_H_RES,  69,     1500,      50000 }, // 1 lx
+    { BH1750_CONT_H2_RES, 138,     100,       2500 }, // 0.25 lx
+    { BH1750_CONT_H2_RES, 254,       0,        200 }, // 0.11 lx
+};
+#define RANGES          (sizeof(ranges) / sizeof(ranges[0]))
+#define RANGE_DEFAULT   2
+
+/* Tempo máximo de conversão (datasheet): 180 ms em alta resolução, 24 ms em
+ * baixa, com MTreg = 69; escala linearmente com o MTreg */
+uint16_t bh1750_conversion_ms(const bh1750_ctx_t *ctx) {
+    bh1750_mode_t mode = ctx->mode;
+    uint32_t base = (mode == BH1750_CONT_L_RES || mode == BH1750_ONE_L_RES) ? 24 : 180;
+    return (uint16_t)((base * ctx->mtreg + BH1750_MTREG_DEFAULT - 1) / BH1750_MTREG_DEFAULT);
+}
+
+static bool is_h2(bh1750_mode_t mode) {
+    return mode == BH1750_CONT_H2_RES || mode == BH1750_ONE_H2_RES;
+}
+
+static bool is_one_time(bh1750_mode_t mode) {
+    return ((uint8_t)mode & 0xF0) == 0x20;
+}
+
+/* Comando da próxima conversão: em one_shot, o "one time" equivalente */
+static bh1750_mode_t start_mode(const bh1750_ctx_t *ctx) {
+    if (!ctx->one_shot || is_one_time(ctx->mode)) return ctx->mode;
+    return (bh1750_mode_t)(((uint8_t)ctx->mode & 0x0F) | 0x20);
+}
+
+static bool send_cmd(bh1750_ctx_t *ctx, uint8_t cmd) {
+    return bb_i2c_write(ctx->i2c_addr, &cmd, 1);
+}
 
 bool bh1750_init(bh1750_ctx_t *ctx, uint8_t addr, bh1750_mode_t mode) {
     if (!ctx) {
@@ -19,35 +67,90 @@ bool bh1750_init(bh1750_ctx_t *ctx, uint8_t addr, bh1750_mode_t mode) {
     ctx->i2c_addr = addr;
     ctx->mode     = mode;
     ctx->lux_x100 = 0;
+    ctx->state    = SENSOR_IDLE;
+    ctx->running  = false;
+    ctx->one_shot = false;
+    ctx->mtreg    = BH1750_MTREG_DEFAULT;
+    ctx->raw      = 0;
+    ctx->range    = RANGE_DEFAULT;
+
+    for (uint8_t i = 0; i < RANGES; i++)
+        if (ranges[i].mode == mode && ranges[i].mtreg == BH1750_MTREG_DEFAULT) ctx->range = i;
 
     bb_i2c_init();
-    delay_ms(10);
 
-    /* Power ON */
-    uint8_t cmd = BH1750_POWER_ON;
-    if (!bb_i2c_write(ctx->i2c_addr, &cmd, 1)) {
+    /* Power ON e Reset: o chip aceita os comandos em sequência, sem espera */
+    if (!send_cmd(ctx, BH1750_POWER_ON)) {
         return false;
     }
 
-    delay_ms(10);
+    if (!send_cmd(ctx, BH1750_RESET)) {
+        return false;
+    }
+
+    /* Modo contínuo já começa a converter aqui */
+    return bh1750_start(ctx);
+}
 
-    /* Reset */
-    cmd = BH1750_RESET;
-    if (!bb_i2c_write(ctx->i2c_addr, &cmd, 1)) {
+bool bh1750_start(bh1750_ctx_t *ctx) {
+    bh1750_mode_t mode;
+
+    if (!ctx) {
         return false;
     }
 
-    delay_ms(10);
+    if (ctx->state == SENSOR_BUSY) {
+        return true;
+    }
 
-    /* Configura modo */
-    cmd = (uint8_t)ctx->mode;
-    if (!bb_i2c_write(ctx->i2c_addr, &cmd, 1)) {
+    if (ctx->state == SENSOR_ERROR) {
+        ctx->running = false;   // Reenvia o modo
+    }
+
+    /*
+     * Modo contínuo: o comando só é enviado uma vez, depois o chip renova o
+     * resultado sozinho a cada conversão; basta esperar uma conversão para
+     * ter um valor novo. Modo "one time": cada medição precisa do comando
+     * (o chip volta a power down ao terminar).
+     */
+    mode = start_mode(ctx);
+    if (!ctx->running || is_one_time(mode)) {
+        if (!send_cmd(ctx, (uint8_t)mode)) {
+            ctx->state = SENSOR_ERROR;
+            return false;
+        }
+        ctx->running = !is_one_time(mode);
+    }
+
+    ctx->ready_ms = time_get_ms() + bh1750_conversion_ms(ctx);
+    ctx->state = SENSOR_BUSY;
+    return true;
+}
+
+/* O BH1750 não tem bit de status: pronto é só o prazo de conversão */
+sensor_status_t bh1750_poll(bh1750_ctx_t *ctx) {
+    if (!ctx) {
+        return SENSOR_ERROR;
+    }
+
+    if (ctx->state == SENSOR_BUSY && sensor_time_reached(time_get_ms(), ctx->ready_ms)) {
+        ctx->state = SENSOR_READY;
+    }
+
+    return ctx->state;
+}
+
+bool bh1750_fetch(bh1750_ctx_t *ctx) {
+    if (!ctx || ctx->state != SENSOR_READY) {
         return false;
     }
 
-    /* Tempo típico de conversão */
-    delay_ms(180);
+    if (!bh1750_read(ctx)) {
+        ctx->state = SENSOR_ERROR;
+        return false;
+    }
 
+    ctx->state = SENSOR_IDLE;
     return true;
 }
 
@@ -69,12 +172,80 @@ bool bh1750_read(bh1750_ctx_t *ctx) {
 
     /*
      * Datasheet:
-     * lux = raw / 1.2
+     * lux = raw / 1.2 * (69 / MTreg), e metade disso no modo H2
      * Para evitar float:
-     * lux_x100 = raw * 100 / 1.2 = raw * 1000 / 12
+     * lux_x100 = raw * 1000 * 69 / (12 * MTreg [* 2])
+     * 1000 * 69 / 12 = 5750 exato, e raw * 5750 cabe em 32 bits: sem a
+     * divisão de 64 bits (__udivdi3) da libgcc.
      */
 
-    ctx->lux_x100 = ((uint32_t)raw * 1000UL) / 12UL;
+    uint32_t den = (uint32_t)ctx->mtreg * (is_h2(ctx->mode) ? 2 : 1);
+    ctx->raw = raw;
+    ctx->lux_x100 = ((uint32_t)raw * (1000u * BH1750_MTREG_DEFAULT / 12u)) / den;
 
     return true;
 }
+
+/* ================= Auto-range ================= */
+
+bool bh1750_set_mtreg(bh1750_ctx_t *ctx, uint8_t mtreg) {
+    if (!ctx || mtreg < BH1750_MTREG_MIN || mtreg > BH1750_MTREG_MAX) {
+        return false;
+    }
+
+    if (!send_cmd(ctx, BH1750_MT_HIGH | (mtreg >> 5)) ||
+        !send_cmd(ctx, BH1750_MT_LOW | (mtreg & 0x1F))) {
+        ctx->state = SENSOR_ERROR;
+        return false;
+    }
+
+    ctx->mtreg = mtreg;
+    ctx->running = false;            // start() reenvia o modo
+    if (ctx->state == SENSOR_BUSY) ctx->state = SENSOR_IDLE;
+    return true;
+}
+
+bool bh1750_set_mode(bh1750_ctx_t *ctx, bh1750_mode_t mode) {
+    if (!ctx) {
+        return false;
+    }
+
+    ctx->mode = mode;
+    ctx->running = false;
+    if (ctx->state == SENSOR_BUSY) ctx->state = SENSOR_IDLE;
+    return true;
+}
+
+bool bh1750_set_one_shot(bh1750_ctx_t *ctx, bool one_shot) {
+    if (!ctx) {
+        return false;
+    }
+
+    /* Abandona a conversão contínua em curso; o próximo start() manda o
+     * comando "one time" (o chip volta a power down ao terminar) */
+    ctx->one_shot = one_shot;
+    ctx->running = false;
+    if (ctx->state == SENSOR_BUSY) ctx->state = SENSOR_IDLE;
+    return true;
+}
+
+bool bh1750_autorange(bh1750_ctx_t *ctx) {
+    if (!ctx) {
+        return false;
+    }
+
+    uint8_t r = ctx->range;
+
+    /* Contagem no topo da escala: lux_x100 não é confiável, sobe direto */
+    if ((ctx->raw >= 0xFF00 || ctx->lux_x100 > ranges[r].up_x100) && r > 0) {
+        r--;
+    } else if (ctx->lux_x100 < ranges[r].down_x100 && r + 1u < RANGES) {
+        r++;
+    } else {
+        return false;
+    }
+
+    ctx->range = r;
+    if (!bh1750_set_mtreg(ctx, ranges[r].mtreg)) return false;
+    return bh1750_set_mode(ctx, ranges[r].mode);
+}
@@ -7,6 +7,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "sensor.h"
+
 /* Endereços I2C possíveis */
 #define BH1750_ADDR_LOW   0x23
 #define BH1750_ADDR_HIGH  0x5C
@@ -26,10 +28,47 @@ typedef struct {
     uint8_t i2c_addr;
     bh1750_mode_t mode;
     uint32_t lux_x100;   // Lux * 100 (sem float)
+
+    sensor_status_t state;
+    uint32_t ready_ms;   // Instante (time_get_ms) em que a conversão termina
+    bool running;        // Modo contínuo já disparado
+    bool one_shot;       // Cada start() dispara uma conversão "one time"
+
+    uint8_t  mtreg;      // Measurement Time register (31..254, padrão 69)
+    uint16_t raw;        // Última contagem lida
+    uint8_t  range;      // Degrau atual do auto-range
 } bh1750_ctx_t;
 
+#define BH1750_MTREG_DEFAULT 69
+#define BH1750_MTREG_MIN     31
+#define BH1750_MTREG_MAX     254
+
 /* API */
 bool bh1750_init(bh1750_ctx_t *ctx, uint8_t addr, bh1750_mode_t mode);
 bool bh1750_read(bh1750_ctx_t *ctx);
 
+/* Sensibilidade: MTreg e modo; lux_x100 continua em lux reais */
+bool bh1750_set_mtreg(bh1750_ctx_t *ctx, uint8_t mtreg);
+bool bh1750_set_mode(bh1750_ctx_t *ctx, bh1750_mode_t mode);
+
+/*
+ * Conversão só sob comando: start() passa a enviar o modo "one time"
+ * equivalente ao atual (a tabela de auto-range continua valendo), para
+ * alinhar a conversão com um disparo externo.
+ */
+bool bh1750_set_one_shot(bh1750_ctx_t *ctx, bool one_shot);
+
+/*
+ * Auto-range pela última leitura, com histerese: MTreg baixo no sol forte,
+ * modo L (24 ms) na luz comum, H e H2 com MTreg alto no escuro. Retorna
+ * true se mudou (a próxima conversão já usa o degrau novo).
+ */
+bool bh1750_autorange(bh1750_ctx_t *ctx);
+
+/* Medição não bloqueante */
+uint16_t bh1750_conversion_ms(const bh1750_ctx_t *ctx);
+bool bh1750_start(bh1750_ctx_t *ctx);
+sensor_status_t bh1750_poll(bh1750_ctx_t *ctx);
+bool bh1750_fetch(bh1750_ctx_t *ctx);
+
 #endif // BH1750_H
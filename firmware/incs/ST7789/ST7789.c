@@ -3,8 +3,8 @@
  */
 
 #include "ST7789.h"
-#include <time.h>   // Para busy_wait_ms()
-#include <generated/csr.h>
+#include "fastmem.h"
+#include "prof.h"
 
 
 // --- Constantes internas ---
@@ -42,36 +42,12 @@ static const uint8_t generic_st7789[] = {
 };
 
 // --- Funções de Abstração de Hardware (HAL) ---
-
-
-void st7789_dc_set(int val) {
-    lcd_dc_out_write(val);
-}
-
-static void lcd_reset_set(int val) {
-    lcd_reset_out_write(val);
-}
-
-void st7789_set_backlight(int val) {
-    lcd_blk_out_write(val);
-}
-
-void st7789_spi_cs_set(int val) {
-    // Assumindo CS ativo em 1 (com base em CSR_SPI_CS_SEL_OFFSET = 0)
-    spi_cs_write(val); 
-}
-
-void st7789_spi_write_byte(uint8_t data) {
-    spi_mosi_write(data);
-    // Inicia a transmissão de 8 bits
-    spi_control_write((8 << CSR_SPI_CONTROL_LENGTH_OFFSET) | (1 << CSR_SPI_CONTROL_START_OFFSET));
-    // Espera a transmissão terminar (poll no bit 'done')
-    while (!(spi_status_read() & (1 << CSR_SPI_STATUS_DONE_OFFSET)));
-}
+// Implementadas em ST7789_hal.c (CSRs do LiteX) ou em host/st7789_host.c
+// (modelo do painel em memória, para testes fora da placa).
 
 void st7789_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
-    if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) {
-        return; // Fora da tela
+    if ((x >= _width) || (y >= _height)) {
+        return; // Fora da tela (sem sinal: negativos chegam como valores altos)
     }
     
     st7789_set_addr_window(x, y, 1, 1);
@@ -113,7 +89,7 @@ static void st7789_run_command_list(const uint8_t *addr) {
         if (ms) {
             ms = *addr++;
             if (ms == 255) ms = 500;
-            busy_wait_us(ms * 1000);
+            st7789_delay_us(ms * 1000);
         }
     }
 }
@@ -134,7 +110,7 @@ void st7789_write_data(uint8_t data) {
     st7789_spi_cs_set(0);
 }
 
-void st7789_write_data_buffer(const uint8_t* data, int len) {
+FAST_CODE void st7789_write_data_buffer(const uint8_t* data, int len) {
     st7789_dc_set(1); // DC alto para dado
     st7789_spi_cs_set(1);
     for (int i = 0; i < len; i++) {
@@ -162,10 +138,10 @@ void st7789_init(uint16_t width, uint16_t height) {
     }
 
     // Reset por hardware
-    lcd_reset_set(0);
-    busy_wait_us(50 * 1000);
-    lcd_reset_set(1);
-    busy_wait_us(50 * 1000);
+    st7789_reset_set(0);
+    st7789_delay_us(50 * 1000);
+    st7789_reset_set(1);
+    st7789_delay_us(50 * 1000);
 
     // Executa a lista de comandos de inicialização
     st7789_run_command_list(generic_st7789);
@@ -234,7 +210,9 @@ void st7789_set_addr_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
     st7789_write_command(ST77XX_RAMWR);
 }
 
-void st7789_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+FAST_CODE void st7789_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    PROF_BEGIN("st7789_fill_rect");
+
     // 1. Define a janela de desenho
     st7789_set_addr_window(x, y, w, h);
 
@@ -258,4 +236,6 @@ void st7789_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t c
 
     // 6. Desseleciona o chip
     st7789_spi_cs_set(0);
+
+    PROF_END();
 }
\ No newline at end of file
@@ -114,6 +114,7 @@ void st7789_set_backlight(int val);
 
 
 // --- Funções de Baixo Nível (usadas por st7789_fill_rect para performance) ---
+// HAL: implementada em ST7789_hal.c (placa) ou host/st7789_host.c (PC).
 
 /**
  * @brief Define o pino Data/Command (DC).
@@ -135,6 +136,18 @@ void st7789_spi_cs_set(int val);
  */
 void st7789_spi_write_byte(uint8_t data);
 
+/**
+ * @brief Define o pino RESET do display.
+ * @param val 0 para resetar, 1 para operação normal.
+ */
+void st7789_reset_set(int val);
+
+/**
+ * @brief Espera ocupada (usada nos delays da sequência de inicialização).
+ * @param us Microssegundos.
+ */
+void st7789_delay_us(uint32_t us);
+
 extern int16_t _width, _height; // Largura e altura atuais (após rotação)
 
 #endif // ST7789_H
\ No newline at end of file
@@ -0,0 +1,38 @@
+/*
+ * ST7789_hal.c - Camada de abstração de hardware do ST7789 no LiteX
+ * Pinos DC/RESET/BLK via GPIOOut e SPI via SPIMaster (CSRs gerados).
+ */
+
+#include "ST7789.h"
+#include "fastmem.h"
+#include <generated/csr.h>
+#include <system.h> // busy_wait_us
+
+FAST_CODE void st7789_dc_set(int val) {
+    lcd_dc_out_write(val);
+}
+
+void st7789_reset_set(int val) {
+    lcd_reset_out_write(val);
+}
+
+void st7789_set_backlight(int val) {
+    lcd_blk_out_write(val);
+}
+
+FAST_CODE void st7789_spi_cs_set(int val) {
+    // Assumindo CS ativo em 1 (com base em CSR_SPI_CS_SEL_OFFSET = 0)
+    spi_cs_write(val); 
+}
+
+FAST_CODE void st7789_spi_write_byte(uint8_t data) {
+    spi_mosi_write(data);
+    // Inicia a transmissão de 8 bits
+    spi_control_write((8 << CSR_SPI_CONTROL_LENGTH_OFFSET) | (1 << CSR_SPI_CONTROL_START_OFFSET));
+    // Espera a transmissão terminar (poll no bit 'done')
+    while (!(spi_status_read() & (1 << CSR_SPI_STATUS_DONE_OFFSET)));
+}
+
+void st7789_delay_us(uint32_t us) {
+    busy_wait_us(us);
+}
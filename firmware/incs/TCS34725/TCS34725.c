@@ -1,22 +1,56 @@
 #include "TCS34725.h"
 #include "i2c_driver.h"
 #include "time_driver.h"
+#include "prof.h"
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
 
 /* Registradores */
 #define COMMAND_BIT     0x80
+#define COMMAND_AUTOINC 0x20
 #define REG_ENABLE      0x00
 #define REG_ATIME       0x01
+#define REG_AILTL       0x04    // AILTL, AILTH, AIHTL, AIHTH
+#define REG_PERS        0x0C
 #define REG_CONTROL     0x0F
 #define REG_ID          0x12
+#define REG_STATUS      0x13
 #define REG_CDATAL      0x14
 
 /* ENABLE bits */
 #define ENABLE_PON      0x01
 #define ENABLE_AEN      0x02
+#define ENABLE_AIEN     0x10
+
+/* Comando especial: limpa a interrupção do canal CLEAR */
+#define CMD_CLEAR_INT   (COMMAND_BIT | 0x60 | 0x06)
+
+/* STATUS bits */
+#define STATUS_AVALID   0x01
+#define STATUS_AINT     0x10
+
+#define PON_DELAY_MS    3       // 2.4 ms entre PON e AEN (datasheet)
+
+/* Auto-range (contagens do canal CLEAR) */
+#define AR_GOOD_COUNTS  1000    // Abaixo disso a resolução é ruim: mais sensível
+#define AR_HIGH_PCT     85      // Acima disso do fundo de escala: menos sensível
+#define AR_NEXT_PCT     60      // Só sobe a sensibilidade se a previsão ficar abaixo
+
+static const struct {
+    tcs34725_gain_t gain;
+    tcs34725_integration_t atime;
+} ranges[TCS34725_RANGES] = {
+    { TCS34725_GAIN_1X,  TCS34725_INTEGRATION_2_4MS },   //     1
+    { TCS34725_GAIN_1X,  TCS34725_INTEGRATION_24MS  },   //    10
+    { TCS34725_GAIN_4X,  TCS34725_INTEGRATION_24MS  },   //    40
+    { TCS34725_GAIN_16X, TCS34725_INTEGRATION_24MS  },   //   160
+    { TCS34725_GAIN_60X, TCS34725_INTEGRATION_24MS  },   //   600
+    { TCS34725_GAIN_60X, TCS34725_INTEGRATION_50MS  },   //  1260
+    { TCS34725_GAIN_60X, TCS34725_INTEGRATION_101MS },   //  2520
+    { TCS34725_GAIN_60X, TCS34725_INTEGRATION_154MS },   //  3840
+    { TCS34725_GAIN_60X, TCS34725_INTEGRATION_700MS },   // 15360
+};
 
 /* ================= I2C helpers ================= */
 
@@ -42,38 +76,153 @@ static bool read16(uint8_t addr, uint8_t reg, uint16_t *val) {
     return true;
 }
 
+static bool read_block(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len) {
+    uint8_t cmd = COMMAND_BIT | COMMAND_AUTOINC | reg;
+
+    if (!bb_i2c_write(addr, &cmd, 1)) return false;
+    return bb_i2c_read(addr, buf, len);
+}
+
 /* ================= API ================= */
 
-bool tcs34725_init(tcs34725_ctx_t *ctx, tcs34725_gain_t gain, tcs34725_integration_t integration) {
+static uint8_t enable_bits(const tcs34725_ctx_t *ctx, bool aen) {
+    return ENABLE_PON | (aen ? ENABLE_AEN : 0) | (ctx->aien ? ENABLE_AIEN : 0);
+}
 
-    uint16_t integration_ms = (256 - integration) * 2.4;
+uint8_t tcs34725_gain_factor(tcs34725_gain_t gain) {
+    switch (gain) {
+    case TCS34725_GAIN_1X:  return 1;
+    case TCS34725_GAIN_4X:  return 4;
+    case TCS34725_GAIN_16X: return 16;
+    default:                return 60;
+    }
+}
+
+static uint32_t sensitivity(tcs34725_gain_t gain, tcs34725_integration_t atime) {
+    return (uint32_t)tcs34725_gain_factor(gain) * (256 - (uint16_t)atime);
+}
+
+/* Fundo de escala do CLEAR: 1024 contagens por ciclo, até 65535 */
+static uint32_t full_scale(tcs34725_integration_t atime) {
+    uint32_t fs = 1024UL * (256 - (uint16_t)atime);
+    return fs > 65535 ? 65535 : fs;
+}
 
-    delay_ms(integration_ms + 10);
+uint16_t tcs34725_integration_ms(tcs34725_integration_t integration) {
+    return (uint16_t)(((256 - (uint16_t)integration) * 12) / 5);
+}
+
+bool tcs34725_init(tcs34725_ctx_t *ctx, tcs34725_gain_t gain, tcs34725_integration_t integration) {
 
     if (!ctx) return false;
 
     ctx->i2c_addr = TCS34725_I2C_ADDR;
     ctx->gain = gain;
     ctx->integration = integration;
+    ctx->state = SENSOR_IDLE;
+    ctx->enabled = false;
+    ctx->range = TCS34725_RANGE_DEFAULT;
+
+    /* Degrau do auto-range que coincide com a configuração pedida, se houver */
+    for (uint8_t i = 0; i < TCS34725_RANGES; i++)
+        if (ranges[i].gain == gain && ranges[i].atime == integration) ctx->range = i;
 
     bb_i2c_init();
-    delay_ms(10);
 
     uint8_t id;
-    if (!read8(ctx->i2c_addr, REG_ID, &id)) {
-        printf("Erro leitura ID TCS\n");
-        return false;
+    if (!read8(ctx->i2c_addr, REG_ID, &id)) return false;   // O registro avisa "Erro TCS34725"
+
+    /* Configura ainda em PON; AEN só em start(), passados os 2.4 ms */
+    if (!write8(ctx->i2c_addr, REG_ATIME, integration) ||
+        !write8(ctx->i2c_addr, REG_CONTROL, gain) ||
+        !write8(ctx->i2c_addr, REG_ENABLE, ENABLE_PON)) return false;
+
+    ctx->reconfig = false;
+    ctx->aien = false;
+    ctx->status = 0;
+    ctx->ready_ms = time_get_ms() + PON_DELAY_MS;
+    return true;
+}
+
+/*
+ * AEN desligado e ATIME/CONTROL do ctx no chip. Se alguma escrita falhar o
+ * chip fica com uma mistura do degrau velho e do novo: reconfig segura o
+ * AEN até start() conseguir regravar tudo, senão a leitura seria
+ * normalizada com o ganho errado.
+ */
+static bool write_config(tcs34725_ctx_t *ctx) {
+    ctx->enabled = false;
+    ctx->reconfig = !write8(ctx->i2c_addr, REG_ENABLE, enable_bits(ctx, false)) ||
+                    !write8(ctx->i2c_addr, REG_ATIME, ctx->integration) ||
+                    !write8(ctx->i2c_addr, REG_CONTROL, ctx->gain);
+    return !ctx->reconfig;
+}
+
+bool tcs34725_start(tcs34725_ctx_t *ctx) {
+    uint32_t now = time_get_ms();
+
+    if (!ctx) return false;
+    if (ctx->state == SENSOR_BUSY) return true;
+
+    /*
+     * Com AEN ligado o chip integra continuamente e AVALID marca o primeiro
+     * ciclo completo; a partir daí cada start() só espera uma integração
+     * para ter um valor novo.
+     */
+    if (!ctx->enabled) {
+        if (!sensor_time_reached(now, ctx->ready_ms)) return false;   // Ainda em power-on
+        if ((ctx->reconfig && !write_config(ctx)) ||
+            !write8(ctx->i2c_addr, REG_ENABLE, enable_bits(ctx, true))) {
+            ctx->state = SENSOR_ERROR;
+            return false;
+        }
+        ctx->enabled = true;
+    }
+
+    ctx->ready_ms = now + tcs34725_integration_ms(ctx->integration) + 1;
+    ctx->state = SENSOR_BUSY;
+    return true;
+}
+
+sensor_status_t tcs34725_poll(tcs34725_ctx_t *ctx) {
+    uint8_t status;
+
+    if (!ctx) return SENSOR_ERROR;
+    if (ctx->state != SENSOR_BUSY) return ctx->state;
+    if (!sensor_time_reached(time_get_ms(), ctx->ready_ms)) return SENSOR_BUSY;
+
+    /* Uma leitura de STATUS por chamada, sem laço */
+    if (!read8(ctx->i2c_addr, REG_STATUS, &status)) {
+        ctx->state = SENSOR_ERROR;
+        ctx->enabled = false;
+    } else if ((ctx->status = status) & STATUS_AVALID) {
+        ctx->state = SENSOR_READY;
     }
 
-    write8(ctx->i2c_addr, REG_ENABLE, ENABLE_PON);
-    delay_ms(10);
+    return ctx->state;
+}
 
-    write8(ctx->i2c_addr, REG_ENABLE, ENABLE_PON | ENABLE_AEN);
+bool tcs34725_fetch(tcs34725_ctx_t *ctx, tcs34725_raw_t *raw) {
+    uint8_t buf[8];   // CDATAL..BDATAH em um burst
+    bool ok;
 
-    write8(ctx->i2c_addr, REG_ATIME, integration);
-    write8(ctx->i2c_addr, REG_CONTROL, gain);
+    if (!ctx || !raw || ctx->state != SENSOR_READY) return false;
 
-    delay_ms(100);
+    PROF_BEGIN("tcs34725_fetch");
+    ok = read_block(ctx->i2c_addr, REG_CDATAL, buf, sizeof(buf));
+    PROF_END();
+    if (!ok) {
+        ctx->state = SENSOR_ERROR;
+        ctx->enabled = false;
+        return false;
+    }
+
+    raw->c = (uint16_t)buf[1] << 8 | buf[0];
+    raw->r = (uint16_t)buf[3] << 8 | buf[2];
+    raw->g = (uint16_t)buf[5] << 8 | buf[4];
+    raw->b = (uint16_t)buf[7] << 8 | buf[6];
+
+    ctx->state = SENSOR_IDLE;
     return true;
 }
 
@@ -93,3 +242,100 @@ bool tcs34725_read_raw(tcs34725_ctx_t *ctx,
 
     return true;
 }
+
+/* ================= Auto-range ================= */
+
+bool tcs34725_set_range(tcs34725_ctx_t *ctx, uint8_t range) {
+    if (!ctx || range >= TCS34725_RANGES) return false;
+
+    ctx->range = range;
+    ctx->gain = ranges[range].gain;
+    ctx->integration = ranges[range].atime;
+
+    /* AEN desligado: a integração recomeça com os valores novos no start(),
+     * que também repete a configuração se ela falhou aqui */
+    if (ctx->state == SENSOR_BUSY) ctx->state = SENSOR_IDLE;
+    return write_config(ctx);
+}
+
+bool tcs34725_autorange(tcs34725_ctx_t *ctx, const tcs34725_raw_t *raw) {
+    if (!ctx || !raw) return false;
+
+    uint8_t r = ctx->range;
+    uint32_t c = raw->c;
+
+    /* Decide com a configuração real (init pode estar fora da tabela) */
+    if (c >= full_scale(ctx->integration) * AR_HIGH_PCT / 100) {
+        /* Perto da saturação: menos sensível */
+        if (r == 0) return false;
+        r--;
+    } else if (c < AR_GOOD_COUNTS && r + 1 < TCS34725_RANGES) {
+        /* Resolução ruim: mais sensível, se a leitura prevista couber */
+        uint32_t next = c * sensitivity(ranges[r + 1].gain, ranges[r + 1].atime)
+                          / sensitivity(ctx->gain, ctx->integration);
+        if (next >= full_scale(ranges[r + 1].atime) * AR_NEXT_PCT / 100) return false;
+        r++;
+    } else {
+        return false;
+    }
+
+    return tcs34725_set_range(ctx, r);
+}
+
+void tcs34725_normalize(const tcs34725_ctx_t *ctx, const tcs34725_raw_t *raw, uint32_t out[4]) {
+    uint32_t sens = sensitivity(ctx->gain, ctx->integration);
+
+    out[0] = ((uint32_t)raw->c * 1024) / sens;
+    out[1] = ((uint32_t)raw->r * 1024) / sens;
+    out[2] = ((uint32_t)raw->g * 1024) / sens;
+    out[3] = ((uint32_t)raw->b * 1024) / sens;
+}
+
+/* ================= Interrupção por limiar ================= */
+
+bool tcs34725_set_thresholds(tcs34725_ctx_t *ctx, uint16_t low, uint16_t high) {
+    uint8_t buf[5] = {
+        COMMAND_BIT | COMMAND_AUTOINC | REG_AILTL,
+        low & 0xFF, low >> 8, high & 0xFF, high >> 8
+    };
+
+    if (!ctx) return false;
+    return bb_i2c_write(ctx->i2c_addr, buf, sizeof(buf));
+}
+
+bool tcs34725_set_persistence(tcs34725_ctx_t *ctx, tcs34725_pers_t pers) {
+    if (!ctx) return false;
+    return write8(ctx->i2c_addr, REG_PERS, (uint8_t)pers & 0x0F);
+}
+
+bool tcs34725_int_enable(tcs34725_ctx_t *ctx, bool enable) {
+    if (!ctx) return false;
+
+    ctx->aien = enable;
+    if (!write8(ctx->i2c_addr, REG_ENABLE, enable_bits(ctx, ctx->enabled))) return false;
+    return tcs34725_int_clear(ctx);
+}
+
+bool tcs34725_int_clear(tcs34725_ctx_t *ctx) {
+    uint8_t cmd = CMD_CLEAR_INT;
+
+    if (!ctx) return false;
+    ctx->status &= ~STATUS_AINT;
+    return bb_i2c_write(ctx->i2c_addr, &cmd, 1);
+}
+
+bool tcs34725_int_pending(const tcs34725_ctx_t *ctx) {
+    return ctx && (ctx->status & STATUS_AINT);
+}
+
+bool tcs34725_track(tcs34725_ctx_t *ctx, uint16_t clear, uint8_t pct) {
+    uint32_t delta = ((uint32_t)clear * pct) / 100;
+    uint32_t high;
+
+    if (delta == 0) delta = 1;
+    high = (uint32_t)clear + delta;
+    if (high > 0xFFFF) high = 0xFFFF;
+
+    if (!tcs34725_set_thresholds(ctx, clear > delta ? clear - delta : 0, (uint16_t)high)) return false;
+    return tcs34725_int_clear(ctx);
+}
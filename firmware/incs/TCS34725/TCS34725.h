@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "sensor.h"
+
 /* Endereço I2C */
 #define TCS34725_I2C_ADDR 0x29
 
@@ -30,17 +32,84 @@ typedef struct {
     uint8_t i2c_addr;
     tcs34725_gain_t gain;
     tcs34725_integration_t integration;
+
+    sensor_status_t state;
+    uint32_t ready_ms;    // Fim do power-on / da integração (time_get_ms)
+    bool enabled;         // AEN ligado (integração contínua)
+    uint8_t range;        // Degrau atual do auto-range (ver tcs34725_set_range)
+    bool reconfig;        // ATIME/CONTROL do chip podem não ser os daqui: start() regrava
+    bool aien;            // Interrupção por limiar do CLEAR habilitada
+    uint8_t status;       // Último STATUS lido em poll()
 } tcs34725_ctx_t;
 
+/* PERS: ciclos seguidos fora da faixa antes de gerar a interrupção */
+typedef enum {
+    TCS34725_PERS_EVERY = 0x0,  // Todo ciclo (ignora os limiares)
+    TCS34725_PERS_1     = 0x1,
+    TCS34725_PERS_2     = 0x2,
+    TCS34725_PERS_3     = 0x3,
+    TCS34725_PERS_5     = 0x4,
+    TCS34725_PERS_10    = 0x5,
+    TCS34725_PERS_20    = 0x8,
+    TCS34725_PERS_60    = 0xF
+} tcs34725_pers_t;
+
+/* Uma leitura RGBC crua */
+typedef struct {
+    uint16_t c, r, g, b;
+} tcs34725_raw_t;
+
 /* API */
 bool tcs34725_init(tcs34725_ctx_t *ctx,
                    tcs34725_gain_t gain,
                    tcs34725_integration_t integration);
 
+/* Tempo de integração em ms: (256 - ATIME) * 2.4, em inteiros */
+uint16_t tcs34725_integration_ms(tcs34725_integration_t integration);
+
+/* Multiplicador do ganho (1, 4, 16, 60) */
+uint8_t tcs34725_gain_factor(tcs34725_gain_t gain);
+
+/*
+ * Auto-range: degraus de ganho/ATIME em ordem crescente de sensibilidade,
+ * preferindo ganho a integração longa. tcs34725_autorange() escolhe o
+ * degrau pela última leitura (com histerese) e reinicia a integração se
+ * mudar; deve ser chamado depois de usar a leitura, que é do degrau antigo.
+ */
+#define TCS34725_RANGES        9
+#define TCS34725_RANGE_DEFAULT 5    // 60x, 50 ms (sensibilidade 1260, perto de 16x/154 ms = 1024)
+
+bool tcs34725_set_range(tcs34725_ctx_t *ctx, uint8_t range);
+bool tcs34725_autorange(tcs34725_ctx_t *ctx, const tcs34725_raw_t *raw);
+
+/*
+ * Contagens normalizadas para a referência 16x / 64 ciclos (154 ms), que
+ * independem do degrau: raw * 1024 / (ganho * ciclos).
+ */
+void tcs34725_normalize(const tcs34725_ctx_t *ctx, const tcs34725_raw_t *raw, uint32_t out[4]);
+
+/* Medição não bloqueante: start / poll (AVALID) / fetch */
+bool tcs34725_start(tcs34725_ctx_t *ctx);
+sensor_status_t tcs34725_poll(tcs34725_ctx_t *ctx);
+bool tcs34725_fetch(tcs34725_ctx_t *ctx, tcs34725_raw_t *raw);
+
 bool tcs34725_read_raw(tcs34725_ctx_t *ctx,
                        uint16_t *clear,
                        uint16_t *red,
                        uint16_t *green,
                        uint16_t *blue);
 
+/*
+ * Interrupção por limiar do canal CLEAR (AILT/AIHT, PERS, AIEN): o chip só
+ * sinaliza AINT (STATUS, e o pino INT em nível baixo) quando a luz sai da
+ * faixa. tcs34725_track() centra a faixa em +-pct % da última leitura e
+ * limpa a interrupção.
+ */
+bool tcs34725_set_thresholds(tcs34725_ctx_t *ctx, uint16_t low, uint16_t high);
+bool tcs34725_set_persistence(tcs34725_ctx_t *ctx, tcs34725_pers_t pers);
+bool tcs34725_int_enable(tcs34725_ctx_t *ctx, bool enable);
+bool tcs34725_int_clear(tcs34725_ctx_t *ctx);
+bool tcs34725_int_pending(const tcs34725_ctx_t *ctx);   // AINT no último poll()
+bool tcs34725_track(tcs34725_ctx_t *ctx, uint16_t clear, uint8_t pct);
+
 #endif
@@ -0,0 +1,91 @@
+#include "TCS34725_color.h"
+#include "time_driver.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ================= Constantes DN40 (Q12) ================= */
+
+/* Coeficientes do canal de iluminância: Y = 0.136 R' + 1.0 G' - 0.444 B' */
+#define DN40_R_COEF   TCS34725_Q12(0.136)
+#define DN40_G_COEF   TCS34725_Q12(1.0)
+#define DN40_B_COEF   TCS34725_Q12(-0.444)
+
+/* Fator de dispositivo e atenuação do vidro (GA = 1.0, sem cobertura) */
+#define DN40_DF       310
+
+/* CCT = CT_COEF * B' / R' + CT_OFFSET */
+#define DN40_CT_COEF   3810
+#define DN40_CT_OFFSET 1391
+
+const tcs34725_ccm_t tcs34725_ccm_identity = {{
+    { TCS34725_Q12(1.0), 0,                 0                 },
+    { 0,                 TCS34725_Q12(1.0), 0                 },
+    { 0,                 0,                 TCS34725_Q12(1.0) },
+}};
+
+/* ================= Helpers ================= */
+
+static uint16_t clamp_u16(int32_t v) {
+    if (v < 0) return 0;
+    if (v > 0xFFFF) return 0xFFFF;
+    return (uint16_t)v;
+}
+
+/* ================= API ================= */
+
+bool tcs34725_color_compute(const tcs34725_ctx_t *ctx,
+                            const tcs34725_ccm_t *ccm,
+                            uint16_t c, uint16_t r, uint16_t g, uint16_t b,
+                            tcs34725_color_t *out)
+{
+    if (!ctx || !out) return false;
+    if (!ccm) ccm = &tcs34725_ccm_identity;
+
+    uint32_t t0 = (uint32_t)time_get_cycles();
+
+    uint16_t cycles = 256 - (uint16_t)ctx->integration;
+
+    /*
+     * Saturação: digital em 1024 contagens por ciclo de ATIME (máx. 65535);
+     * para ATIME curto (< 154 ms) a saturação analógica ocorre antes, ~75%.
+     */
+    uint32_t sat = (cycles > 63) ? 65535 : (uint32_t)cycles * 1024;
+    if (cycles <= 64) sat -= sat / 4;
+    out->saturated = (c >= sat);
+
+    /* IR a partir do CLEAR e canais sem IR */
+    int32_t ir = ((int32_t)r + g + b - c) / 2;
+    if (ir < 0) ir = 0;
+    int32_t rp = (int32_t)r - ir;
+    int32_t gp = (int32_t)g - ir;
+    int32_t bp = (int32_t)b - ir;
+    if (rp < 0) rp = 0;
+    if (gp < 0) gp = 0;
+    if (bp < 0) bp = 0;
+    out->ir = (uint16_t)ir;
+
+    /* Matriz de correção Q12 */
+    out->r = clamp_u16((ccm->m[0][0] * rp + ccm->m[0][1] * gp + ccm->m[0][2] * bp) >> 12);
+    out->g = clamp_u16((ccm->m[1][0] * rp + ccm->m[1][1] * gp + ccm->m[1][2] * bp) >> 12);
+    out->b = clamp_u16((ccm->m[2][0] * rp + ccm->m[2][1] * gp + ccm->m[2][2] * bp) >> 12);
+
+    /*
+     * Lux = Y / CPL, com CPL = (ATIME_ms * ganho) / (GA * DF).
+     * ATIME em décimos de ms: ciclos * 24. Sem 64 bits:
+     *   t        = Y * DF * 10
+     *   lux_x100 = t * 100 / den, em quociente + resto para não estourar
+     */
+    int32_t y = (DN40_R_COEF * rp + DN40_G_COEF * gp + DN40_B_COEF * bp) >> 12;
+    if (y < 0) y = 0;
+
+    uint32_t den = (uint32_t)cycles * 24 * tcs34725_gain_factor(ctx->gain);
+    uint32_t t   = (uint32_t)y * (DN40_DF * 10);
+    out->lux_x100 = (t / den) * 100 + ((t % den) * 100) / den;
+
+    /* CCT pela razão B'/R' */
+    out->cct_k = (rp > 0) ? clamp_u16(DN40_CT_COEF * bp / rp + DN40_CT_OFFSET) : 0;
+
+    out->cycles = (uint32_t)time_get_cycles() - t0;
+    return true;
+}
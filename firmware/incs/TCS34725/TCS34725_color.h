@@ -0,0 +1,47 @@
+#ifndef TCS34725_COLOR_H
+#define TCS34725_COLOR_H
+
+/*
+ * Motor de cor calibrado do TCS34725, só com inteiros (sem soft-float):
+ *  - compensação de IR usando o canal CLEAR: IR = (R + G + B - C) / 2
+ *  - matriz de correção de cor 3x3 em Q12 sobre o RGB sem IR
+ *  - lux e CCT pelo método da nota de aplicação DN40 (AMS)
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "TCS34725.h"
+
+/* Ponto fixo Q12: 4096 = 1.0 */
+#define TCS34725_Q12(x) ((int16_t)((x) * 4096 + ((x) < 0 ? -0.5 : 0.5)))
+
+/* Matriz de correção de cor (linhas = saída R, G, B). |m| < 2.0 */
+typedef struct {
+    int16_t m[3][3];
+} tcs34725_ccm_t;
+
+/* Identidade: apenas remove o IR */
+extern const tcs34725_ccm_t tcs34725_ccm_identity;
+
+/* Resultado do motor de cor */
+typedef struct {
+    uint16_t r, g, b;   // RGB calibrado (contagens, sem IR)
+    uint16_t ir;        // Componente IR estimada
+    uint32_t lux_x100;  // Lux * 100
+    uint16_t cct_k;     // Temperatura de cor correlata em K (0 = indefinida)
+    bool     saturated; // Leitura saturada: lux/CCT não confiáveis
+    uint32_t cycles;    // Ciclos de CPU gastos no cálculo
+} tcs34725_color_t;
+
+/*
+ * Calcula RGB calibrado, lux e CCT a partir de uma leitura bruta.
+ * Usa ganho e ATIME do contexto para a escala de lux e o limite de saturação.
+ * @param ccm Matriz de correção (NULL = identidade).
+ */
+bool tcs34725_color_compute(const tcs34725_ctx_t *ctx,
+                            const tcs34725_ccm_t *ccm,
+                            uint16_t c, uint16_t r, uint16_t g, uint16_t b,
+                            tcs34725_color_t *out);
+
+#endif
@@ -0,0 +1,70 @@
+#include "TCS34725_irq.h"
+#include "fastmem.h"
+
+#include <irq.h>
+#include <generated/csr.h>
+#include <generated/soc.h>
+
+static volatile bool irq_flag;
+static volatile uint32_t irq_total;
+static bool active;
+
+#ifdef CSR_TCS_INT_BASE
+static FAST_CODE void tcs34725_isr(void) {
+    irq_flag = true;
+    irq_total++;
+    tcs_int_ev_pending_write(tcs_int_ev_pending_read());
+}
+#endif
+
+bool tcs34725_irq_init(void) {
+#ifdef CSR_TCS_INT_BASE
+    irq_flag = false;
+
+    tcs_int_mode_write(0);           // Borda
+    tcs_int_edge_write(1);           // Descida: INT é dreno aberto, ativo em 0
+    tcs_int_ev_pending_write(tcs_int_ev_pending_read());
+    tcs_int_ev_enable_write(1);
+
+    irq_attach(TCS_INT_INTERRUPT, tcs34725_isr);
+    irq_setmask(irq_getmask() | (1 << TCS_INT_INTERRUPT));
+
+    active = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void tcs34725_irq_stop(void) {
+#ifdef CSR_TCS_INT_BASE
+    if (!active) return;
+    irq_setmask(irq_getmask() & ~(1 << TCS_INT_INTERRUPT));
+    tcs_int_ev_enable_write(0);
+    irq_detach(TCS_INT_INTERRUPT);
+#endif
+    active = false;
+}
+
+bool tcs34725_irq_active(void) {
+    return active;
+}
+
+bool tcs34725_irq_pending(void) {
+    return irq_flag;
+}
+
+bool tcs34725_irq_take(void) {
+    unsigned int ie = irq_getie();
+    bool f;
+
+    irq_setie(0);
+    f = irq_flag;
+    irq_flag = false;
+    irq_setie(ie);
+    return f;
+}
+
+uint32_t tcs34725_irq_count(void) {
+    return irq_total;
+}
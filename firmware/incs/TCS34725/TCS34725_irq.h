@@ -0,0 +1,24 @@
+#ifndef TCS34725_IRQ_H
+#define TCS34725_IRQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Pino INT do TCS34725 (GPIO "tcs_int" do SoC, opcional). A ISR só marca o
+ * evento; a leitura I2C fica para o laço principal. Sem o pino no SoC,
+ * tcs34725_irq_init() retorna false e o app consulta o STATUS (AINT).
+ */
+bool tcs34725_irq_init(void);
+void tcs34725_irq_stop(void);
+bool tcs34725_irq_active(void);
+
+/* true se houve borda ainda não atendida (não limpa o aviso) */
+bool tcs34725_irq_pending(void);
+
+/* true se houve borda desde a última chamada (e limpa o aviso) */
+bool tcs34725_irq_take(void);
+
+uint32_t tcs34725_irq_count(void);
+
+#endif
@@ -1,7 +1,5 @@
 // aht10.c
 // Driver do sensor AHT10 usando bb_i2c (bit-banging LiteX)
-#include <stdio.h>
-#include <stdlib.h>   // abs()
 
 #include "aht10.h"
 #include "i2c_driver.h"
@@ -10,54 +8,85 @@
 #include <stdbool.h>
 #include "time_driver.h"
 
+#define STATUS_BUSY  0x80
+
 /* ================= Implementação ================= */
 
-bool aht10_init(void) {
+bool aht10_init(aht10_ctx_t *ctx) {
     uint8_t init_cmd[3] = {0xBE, 0x08, 0x00};
 
+    if (!ctx) return false;
+
+    ctx->i2c_addr = AHT10_I2C_ADDR;
+    ctx->state = SENSOR_IDLE;
+    ctx->data.temperatura = 0;
+    ctx->data.umidade = 0;
+
     bb_i2c_init();
-    delay_ms(40);
 
     /* Init correto para AHT20/AHT21 */
-    bb_i2c_write(AHT10_I2C_ADDR, init_cmd, 3);
-
-    delay_ms(20);
+    if (!bb_i2c_write(ctx->i2c_addr, init_cmd, 3)) {
+        ctx->state = SENSOR_ERROR;
+        return false;
+    }
 
-    /* Descartar primeira leitura */
-    aht10_data_t dummy;
-    aht10_read(&dummy);
-    delay_ms(80);
+    /* Calibração carregando: a primeira medição só depois desse prazo */
+    ctx->ready_ms = time_get_ms() + AHT10_POWERUP_MS;
 
     return true;
 }
 
+bool aht10_start(aht10_ctx_t *ctx) {
+    uint8_t measure_cmd[3] = {0xAC, 0x33, 0x00};
+    uint32_t now = time_get_ms();
 
+    if (!ctx) return false;
+    if (ctx->state == SENSOR_BUSY) return true;
+    if (!sensor_time_reached(now, ctx->ready_ms)) return false;   // Ainda ligando
 
+    if (!bb_i2c_write(ctx->i2c_addr, measure_cmd, 3)) {
+        ctx->state = SENSOR_ERROR;
+        return false;
+    }
 
-bool aht10_read(aht10_data_t *data) {
-    uint8_t measure_cmd[3] = {0xAC, 0x33, 0x00};
-    uint8_t rx[7];
+    ctx->start_ms = now;
+    ctx->ready_ms = now + AHT10_MEASURE_MS;
+    ctx->state = SENSOR_BUSY;
+    return true;
+}
 
-    if (!bb_i2c_write(AHT10_I2C_ADDR, measure_cmd, 3)) {
-        return false;
+sensor_status_t aht10_poll(aht10_ctx_t *ctx) {
+    uint8_t status;
+    uint32_t now = time_get_ms();
+
+    if (!ctx) return SENSOR_ERROR;
+    if (ctx->state != SENSOR_BUSY) return ctx->state;
+    if (!sensor_time_reached(now, ctx->ready_ms)) return SENSOR_BUSY;
+
+    /* Uma consulta ao BUSY por chamada; se não terminou, reagenda */
+    if (!bb_i2c_read(ctx->i2c_addr, &status, 1)) {
+        ctx->state = SENSOR_ERROR;
+    } else if (!(status & STATUS_BUSY)) {
+        ctx->state = SENSOR_READY;
+    } else if (sensor_time_reached(now, ctx->start_ms + AHT10_TIMEOUT_MS)) {
+        ctx->state = SENSOR_ERROR;
+    } else {
+        ctx->ready_ms = now + AHT10_RETRY_MS;
     }
 
-    /* Tempo real de conversão (~80 ms) */
-    for (int i = 0; i < 10; i++) {
-        delay_ms(10);
+    return ctx->state;
+}
 
-        if (!bb_i2c_read(AHT10_I2C_ADDR, rx, 7)) {
-            return false;
-        }
+bool aht10_fetch(aht10_ctx_t *ctx, aht10_data_t *data) {
+    uint8_t rx[7];
 
-        if (!(rx[0] & 0x80)) {
-            break;
-        }
-    }
+    if (!ctx || ctx->state != SENSOR_READY) return false;
 
-    if (rx[0] & 0x80) {
+    if (!bb_i2c_read(ctx->i2c_addr, rx, 7) || (rx[0] & STATUS_BUSY)) {
+        ctx->state = SENSOR_ERROR;
         return false;
     }
+    ctx->state = SENSOR_IDLE;
 
     /* Extrai dados brutos (20 bits) */
     uint32_t raw_humi =
@@ -75,8 +104,9 @@ bool aht10_read(aht10_data_t *data) {
     int32_t temperatura_x100 = (int32_t)(((uint64_t)raw_temp * 20000ULL) >> 20) - 5000;
 
 
-    data->temperatura = temperatura_x100;
-    data->umidade     = umidade_x100;
+    ctx->data.temperatura = temperatura_x100;
+    ctx->data.umidade     = umidade_x100;
+    if (data) *data = ctx->data;
 
     return true;
-}
\ No newline at end of file
+}
@@ -4,19 +4,38 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "sensor.h"
+
 /* Endereço I2C padrão do AHT10 */
 #define AHT10_I2C_ADDR 0x38
 
+/* Tempos do datasheet (ms) */
+#define AHT10_POWERUP_MS   40   // Após alimentar / comando de init
+#define AHT10_MEASURE_MS   80   // Conversão típica após 0xAC
+#define AHT10_RETRY_MS     10   // Nova consulta ao bit BUSY
+#define AHT10_TIMEOUT_MS   200  // Desiste da conversão
+
 /* Estrutura de dados do sensor */
 typedef struct {
     int16_t temperatura; // °C * 100
     int16_t umidade;     // %RH * 100
 } aht10_data_t;
 
-/* Inicializa o sensor */
-bool aht10_init(void);
+/* Contexto do sensor */
+typedef struct {
+    uint8_t i2c_addr;
+    sensor_status_t state;
+    uint32_t ready_ms;   // Próxima consulta permitida (time_get_ms)
+    uint32_t start_ms;   // Início da conversão, para o timeout
+    aht10_data_t data;   // Última leitura
+} aht10_ctx_t;
+
+/* Inicializa o sensor (não espera: start() só dispara após AHT10_POWERUP_MS) */
+bool aht10_init(aht10_ctx_t *ctx);
 
-/* Dispara medição e lê os dados */
-bool aht10_read(aht10_data_t *data);
+/* Medição não bloqueante */
+bool aht10_start(aht10_ctx_t *ctx);
+sensor_status_t aht10_poll(aht10_ctx_t *ctx);
+bool aht10_fetch(aht10_ctx_t *ctx, aht10_data_t *data);
 
 #endif // AHT10_H
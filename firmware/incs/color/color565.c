@@ -0,0 +1,105 @@
+// color565.c
+// Conversão C/R/G/B -> RGB565 com recíproco de CLEAR e LUTs combinadas
+
+#include "color565.h"
+
+#include <stdint.h>
+
+/* ================= Tabelas ================= */
+
+/* Gamma 2.2: round(255 * (i / 255)^2.2), 256 entradas */
+static const uint8_t gamma8_lut[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+/*
+ * LUTs combinadas por canal: valor normalizado 0–255 -> bits do canal já
+ * posicionados no RGB565. O resultado é lut_r[r] | lut_g[g] | lut_b[b].
+ */
+static uint16_t lut_r[256];
+static uint16_t lut_g[256];
+static uint16_t lut_b[256];
+
+static color565_mode_t cur_mode = COLOR565_NORM;
+static uint8_t lut_ready = 0;
+
+/* ================= Montagem das LUTs ================= */
+
+static uint8_t channel_value(uint8_t v, uint16_t wb_pct) {
+    uint32_t x = v;
+
+    if (cur_mode == COLOR565_WB_GAMMA) {
+        x = (x * wb_pct) / 100;
+        if (x > 255) x = 255;
+    }
+    if (cur_mode == COLOR565_GAMMA || cur_mode == COLOR565_WB_GAMMA) {
+        x = gamma8_lut[x];
+    }
+    return (uint8_t)x;
+}
+
+void color565_set_mode(color565_mode_t mode) {
+    cur_mode = mode;
+
+    for (int i = 0; i < 256; i++) {
+        lut_r[i] = (uint16_t)(channel_value(i, COLOR565_WB_R) & 0xF8) << 8;
+        lut_g[i] = (uint16_t)(channel_value(i, COLOR565_WB_G) & 0xFC) << 3;
+        lut_b[i] = (uint16_t)(channel_value(i, COLOR565_WB_B) >> 3);
+    }
+    lut_ready = 1;
+}
+
+color565_mode_t color565_get_mode(void) {
+    return cur_mode;
+}
+
+/* ================= Conversão ================= */
+
+/*
+ * Normalização pelo canal CLEAR em ponto fixo Q16:
+ *   inv = 255 * 2^16 / c    (uma divisão por amostra)
+ *   v8  = (v * inv) >> 16   (= v * 255 / c, truncado, erro < 1 LSB)
+ * O produto cabe em 64 bits; no rv32im sai em mul + mulhu, sem __muldi3.
+ */
+static inline uint8_t norm8(uint16_t v, uint32_t inv) {
+    uint32_t n = (uint32_t)(((uint64_t)v * inv) >> 16);
+    return (n > 255) ? 255 : (uint8_t)n;
+}
+
+uint16_t color565_convert(uint16_t c, uint16_t r, uint16_t g, uint16_t b) {
+    if (!lut_ready) color565_set_mode(cur_mode);
+
+    if (cur_mode == COLOR565_RAW) {
+        return lut_r[r >> 8] | lut_g[g >> 8] | lut_b[b >> 8];
+    }
+
+    if (c == 0) c = 1; // evita divisão por zero
+    uint32_t inv = (255UL << 16) / c;
+
+    return lut_r[norm8(r, inv)] |
+           lut_g[norm8(g, inv)] |
+           lut_b[norm8(b, inv)];
+}
+
+void color565_convert_batch(const color_raw_t *in, uint16_t *out, int n) {
+    if (!lut_ready) color565_set_mode(cur_mode);
+
+    for (int i = 0; i < n; i++) {
+        out[i] = color565_convert(in[i].c, in[i].r, in[i].g, in[i].b);
+    }
+}
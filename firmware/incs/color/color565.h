@@ -0,0 +1,44 @@
+// color565.h
+// Conversão de leituras C/R/G/B (TCS34725) para RGB565 sem divisões por amostra
+
+#ifndef COLOR565_H
+#define COLOR565_H
+
+#include <stdint.h>
+
+/* Variantes de conversão */
+typedef enum {
+    COLOR565_RAW,      // 16 bits -> 8 bits (>> 8), sem normalização
+    COLOR565_NORM,     // Normalizado pelo canal CLEAR
+    COLOR565_GAMMA,    // Normalizado + gamma 2.2
+    COLOR565_WB_GAMMA  // Normalizado + white balance fixo + gamma 2.2
+} color565_mode_t;
+
+/* Amostra bruta do sensor */
+typedef struct {
+    uint16_t c;
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} color_raw_t;
+
+/* Ganhos de white balance em % (100 = 1.0), usados por COLOR565_WB_GAMMA */
+#define COLOR565_WB_R 110
+#define COLOR565_WB_G 85
+#define COLOR565_WB_B 105
+
+/*
+ * Seleciona a variante e monta as LUTs combinadas (white balance + gamma +
+ * empacotamento 565). As divisões ficam todas aqui, fora do caminho por amostra.
+ */
+void color565_set_mode(color565_mode_t mode);
+
+color565_mode_t color565_get_mode(void);
+
+/* Converte uma amostra: 1 divisão (recíproco de c) + 3 multiplicações + 3 LUTs */
+uint16_t color565_convert(uint16_t c, uint16_t r, uint16_t g, uint16_t b);
+
+/* Converte n amostras (ex.: histórico de leituras ou paleta de swatches) */
+void color565_convert_batch(const color_raw_t *in, uint16_t *out, int n);
+
+#endif // COLOR565_H
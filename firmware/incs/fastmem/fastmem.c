@@ -0,0 +1,27 @@
+// fastmem.c
+
+#include "fastmem.h"
+
+#include <string.h>
+#include <system.h>   // flush_cpu_icache / flush_cpu_dcache
+
+/* Definidos no linker.ld */
+extern uint8_t _ffastcode[], _efastcode[], _ffastcode_rom[];
+extern uint8_t _ffastdata[], _efastdata[], _ffastdata_rom[];
+
+void fastmem_init(void) {
+    memcpy(_ffastcode, _ffastcode_rom, _efastcode - _ffastcode);
+    memcpy(_ffastdata, _ffastdata_rom, _efastdata - _ffastdata);
+
+    /* O I-cache pode ter linhas da SRAM de antes da cópia (boot anterior) */
+    flush_cpu_dcache();
+    flush_cpu_icache();
+}
+
+uint32_t fastmem_code_bytes(void) {
+    return (uint32_t)(_efastcode - _ffastcode);
+}
+
+uint32_t fastmem_data_bytes(void) {
+    return (uint32_t)(_efastdata - _ffastdata);
+}
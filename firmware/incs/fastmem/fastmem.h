@@ -0,0 +1,40 @@
+// fastmem.h
+// Código e dados quentes na SRAM interna (32 KB, ciclo único, sem a SDRAM
+// e o L2 no caminho). O linker monta .fastcode/.fastdata na SRAM com a
+// carga na main_ram, logo depois de .data; fastmem_init() copia para lá.
+//
+//   FAST_CODE void isr(void) { ... }
+//   static FAST_DATA uint8_t buf[256];
+//
+// A pilha continua no topo da SRAM: o linker.ld garante FASTMEM_STACK_MIN
+// livres para ela. Com FASTMEM=0 (make FASTMEM=0) as marcas somem e tudo
+// volta para a main_ram, para medir o antes/depois com o mesmo código.
+
+#ifndef FASTMEM_H
+#define FASTMEM_H
+
+#include <stdint.h>
+
+#ifndef FASTMEM
+#define FASTMEM 1
+#endif
+
+#if FASTMEM && defined(__riscv)
+#define FAST_CODE __attribute__((section(".fastcode")))
+#define FAST_DATA __attribute__((section(".fastdata")))
+#else
+#define FAST_CODE
+#define FAST_DATA
+#endif
+
+/*
+ * Copia .fastcode e .fastdata da imagem na main_ram para a SRAM e invalida
+ * os caches. Primeira coisa do main(), antes de ligar interrupções: nada
+ * marcado pode rodar (ou ser lido) antes disso.
+ */
+void fastmem_init(void);
+
+uint32_t fastmem_code_bytes(void);
+uint32_t fastmem_data_bytes(void);
+
+#endif // FASTMEM_H
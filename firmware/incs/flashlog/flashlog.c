@@ -0,0 +1,332 @@
+// flashlog.c
+
+#include "flashlog.h"
+#include "ring.h"
+#include "time_driver.h"
+#include "sensor.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <crc.h>
+
+#define ERASE_TIMEOUT_MS    500   // 4 KB: 45 ms típico, 400 ms máximo
+#define PROGRAM_TIMEOUT_MS  10    // Página: 0,7 ms típico, 3 ms máximo
+#define EXPORT_PAGES        4     // Páginas lidas por export_step()
+
+typedef struct {
+    flashlog_page_hdr_t hdr;
+    uint8_t data[FLASHLOG_PAYLOAD];
+} page_t;
+
+RING_DEFINE(page_ring, page_t, FLASHLOG_QUEUE)
+
+typedef enum {
+    OP_IDLE = 0,
+    OP_ERASING,
+    OP_PROGRAMMING
+} flash_op_t;
+
+static flashlog_stats_t st;
+static page_ring_t queue;
+static page_t *cur;              // Página em montagem (slot reservado na fila)
+
+static flash_op_t op;
+static uint32_t op_deadline;
+static int32_t erase_pending;    // Setor a apagar à frente da cabeça (-1 = nenhum)
+static int32_t ready_sector;     // Setor já apagado à frente (-1 = nenhum)
+
+static bool exporting;
+static uint32_t exp_page;
+static uint32_t exp_off;
+static bool exp_loaded;
+static page_t exp_buf;
+
+/* ================= ENDEREÇOS ================= */
+
+static uint32_t page_off(uint32_t page) {
+    return FLASHLOG_OFFSET + page * FLASHLOG_PAGE;
+}
+
+static uint32_t sector_of(uint32_t page) {
+    return page / FLASHLOG_PPS;
+}
+
+static uint32_t next_page(uint32_t page) {
+    return (page + 1) % FLASHLOG_PAGES;
+}
+
+static uint32_t next_sector(uint32_t sector) {
+    return (sector + 1) % FLASHLOG_SECTORS;
+}
+
+/* CRC da página: da seq ao fim da carga (contíguos em page_t) */
+static uint32_t page_crc(const page_t *p) {
+    return crc32((const unsigned char *)&p->hdr.seq,
+                 sizeof(p->hdr) - offsetof(flashlog_page_hdr_t, seq) + p->hdr.len);
+}
+
+static bool page_valid(const page_t *p) {
+    return p->hdr.magic == FLASHLOG_MAGIC && p->hdr.len <= FLASHLOG_PAYLOAD &&
+           p->hdr.crc == page_crc(p);
+}
+
+static bool page_blank(uint32_t page) {
+    uint32_t buf[FLASHLOG_PAGE / 4];
+
+    flashlog_hal_read(page_off(page), buf, sizeof(buf));
+    for (unsigned i = 0; i < FLASHLOG_PAGE / 4; i++)
+        if (buf[i] != 0xFFFFFFFFu) return false;
+    return true;
+}
+
+/* ================= MONTAGEM ================= */
+
+bool flashlog_init(void) {
+    static page_t p;   // Fora da pilha: 256 B
+    int32_t newest = -1, oldest = -1;
+    uint32_t newest_seq = 0, oldest_seq = 0;
+    uint32_t idx;
+
+    memset(&st, 0, sizeof(st));
+    page_ring_init(&queue);
+    cur = NULL;
+    op = OP_IDLE;
+    erase_pending = -1;
+    ready_sector = -1;
+    exporting = false;
+
+    if (!flashlog_hal_present()) return false;   // Ex.: SoC simulado
+
+    /*
+     * A primeira página de cada setor dá a seq dele. Só o cabeçalho para
+     * descartar os setores em branco; com o magic, a página inteira e o
+     * CRC: uma programação torta pode deixar bits da seq em 1 e fazer de
+     * um setor velho o "mais novo". Setor com a primeira página inválida
+     * fica de fora: se era o mais novo, o anterior está cheio e a cabeça
+     * cai no início dele, com erase pendente.
+     */
+    for (uint32_t s = 0; s < FLASHLOG_SECTORS; s++) {
+        flashlog_hal_read(page_off(s * FLASHLOG_PPS), &p.hdr, sizeof(p.hdr));
+        if (p.hdr.magic != FLASHLOG_MAGIC) continue;
+        flashlog_hal_read(page_off(s * FLASHLOG_PPS), &p, sizeof(p));
+        if (!page_valid(&p)) continue;
+
+        if (newest < 0 || p.hdr.seq > newest_seq) {
+            newest = (int32_t)s;
+            newest_seq = p.hdr.seq;
+        }
+        if (oldest < 0 || p.hdr.seq < oldest_seq) {
+            oldest = (int32_t)s;
+            oldest_seq = p.hdr.seq;
+        }
+    }
+
+    if (newest < 0) {
+        /* Log vazio: começa no setor 0, que precisa estar apagado */
+        st.head_page = 0;
+        st.oldest_page = 0;
+        st.next_seq = 0;
+        erase_pending = 0;
+    } else {
+        /*
+         * Páginas são programadas em ordem: a cabeça é a primeira página em
+         * branco do setor mais novo. Página tocada (mesmo torta, que falha o
+         * CRC) conta como usada; a seq da página i do setor é a do setor + i.
+         */
+        for (idx = 1; idx < FLASHLOG_PPS; idx++)
+            if (page_blank(newest * FLASHLOG_PPS + idx)) break;
+
+        st.head_page = (newest * FLASHLOG_PPS + idx) % FLASHLOG_PAGES;
+        st.next_seq = newest_seq + idx;
+        st.oldest_page = oldest * FLASHLOG_PPS;
+
+        if (idx == FLASHLOG_PPS) erase_pending = (int32_t)sector_of(st.head_page);
+        else erase_pending = (int32_t)next_sector(newest);   // Erase adiantado
+    }
+
+    st.mounted = true;
+    return true;
+}
+
+/* ================= GRAVAÇÃO ================= */
+
+static void close_page(void) {
+    uint32_t used;
+
+    if (!cur || cur->hdr.len == 0) return;   // Vazia: mantém o slot reservado
+
+    page_ring_commit(&queue);
+    cur = NULL;
+    used = page_ring_count(&queue);
+    if (used > st.queue_high) st.queue_high = used;
+}
+
+void flashlog_record(bool on) {
+    if (!st.mounted) return;
+    if (!on) flashlog_sync();
+    if (on) exporting = false;
+    st.recording = on;
+}
+
+bool flashlog_recording(void) {
+    return st.recording;
+}
+
+bool flashlog_append(const void *rec, int len) {
+    if (!st.recording || len <= 0 || len > (int)FLASHLOG_MAX_RECORD) return false;
+
+    if (cur && (uint32_t)(cur->hdr.len + 1 + len) > FLASHLOG_PAYLOAD) close_page();
+    if (!cur) {
+        cur = page_ring_reserve(&queue);
+        if (!cur) {
+            st.dropped++;   // Flash atrás (erase longo): perde o registro, não a amostragem
+            return false;
+        }
+        cur->hdr.len = 0;
+    }
+
+    cur->data[cur->hdr.len] = (uint8_t)len;
+    memcpy(&cur->data[cur->hdr.len + 1], rec, len);
+    cur->hdr.len += 1 + len;
+    return true;
+}
+
+void flashlog_sync(void) {
+    close_page();
+}
+
+/* ================= MÁQUINA DA FLASH ================= */
+
+/* A cabeça pode andar: meio de setor (já apagado) ou setor pronto */
+static bool head_writable(void) {
+    return (st.head_page % FLASHLOG_PPS) != 0 ||
+           ready_sector == (int32_t)sector_of(st.head_page);
+}
+
+static void start_erase(void) {
+    uint32_t s = (uint32_t)erase_pending;
+
+    /* O setor apagado leva os dados mais antigos junto */
+    if (sector_of(st.oldest_page) == s && s != sector_of(st.head_page))
+        st.oldest_page = next_sector(s) * FLASHLOG_PPS;
+
+    flashlog_hal_erase_sector(FLASHLOG_OFFSET + s * FLASHLOG_SECTOR);
+    op = OP_ERASING;
+    op_deadline = time_get_ms() + ERASE_TIMEOUT_MS;
+}
+
+static void start_program(page_t *p) {
+    uint32_t s = sector_of(st.head_page);
+
+    p->hdr.magic = FLASHLOG_MAGIC;
+    p->hdr.seq = st.next_seq;
+    p->hdr.rsv = 0xFFFF;
+    p->hdr.crc = page_crc(p);
+
+    /* Primeira página do setor: consome o setor pronto e já pede o próximo */
+    if (st.head_page % FLASHLOG_PPS == 0) {
+        ready_sector = -1;
+        erase_pending = (int32_t)next_sector(s);
+    }
+
+    flashlog_hal_program(page_off(st.head_page), p, sizeof(p->hdr) + p->hdr.len);
+    op = OP_PROGRAMMING;
+    op_deadline = time_get_ms() + PROGRAM_TIMEOUT_MS;
+}
+
+static void finish_op(void) {
+    if (op == OP_ERASING) {
+        ready_sector = erase_pending;
+        erase_pending = -1;
+        st.erases++;
+    } else if (op == OP_PROGRAMMING) {
+        page_ring_release(&queue);
+        st.head_page = next_page(st.head_page);
+        st.next_seq++;
+        st.pages_written++;
+    }
+    op = OP_IDLE;
+}
+
+void flashlog_poll(void) {
+    page_t *p;
+
+    if (!st.mounted) return;
+
+    if (op != OP_IDLE) {
+        if (!flashlog_hal_busy()) {
+            finish_op();
+        } else if (sensor_time_reached(time_get_ms(), op_deadline)) {
+            /* Flash não responde: para o log em vez de reescrever por cima */
+            st.errors++;
+            st.mounted = false;
+            st.recording = false;
+        }
+        return;
+    }
+
+    /* Erase primeiro: a flash fica ocupada de qualquer jeito, e quanto antes
+     * começar mais folga a fila tem na próxima troca de setor. Durante o
+     * export nada de erase: a leitura pelo mmap precisa da flash livre. */
+    if (erase_pending >= 0 && ready_sector < 0 && !exporting) {
+        start_erase();
+        return;
+    }
+
+    p = (page_t *)page_ring_peek(&queue);
+    if (p && head_writable()) start_program(p);
+}
+
+/* ================= EXPORT ================= */
+
+void flashlog_export_start(void) {
+    if (!st.mounted) return;
+
+    flashlog_record(false);
+    exp_page = st.oldest_page;
+    exp_loaded = false;
+    exporting = true;
+}
+
+bool flashlog_exporting(void) {
+    return exporting;
+}
+
+bool flashlog_export_step(flashlog_emit_t emit) {
+    if (!exporting) return false;
+
+    /* Espera as páginas da fila irem para a flash e ela ficar livre */
+    if (op != OP_IDLE || !page_ring_empty(&queue)) return true;
+
+    for (int n = 0; n < EXPORT_PAGES; n++) {
+        if (!exp_loaded) {
+            if (exp_page == st.head_page) {
+                exporting = false;
+                return false;
+            }
+            flashlog_hal_read(page_off(exp_page), &exp_buf, sizeof(exp_buf));
+            if (!page_valid(&exp_buf)) {   // Em branco ou torta
+                exp_page = next_page(exp_page);
+                continue;
+            }
+            exp_off = 0;
+            exp_loaded = true;
+        }
+
+        while (exp_off < exp_buf.hdr.len) {
+            uint8_t len = exp_buf.data[exp_off];
+
+            if (len == 0 || exp_off + 1 + len > exp_buf.hdr.len) break;
+            if (!emit(&exp_buf.data[exp_off + 1], len)) return true;   // Saída cheia: retoma aqui
+            exp_off += 1 + len;
+        }
+
+        exp_loaded = false;
+        exp_page = next_page(exp_page);
+    }
+    return true;
+}
+
+const flashlog_stats_t *flashlog_stats(void) {
+    return &st;
+}
@@ -0,0 +1,102 @@
+// flashlog.h
+// Registro de dados na flash SPI (W25Q64): log só de acréscimo, circular,
+// numa faixa reservada, escrito uma página de 256 bytes por vez.
+
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Faixa reservada (offsets dentro da flash): os 4 MB de cima. Bitstream e
+ * firmware (FLASH_BOOT_ADDRESS) ficam abaixo de 4 MB.
+ */
+#define FLASHLOG_OFFSET     0x400000u
+#define FLASHLOG_SIZE       0x400000u
+#define FLASHLOG_SECTOR     4096u        // Menor unidade de erase
+#define FLASHLOG_PAGE       256u         // Unidade de programação
+#define FLASHLOG_SECTORS    (FLASHLOG_SIZE / FLASHLOG_SECTOR)
+#define FLASHLOG_PAGES      (FLASHLOG_SIZE / FLASHLOG_PAGE)
+#define FLASHLOG_PPS        (FLASHLOG_SECTOR / FLASHLOG_PAGE)   // Páginas por setor
+
+/*
+ * Cada página começa com um cabeçalho; o CRC32 (crc32 da libbase) cobre o
+ * resto do cabeçalho e os len bytes de carga. Página torta (queda de energia
+ * no meio do program) falha o CRC e é pulada na leitura.
+ *
+ * Carga: sequência de registros [len u8][len bytes], sem atravessar página.
+ */
+typedef struct {
+    uint32_t magic;      // FLASHLOG_MAGIC
+    uint32_t crc;        // De seq até o fim da carga
+    uint32_t seq;        // Número da página desde a criação do log (monotônico)
+    uint16_t len;        // Bytes de carga usados
+    uint16_t rsv;
+} flashlog_page_hdr_t;
+
+#define FLASHLOG_MAGIC      0x31474C46u  // "FLG1"
+#define FLASHLOG_PAYLOAD    (FLASHLOG_PAGE - sizeof(flashlog_page_hdr_t))
+#define FLASHLOG_MAX_RECORD (FLASHLOG_PAYLOAD - 1)
+
+/*
+ * Páginas prontas esperando a flash. O pior caso de erase de 4 KB (400 ms)
+ * com o PPG a ~10 KB/s junta 4000 B, mais que 16 x 240 B de carga; a fila
+ * é um ring (potência de 2), então 32 páginas: 7680 B, ~770 ms, em 8 KB
+ * da main_ram.
+ */
+#define FLASHLOG_QUEUE      32
+
+typedef struct {
+    bool     mounted;
+    bool     recording;
+    uint32_t head_page;      // Próxima página a programar (índice na faixa)
+    uint32_t oldest_page;    // Página mais antiga válida
+    uint32_t next_seq;
+    uint32_t pages_written;
+    uint32_t erases;
+    uint32_t dropped;        // Registros descartados (fila cheia)
+    uint32_t errors;         // Timeout de erase/program
+    uint32_t queue_high;     // Maior ocupação da fila de páginas
+} flashlog_stats_t;
+
+/* Monta o log: acha a página mais nova pela seq, a mais antiga e prepara o
+ * erase adiantado do próximo setor. Varre só cabeçalhos pelo mmap. */
+bool flashlog_init(void);
+
+/* Liga/desliga a gravação; desligar fecha a página parcial */
+void flashlog_record(bool on);
+bool flashlog_recording(void);
+
+/* Acrescenta um registro (até FLASHLOG_MAX_RECORD); false se descartado */
+bool flashlog_append(const void *rec, int len);
+
+/* Fecha a página parcial (mesmo incompleta) para a fila */
+void flashlog_sync(void);
+
+/*
+ * Um passo da máquina da flash, sem esperar: no máximo um comando ou uma
+ * leitura de STATUS por chamada. Chamar a cada volta do laço principal.
+ */
+void flashlog_poll(void);
+
+/*
+ * Leitura sequencial do mais antigo ao mais novo. export_start() para a
+ * gravação e espera a fila esvaziar; cada export_step() entrega registros
+ * à função emit até ela recusar (saída cheia) e retorna false no fim.
+ */
+typedef bool (*flashlog_emit_t)(const uint8_t *rec, int len);
+void flashlog_export_start(void);
+bool flashlog_export_step(flashlog_emit_t emit);
+bool flashlog_exporting(void);
+
+const flashlog_stats_t *flashlog_stats(void);
+
+/* HAL: implementada em flashlog_hal.c (placa, CSRs do LiteSPI) */
+bool flashlog_hal_present(void);                                // SoC com spiflash
+void flashlog_hal_read(uint32_t off, void *buf, uint32_t len);
+bool flashlog_hal_busy(void);                                   // STATUS.WIP
+void flashlog_hal_erase_sector(uint32_t off);                    // Sem esperar
+void flashlog_hal_program(uint32_t off, const void *buf, uint32_t len);   // Sem esperar
+
+#endif // FLASHLOG_H
@@ -0,0 +1,121 @@
+/*
+ * flashlog_hal.c - Acesso à flash SPI (W25Q64) para o flashlog no LiteX
+ * Comandos pelo master do LiteSPI (CSRs spiflash_master_*), leitura pela
+ * janela mapeada em SPIFLASH_BASE. Nada aqui espera o fim de erase/program:
+ * quem chama consulta flashlog_hal_busy(). Sem o core spiflash no SoC
+ * (a simulação, por exemplo) a flash aparece apagada e o log não monta.
+ */
+
+#include "flashlog.h"
+
+#include <string.h>
+#include <system.h>          // flush_cpu_dcache
+#include <generated/csr.h>
+#include <generated/mem.h>
+
+#ifdef CSR_SPIFLASH_MASTER_CS_ADDR
+
+#define CMD_WREN    0x06
+#define CMD_RDSR    0x05
+#define CMD_PP      0x02     // Page program
+#define CMD_SE      0x20     // Sector erase, 4 KB
+#define SR_WIP      0x01
+
+/* Fase de comando: 8 bits por transferência, 1 linha, MOSI habilitado */
+#define PHYCONFIG_1X8 ((8 << CSR_SPIFLASH_MASTER_PHYCONFIG_LEN_OFFSET) |   \
+                       (1 << CSR_SPIFLASH_MASTER_PHYCONFIG_WIDTH_OFFSET) | \
+                       (1 << CSR_SPIFLASH_MASTER_PHYCONFIG_MASK_OFFSET))
+
+static uint8_t xfer(uint8_t b) {
+    while (!(spiflash_master_status_read() & (1 << CSR_SPIFLASH_MASTER_STATUS_TX_READY_OFFSET)));
+    spiflash_master_rxtx_write(b);
+    while (!(spiflash_master_status_read() & (1 << CSR_SPIFLASH_MASTER_STATUS_RX_READY_OFFSET)));
+    return (uint8_t)spiflash_master_rxtx_read();
+}
+
+static void begin(void) {
+    spiflash_master_phyconfig_write(PHYCONFIG_1X8);
+    spiflash_master_cs_write(1);
+}
+
+static void end(void) {
+    spiflash_master_cs_write(0);
+}
+
+static void cmd_addr(uint8_t cmd, uint32_t off) {
+    xfer(cmd);
+    xfer((uint8_t)(off >> 16));
+    xfer((uint8_t)(off >> 8));
+    xfer((uint8_t)off);
+}
+
+static void write_enable(void) {
+    begin();
+    xfer(CMD_WREN);
+    end();
+}
+
+void flashlog_hal_read(uint32_t off, void *buf, uint32_t len) {
+    /* A janela mapeada passa pelo cache de dados: descarta o que houver de
+     * antes de um erase/program */
+    flush_cpu_dcache();
+    memcpy(buf, (const void *)(SPIFLASH_BASE + off), len);
+}
+
+bool flashlog_hal_busy(void) {
+    uint8_t sr;
+
+    begin();
+    xfer(CMD_RDSR);
+    sr = xfer(0xFF);
+    end();
+    return (sr & SR_WIP) != 0;
+}
+
+void flashlog_hal_erase_sector(uint32_t off) {
+    write_enable();
+    begin();
+    cmd_addr(CMD_SE, off);
+    end();
+}
+
+void flashlog_hal_program(uint32_t off, const void *buf, uint32_t len) {
+    const uint8_t *p = buf;
+
+    write_enable();
+    begin();
+    cmd_addr(CMD_PP, off);
+    for (uint32_t i = 0; i < len; i++) xfer(p[i]);
+    end();
+}
+
+bool flashlog_hal_present(void) {
+    return true;
+}
+
+#else
+
+bool flashlog_hal_present(void) {
+    return false;
+}
+
+void flashlog_hal_read(uint32_t off, void *buf, uint32_t len) {
+    (void)off;
+    memset(buf, 0xFF, len);
+}
+
+bool flashlog_hal_busy(void) {
+    return false;
+}
+
+void flashlog_hal_erase_sector(uint32_t off) {
+    (void)off;
+}
+
+void flashlog_hal_program(uint32_t off, const void *buf, uint32_t len) {
+    (void)off;
+    (void)buf;
+    (void)len;
+}
+
+#endif // CSR_SPIFLASH_MASTER_CS_ADDR
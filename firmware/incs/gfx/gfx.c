@@ -5,7 +5,10 @@
 
 #include "gfx.h"
 #include "ST7789.h" // Precisa das funções st7789_
+#include "prof.h"
 #include <stdlib.h> // Para abs()
+#include <stdint.h>
+#include <stdbool.h>
 
 // --- Funções de Ajuda (Helpers) ---
 #define _swap_int16_t(a, b) { int16_t t = a; a = b; b = t; }
@@ -14,7 +17,15 @@
 static int16_t cursor_x = 0;
 static int16_t cursor_y = 0;
 static uint16_t text_color = ST77XX_WHITE;
+static uint16_t text_bg = ST77XX_WHITE; // Igual a text_color = fundo transparente
 static uint8_t text_size = 1;
+static const gfx_font_t *text_font = 0;  // NULL = glcdfont 5x7
+
+// --- Recorte: sem clip o retângulo cobre qualquer tela, e a interseção com
+// _width/_height é feita na hora (acompanha st7789_set_rotation) ---
+#define CLIP_FULL_W INT16_MAX
+#define CLIP_FULL_H INT16_MAX
+static gfx_rect_t clip = { 0, 0, CLIP_FULL_W, CLIP_FULL_H };
 
 // --- Fonte GLCD (COMPLETA - NÃO MODIFIQUE) ---
 static const unsigned char glcdfont[] = {
@@ -115,27 +126,86 @@ static const unsigned char glcdfont[] = {
     0x08, 0x04, 0x08, 0x10, 0x08, // 0x7E '~'
 };
 
+// --- Recorte ---
+
+void gfx_set_clip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    clip.x = x;
+    clip.y = y;
+    clip.w = (w > 0) ? w : 0;
+    clip.h = (h > 0) ? h : 0;
+}
+
+void gfx_reset_clip(void) {
+    gfx_set_clip(0, 0, CLIP_FULL_W, CLIP_FULL_H);
+}
+
+gfx_rect_t gfx_get_clip(void) {
+    return clip;
+}
+
+gfx_rect_t gfx_push_clip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    gfx_rect_t saved = clip;
+    if (gfx_clip_rect(&x, &y, &w, &h)) {
+        gfx_set_clip(x, y, w, h);
+    } else {
+        gfx_set_clip(0, 0, 0, 0);
+    }
+    return saved;
+}
+
+void gfx_pop_clip(gfx_rect_t saved) {
+    clip = saved;
+}
+
+bool gfx_clip_rect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) {
+    // Aritmética em 32 bits: x + w pode estourar int16_t
+    int32_t x0 = *x, y0 = *y;
+    int32_t x1 = x0 + *w, y1 = y0 + *h;
+
+    // _width e _height são globais de ST7789.c, declarados em ST7789.h
+    int32_t cx0 = (clip.x > 0) ? clip.x : 0;
+    int32_t cy0 = (clip.y > 0) ? clip.y : 0;
+    int32_t cx1 = (int32_t)clip.x + clip.w;
+    int32_t cy1 = (int32_t)clip.y + clip.h;
+    if (cx1 > _width)  cx1 = _width;
+    if (cy1 > _height) cy1 = _height;
+
+    if (x0 < cx0) x0 = cx0;
+    if (y0 < cy0) y0 = cy0;
+    if (x1 > cx1) x1 = cx1;
+    if (y1 > cy1) y1 = cy1;
+
+    if (x1 <= x0 || y1 <= y0) return false;
+
+    *x = x0;
+    *y = y0;
+    *w = x1 - x0;
+    *h = y1 - y0;
+    return true;
+}
+
 // --- Implementação das Primitivas ---
 
 void gfx_draw_pixel(int16_t x, int16_t y, uint16_t color) {
-    // _width e _height são globais de ST7789.c, declarados em ST7789.h
-    if((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
+    int16_t w = 1, h = 1;
+    if (!gfx_clip_rect(&x, &y, &w, &h)) return;
     st7789_draw_pixel(x, y, color);
 }
 
 void gfx_fill_screen(uint16_t color) {
-    st7789_fill_rect(0, 0, _width, _height, color);
+    gfx_fill_rect(0, 0, _width, _height, color);
 }
 
 void gfx_draw_fast_vline(int16_t x, int16_t y, int16_t h, uint16_t color) {
-    st7789_fill_rect(x, y, 1, h, color);
+    gfx_fill_rect(x, y, 1, h, color);
 }
 
 void gfx_draw_fast_hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
-    st7789_fill_rect(x, y, w, 1, color);
+    gfx_fill_rect(x, y, w, 1, color);
 }
 
 void gfx_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!gfx_clip_rect(&x, &y, &w, &h)) return;
     st7789_fill_rect(x, y, w, h, color);
 }
 
@@ -250,6 +320,14 @@ void gfx_fill_circle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
 
 void gfx_set_text_color(uint16_t color) {
     text_color = color;
+    text_bg = color;
+}
+void gfx_set_text_colors(uint16_t color, uint16_t bg) {
+    text_color = color;
+    text_bg = bg;
+}
+void gfx_set_font(const gfx_font_t *font) {
+    text_font = font;
 }
 void gfx_set_cursor(int16_t x, int16_t y) {
     cursor_x = x;
@@ -284,29 +362,112 @@ void gfx_draw_char(int16_t x, int16_t y, unsigned char c, uint16_t color, uint8_
         }
     }
 }
+// Carrega uma linha do glifo alinhada à esquerda em 32 bits (bit 31 = pixel x=0)
+static inline uint32_t glyph_row_bits(const uint8_t *row, uint8_t stride) {
+    uint32_t bits = 0;
+    for (uint8_t k = 0; k < stride; k++) {
+        bits |= (uint32_t)row[k] << (24 - 8 * k);
+    }
+    return bits;
+}
+
+int16_t gfx_draw_glyph(int16_t x, int16_t y, const gfx_font_t *font, unsigned char c, uint16_t color, uint16_t bg) {
+    if (font == 0 || c < font->first || c > font->last) {
+        return 0;
+    }
+
+    const gfx_glyph_t *g = &font->glyphs[c - font->first];
+    const uint8_t *row = font->bitmap + g->offset;
+    uint8_t stride = (g->width + 7) >> 3;
+
+    if (bg != color) {
+        // Opaco: uma janela (advance x height) e os pixels de fundo vão junto
+        int16_t cx = x, cy = y, cw = g->advance, ch = font->height;
+        if (!gfx_clip_rect(&cx, &cy, &cw, &ch)) return g->advance;
+
+        uint8_t fg_hi = color >> 8, fg_lo = color & 0xFF;
+        uint8_t bg_hi = bg >> 8,    bg_lo = bg & 0xFF;
+        uint8_t skip = cx - x;  // Colunas cortadas à esquerda
+
+        row += (cy - y) * stride;
+        st7789_set_addr_window(cx, cy, cw, ch);
+        st7789_dc_set(1);
+        st7789_spi_cs_set(1);
+        for (int16_t j = 0; j < ch; j++) {
+            uint32_t bits = (skip < 32) ? glyph_row_bits(row, stride) << skip : 0;
+            row += stride;
+            for (int16_t i = 0; i < cw; i++) {
+                if (bits & 0x80000000UL) {
+                    st7789_spi_write_byte(fg_hi);
+                    st7789_spi_write_byte(fg_lo);
+                } else {
+                    st7789_spi_write_byte(bg_hi);
+                    st7789_spi_write_byte(bg_lo);
+                }
+                bits <<= 1;
+            }
+        }
+        st7789_spi_cs_set(0);
+    } else {
+        // Transparente: cada sequência de pixels acesos de uma linha vira um hline
+        for (uint8_t j = 0; j < font->height; j++) {
+            uint32_t bits = glyph_row_bits(row, stride);
+            row += stride;
+            int16_t i = 0;
+            while (bits) {
+                while (!(bits & 0x80000000UL)) { bits <<= 1; i++; }
+                int16_t start = i;
+                while (bits & 0x80000000UL)    { bits <<= 1; i++; }
+                gfx_draw_fast_hline(x + start, y + j, i - start, color);
+            }
+        }
+    }
+
+    return g->advance;
+}
+
+int16_t gfx_text_width(const char *str) {
+    int16_t w = 0;
+    if (str == 0) return 0;
+
+    unsigned char c;
+    while ((c = *str++)) {
+        if (text_font == 0) {
+            w += text_size * 6;
+        } else if (c >= text_font->first && c <= text_font->last) {
+            w += text_font->glyphs[c - text_font->first].advance;
+        }
+    }
+    return w;
+}
+
 void gfx_draw_bitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h) {
-    // 1. Define a janela de endereço para o tamanho exato do bitmap
-    st7789_set_addr_window(x, y, w, h);
+    // 1. Recorta; só a parte visível da imagem é enviada
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    if (!gfx_clip_rect(&cx, &cy, &cw, &ch)) return;
 
-    // 2. Calcula o número total de pixels
-    // Usar 'long' para evitar overflow em imagens grandes
-    long num_pixels = (long)w * (long)h;
+    // 2. Define a janela de endereço para a área visível
+    st7789_set_addr_window(cx, cy, cw, ch);
 
     // 3. Prepara para a transferência em massa de dados
     st7789_dc_set(1);     // Modo DADO
     st7789_spi_cs_set(1); // Seleciona o chip
 
-    // 4. Envia todos os pixels de uma vez
-    for (long i = 0; i < num_pixels; i++) {
-        uint16_t color = bitmap[i];
-        
-        // Divide a cor 16-bit em dois bytes (Hi e Lo)
-        uint8_t hi = (color >> 8) & 0xFF;
-        uint8_t lo = color & 0xFF;
+    // 4. Envia as linhas visíveis (trecho [cx, cx + cw) de cada linha)
+    const uint16_t *row = bitmap + (long)(cy - y) * w + (cx - x);
+    for (int16_t j = 0; j < ch; j++) {
+        for (int16_t i = 0; i < cw; i++) {
+            uint16_t color = row[i];
+
+            // Divide a cor 16-bit em dois bytes (Hi e Lo)
+            uint8_t hi = (color >> 8) & 0xFF;
+            uint8_t lo = color & 0xFF;
 
-        // Envia os bytes na ordem correta (Big Endian)
-        st7789_spi_write_byte(hi);
-        st7789_spi_write_byte(lo);
+            // Envia os bytes na ordem correta (Big Endian)
+            st7789_spi_write_byte(hi);
+            st7789_spi_write_byte(lo);
+        }
+        row += w;
     }
 
     // 5. Libera o barramento SPI
@@ -316,13 +477,17 @@ void gfx_draw_bitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, in
 void gfx_print(const char* str) {
     if (str == 0) return;
 
+    PROF_BEGIN("gfx_print");
     unsigned char c;
     while ((c = *str++)) {
         if (c == '\n') {
-            cursor_y += text_size * 8; // Avança linha
+            cursor_y += text_font ? text_font->y_advance : text_size * 8; // Avança linha
             cursor_x = 0;             // Volta ao início
         } else if (c == '\r') {
             // Ignora
+        } else if (text_font) {
+            // Fonte gfx_font_t: glifo em resolução nativa, sem escala
+            cursor_x += gfx_draw_glyph(cursor_x, cursor_y, text_font, c, text_color, text_bg);
         } else {
             // Desenha o caractere
             gfx_draw_char(cursor_x, cursor_y, c, text_color, text_size);
@@ -330,4 +495,5 @@ void gfx_print(const char* str) {
             cursor_x += text_size * 6; // 5 pixels de largura + 1 de espaço
         }
     }
+    PROF_END();
 }
\ No newline at end of file
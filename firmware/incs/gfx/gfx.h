@@ -7,14 +7,87 @@
 #define GFX_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "gfx_font.h"
+
+// Retângulo em coordenadas de tela (após rotação)
+typedef struct {
+    int16_t x, y;
+    int16_t w, h;
+} gfx_rect_t;
 
 // --- Funções de Texto ---
+
+/**
+ * @brief Define a cor do texto com fundo transparente.
+ */
 void gfx_set_text_color(uint16_t color);
+
+/**
+ * @brief Define cor do texto e de fundo. Com fundo diferente da cor do texto,
+ * cada glifo de uma fonte gfx_font_t é desenhado opaco em uma única janela,
+ * apagando o conteúdo anterior sem precisar redesenhar em preto.
+ */
+void gfx_set_text_colors(uint16_t color, uint16_t bg);
+
+/**
+ * @brief Seleciona a fonte usada por gfx_print.
+ * @param font Fonte gerada por tools/fontgen.py, ou NULL para a glcdfont 5x7.
+ */
+void gfx_set_font(const gfx_font_t *font);
 void gfx_set_cursor(int16_t x, int16_t y);
 void gfx_set_text_size(uint8_t size);
 void gfx_print(const char* str);
 void gfx_draw_char(int16_t x, int16_t y, unsigned char c, uint16_t color, uint8_t size);
 
+/**
+ * @brief Desenha um glifo de uma fonte gfx_font_t em resolução nativa.
+ * @return Avanço do cursor em pixels (0 se o caractere não existe na fonte).
+ */
+int16_t gfx_draw_glyph(int16_t x, int16_t y, const gfx_font_t *font, unsigned char c, uint16_t color, uint16_t bg);
+
+/**
+ * @brief Largura em pixels de uma string na fonte e tamanho atuais.
+ */
+int16_t gfx_text_width(const char *str);
+
+// --- Recorte (clip) ---
+// Toda primitiva é recortada contra o retângulo de clip (sempre interseccionado
+// com a tela) antes de qualquer tráfego SPI: nada é enviado fora dele.
+
+/**
+ * @brief Define o retângulo de recorte.
+ */
+void gfx_set_clip(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Remove o recorte (volta a ser a tela inteira, em qualquer rotação).
+ */
+void gfx_reset_clip(void);
+
+/**
+ * @brief Retorna o recorte atual (para salvar e restaurar depois).
+ */
+gfx_rect_t gfx_get_clip(void);
+
+/**
+ * @brief Restringe o recorte à interseção com (x, y, w, h).
+ * Uso típico em widgets: salva = gfx_push_clip(...); desenha; gfx_pop_clip(salva);
+ * @return O recorte anterior.
+ */
+gfx_rect_t gfx_push_clip(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Restaura um recorte retornado por gfx_push_clip / gfx_get_clip.
+ */
+void gfx_pop_clip(gfx_rect_t saved);
+
+/**
+ * @brief Recorta um retângulo contra o clip atual.
+ * @return false se não sobra nenhum pixel visível.
+ */
+bool gfx_clip_rect(int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+
 // --- Funções de Primitivas ---
 
 /**
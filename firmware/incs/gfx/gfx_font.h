@@ -0,0 +1,37 @@
+/*
+ * gfx_font.h - Fontes bitmap extras da biblioteca GFX
+ * As tabelas são geradas offline por tools/fontgen.py (gfx_fonts.c).
+ */
+
+#ifndef GFX_FONT_H
+#define GFX_FONT_H
+
+#include <stdint.h>
+
+/*
+ * Descritor de um glifo.
+ * Cada linha do glifo ocupa ceil(width / 8) bytes em bitmap[], com o bit
+ * mais significativo sendo o pixel da esquerda (row-major). Colunas entre
+ * width e advance são espaçamento e são pintadas com a cor de fundo.
+ */
+typedef struct {
+    uint16_t offset;   // Início do glifo em bitmap[]
+    uint8_t  width;    // Largura útil em pixels (0 = glifo vazio)
+    uint8_t  advance;  // Avanço do cursor em pixels
+} gfx_glyph_t;
+
+typedef struct {
+    const uint8_t     *bitmap;  // Linhas de todos os glifos
+    const gfx_glyph_t *glyphs;  // Um descritor por caractere em [first, last]
+    uint8_t first;              // Primeiro caractere da tabela
+    uint8_t last;               // Último caractere da tabela
+    uint8_t height;             // Altura dos glifos em pixels
+    uint8_t y_advance;          // Avanço de linha ('\n')
+} gfx_font_t;
+
+// --- Fontes disponíveis (gfx_fonts.c) ---
+extern const gfx_font_t gfx_font_10x14;  // Fixa 10x14, glcdfont suavizada (Scale2x)
+extern const gfx_font_t gfx_font_prop;   // Proporcional 5x7
+extern const gfx_font_t gfx_font_seg7;   // Numerais 7 segmentos 10x16: ' ', '-', '.', ':', '0'-'9'
+
+#endif // GFX_FONT_H
@@ -0,0 +1,495 @@
+/*
+ * gfx_fonts.c - Fontes extras da biblioteca GFX
+ * ARQUIVO GERADO por tools/fontgen.py - NÃO EDITE À MÃO.
+ */
+
+#include "gfx_font.h"
+
+/* Fonte fixa 10x14 (glcdfont + Scale2x) */
+static const uint8_t gfx_font_10x14_bitmap[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00,
+    0x33, 0x00, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x73, 0x80, 0xFF, 0xC0, 0xFF, 0xC0,
+    0x33, 0x00, 0x33, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x73, 0x80, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00,
+    0x0C, 0x00, 0x1E, 0x00, 0x3F, 0xC0, 0x7F, 0xC0, 0xCC, 0x00, 0xCC, 0x00, 0x7F, 0x00, 0x3F, 0x80,
+    0x0C, 0xC0, 0x0C, 0xC0, 0xFF, 0x80, 0xFF, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x60, 0x00, 0xF0, 0x00,
+    0xF0, 0xC0, 0x61, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x70, 0x00,
+    0xE1, 0x80, 0xC3, 0xC0, 0x03, 0xC0, 0x01, 0x80, 0x3C, 0x00, 0x7E, 0x00, 0xE3, 0x00, 0xC3, 0x00,
+    0xCE, 0x00, 0xCC, 0x00, 0x30, 0x00, 0x30, 0x00, 0xCC, 0xC0, 0xCC, 0xC0, 0xC3, 0x00, 0xE3, 0x00,
+    0x7C, 0xC0, 0x3C, 0xC0, 0x38, 0x00, 0x3C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x38, 0x00, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x07, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x38, 0x00, 0x1C, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x00, 0x30, 0x00, 0x38, 0x00,
+    0x1C, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x07, 0x00,
+    0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0xCC, 0xC0, 0xCC, 0xC0, 0x3F, 0x00, 0x3F, 0x00, 0xCC, 0xC0, 0xCC, 0xC0, 0x0C, 0x00, 0x0C, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x1E, 0x00,
+    0xFF, 0xC0, 0xFF, 0xC0, 0x1E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x38, 0x00, 0x3C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x3C, 0x00,
+    0x3C, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x01, 0xC0, 0x03, 0x80, 0x07, 0x00,
+    0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x70, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3F, 0x00, 0x7F, 0x80, 0xE0, 0xC0, 0xC0, 0xC0, 0xC3, 0xC0, 0xC7, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0,
+    0xF8, 0xC0, 0xF0, 0xC0, 0xC0, 0xC0, 0xC1, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0x0C, 0x00, 0x1C, 0x00,
+    0x3C, 0x00, 0x3C, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0,
+    0x00, 0xC0, 0x01, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x30, 0x00, 0x70, 0x00,
+    0xFF, 0xC0, 0xFF, 0xC0, 0xFF, 0xC0, 0xFF, 0xC0, 0x03, 0x80, 0x03, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x07, 0x00, 0x03, 0x80, 0x01, 0xC0, 0x00, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00,
+    0x03, 0x00, 0x07, 0x00, 0x0F, 0x00, 0x1F, 0x00, 0x33, 0x00, 0x73, 0x00, 0xC3, 0x00, 0xC7, 0x80,
+    0xFF, 0xC0, 0x7F, 0xC0, 0x07, 0x80, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x7F, 0xC0, 0xFF, 0xC0,
+    0xC0, 0x00, 0xC0, 0x00, 0xFF, 0x00, 0x7F, 0x80, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0x0F, 0x00, 0x1F, 0x00, 0x38, 0x00, 0x70, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xFF, 0x00, 0xFF, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0,
+    0x7F, 0x80, 0x3F, 0x00, 0xFF, 0x80, 0xFF, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x03, 0x80, 0x07, 0x00,
+    0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0x3F, 0x00, 0x7F, 0x80,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0xC0, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0x03, 0x80, 0x07, 0x00, 0x3E, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x3C, 0x00,
+    0x3C, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x18, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x18, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x3C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x38, 0x00, 0x30, 0x00,
+    0x03, 0x00, 0x07, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x70, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0x70, 0x00, 0x38, 0x00, 0x1C, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0xFF, 0xC0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x38, 0x00, 0x1C, 0x00, 0x0E, 0x00,
+    0x07, 0x00, 0x03, 0x80, 0x00, 0xC0, 0x00, 0xC0, 0x03, 0x80, 0x07, 0x00, 0x0E, 0x00, 0x1C, 0x00,
+    0x38, 0x00, 0x30, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0x00, 0xC0, 0x01, 0xC0,
+    0x03, 0x80, 0x07, 0x00, 0x0E, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x38, 0xC0, 0x7C, 0xC0,
+    0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0x3F, 0x00, 0x7F, 0x80,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0xFF, 0xC0, 0xFF, 0xC0,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x7F, 0x00, 0xFF, 0x80, 0xE1, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xE1, 0xC0, 0xFF, 0x00, 0xFF, 0x00, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0,
+    0xFF, 0x80, 0x7F, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00,
+    0x7C, 0x00, 0xFE, 0x00, 0xE7, 0x00, 0xC3, 0x80, 0xC1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC1, 0xC0, 0xC3, 0x80, 0xE7, 0x00, 0xFE, 0x00, 0x7C, 0x00, 0x7F, 0xC0, 0xFF, 0xC0,
+    0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xE0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xE0, 0x00, 0xFF, 0xC0, 0x7F, 0xC0, 0x7F, 0xC0, 0xFF, 0xC0, 0xE0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xE0, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0xC0, 0x00,
+    0xCF, 0x80, 0xCF, 0xC0, 0xC1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0xC0, 0x3F, 0x80,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0xFF, 0xC0, 0xFF, 0xC0,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x1E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x0F, 0xC0, 0x0F, 0xC0, 0x07, 0x80, 0x03, 0x00,
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xC3, 0x00, 0xE7, 0x00,
+    0x7E, 0x00, 0x3C, 0x00, 0xC0, 0xC0, 0xC1, 0xC0, 0xC3, 0x80, 0xC7, 0x00, 0xCE, 0x00, 0xCC, 0x00,
+    0xF0, 0x00, 0xF0, 0x00, 0xCC, 0x00, 0xCE, 0x00, 0xC7, 0x00, 0xC3, 0x80, 0xC1, 0xC0, 0xC0, 0xC0,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x00, 0xFF, 0xC0, 0x7F, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0,
+    0xF3, 0xC0, 0xF3, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE0, 0xC0,
+    0xF0, 0xC0, 0xF8, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xC7, 0xC0, 0xC3, 0xC0, 0xC1, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00,
+    0x7F, 0x00, 0xFF, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0xFF, 0x80, 0xFF, 0x00,
+    0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x3F, 0x00, 0x7F, 0x80,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0,
+    0xC3, 0x00, 0xE3, 0x00, 0x7C, 0xC0, 0x3C, 0xC0, 0x7F, 0x00, 0xFF, 0x80, 0xE1, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xE1, 0xC0, 0xFF, 0x80, 0xFF, 0x00, 0xCC, 0x00, 0xCC, 0x00, 0xC7, 0x00, 0xC3, 0x80,
+    0xC1, 0xC0, 0xC0, 0xC0, 0x3F, 0xC0, 0x7F, 0xC0, 0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xE0, 0x00,
+    0x7F, 0x00, 0x3F, 0x80, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x01, 0xC0, 0xFF, 0x80, 0xFF, 0x00,
+    0xFF, 0xC0, 0xFF, 0xC0, 0x1E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x73, 0x80, 0x33, 0x00,
+    0x1E, 0x00, 0x0C, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0x73, 0x80, 0x33, 0x00,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x73, 0x80, 0x33, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x33, 0x00, 0x73, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x73, 0x80, 0x33, 0x00, 0x1E, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0xFF, 0x80, 0xFF, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0x03, 0x80, 0x07, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x70, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xFF, 0xC0, 0x7F, 0xC0, 0x1F, 0x00, 0x3F, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x38, 0x00, 0x3F, 0x00, 0x1F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xE0, 0x00, 0x70, 0x00, 0x38, 0x00, 0x1C, 0x00, 0x0E, 0x00,
+    0x07, 0x00, 0x03, 0x80, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x3F, 0x00,
+    0x07, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00,
+    0x03, 0x00, 0x07, 0x00, 0x3F, 0x00, 0x3E, 0x00, 0x0C, 0x00, 0x1E, 0x00, 0x33, 0x00, 0x73, 0x80,
+    0xE1, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0xFF, 0xC0,
+    0x30, 0x00, 0x38, 0x00, 0x1C, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x3F, 0x80, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0xC0, 0x7F, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0x7F, 0xC0, 0x3F, 0x80, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xCF, 0x00, 0xCF, 0x80, 0xF9, 0xC0, 0xF0, 0xC0, 0xE0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0,
+    0xFF, 0x80, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x00,
+    0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00,
+    0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3C, 0xC0, 0x7C, 0xC0, 0xE7, 0xC0, 0xC3, 0xC0,
+    0xC1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0xC0, 0x3F, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xC0, 0xFF, 0x80,
+    0xC0, 0x00, 0xC0, 0x00, 0x7F, 0x00, 0x3F, 0x00, 0x0F, 0x00, 0x1F, 0x80, 0x39, 0xC0, 0x30, 0xC0,
+    0x30, 0x00, 0x78, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0x78, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x80, 0x7F, 0xC0, 0xE1, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0xC0, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x80, 0x3F, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xCF, 0x00, 0xCF, 0x80, 0xF9, 0xC0, 0xF0, 0xC0,
+    0xE0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x0C, 0x00, 0x0C, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x3C, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0E, 0x00, 0x0F, 0x00, 0x07, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xC3, 0x00, 0xE7, 0x00,
+    0x7E, 0x00, 0x3C, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC3, 0x00, 0xC7, 0x00,
+    0xCE, 0x00, 0xCC, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xCC, 0x00, 0xCE, 0x00, 0xC7, 0x00, 0xC3, 0x00,
+    0x38, 0x00, 0x3C, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x73, 0x00, 0xF3, 0x80, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xCF, 0x00, 0xCF, 0x80, 0xF9, 0xC0, 0xF0, 0xC0, 0xE0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x80,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x00, 0xFF, 0x80, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xFF, 0x80, 0xFF, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3C, 0xC0, 0x7C, 0xC0, 0xC1, 0xC0, 0xC3, 0xC0, 0x7F, 0xC0, 0x3F, 0xC0,
+    0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xCF, 0x00, 0xCF, 0x80, 0xF9, 0xC0, 0xF0, 0xC0, 0xE0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0x7F, 0x00, 0x3F, 0x80, 0x00, 0xC0, 0x00, 0xC0, 0xFF, 0x80, 0xFF, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x78, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0x78, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x30, 0xC0, 0x39, 0xC0, 0x1F, 0x80, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC1, 0xC0,
+    0xC3, 0xC0, 0xE7, 0xC0, 0x7C, 0xC0, 0x3C, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x73, 0x80, 0x33, 0x00,
+    0x1E, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0xCC, 0xC0, 0x73, 0x80, 0x33, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xE1, 0xC0, 0x73, 0x80, 0x33, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x33, 0x00, 0x73, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0xC0, 0x3F, 0xC0,
+    0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xC0, 0xFF, 0xC0, 0x03, 0x80, 0x03, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x30, 0x00, 0x70, 0x00,
+    0xFF, 0xC0, 0xFF, 0xC0, 0x03, 0x00, 0x07, 0x00, 0x0E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x1C, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x38, 0x00,
+    0x1C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x03, 0x00, 0x0E, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x1C, 0x00, 0x38, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x30, 0x00, 0x78, 0x00, 0xCC, 0xC0, 0xCC, 0xC0, 0x07, 0x80, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+static const gfx_glyph_t gfx_font_10x14_glyphs[] = {
+    {    0, 10, 12 }, // 0x20 ' '
+    {   28, 10, 12 }, // 0x21 '!'
+    {   56, 10, 12 }, // 0x22 '"'
+    {   84, 10, 12 }, // 0x23 '#'
+    {  112, 10, 12 }, // 0x24 '$'
+    {  140, 10, 12 }, // 0x25 '%'
+    {  168, 10, 12 }, // 0x26 '&'
+    {  196, 10, 12 }, // 0x27 '\''
+    {  224, 10, 12 }, // 0x28 '('
+    {  252, 10, 12 }, // 0x29 ')'
+    {  280, 10, 12 }, // 0x2A '*'
+    {  308, 10, 12 }, // 0x2B '+'
+    {  336, 10, 12 }, // 0x2C ','
+    {  364, 10, 12 }, // 0x2D '-'
+    {  392, 10, 12 }, // 0x2E '.'
+    {  420, 10, 12 }, // 0x2F '/'
+    {  448, 10, 12 }, // 0x30 '0'
+    {  476, 10, 12 }, // 0x31 '1'
+    {  504, 10, 12 }, // 0x32 '2'
+    {  532, 10, 12 }, // 0x33 '3'
+    {  560, 10, 12 }, // 0x34 '4'
+    {  588, 10, 12 }, // 0x35 '5'
+    {  616, 10, 12 }, // 0x36 '6'
+    {  644, 10, 12 }, // 0x37 '7'
+    {  672, 10, 12 }, // 0x38 '8'
+    {  700, 10, 12 }, // 0x39 '9'
+    {  728, 10, 12 }, // 0x3A ':'
+    {  756, 10, 12 }, // 0x3B ';'
+    {  784, 10, 12 }, // 0x3C '<'
+    {  812, 10, 12 }, // 0x3D '='
+    {  840, 10, 12 }, // 0x3E '>'
+    {  868, 10, 12 }, // 0x3F '?'
+    {  896, 10, 12 }, // 0x40 '@'
+    {  924, 10, 12 }, // 0x41 'A'
+    {  952, 10, 12 }, // 0x42 'B'
+    {  980, 10, 12 }, // 0x43 'C'
+    { 1008, 10, 12 }, // 0x44 'D'
+    { 1036, 10, 12 }, // 0x45 'E'
+    { 1064, 10, 12 }, // 0x46 'F'
+    { 1092, 10, 12 }, // 0x47 'G'
+    { 1120, 10, 12 }, // 0x48 'H'
+    { 1148, 10, 12 }, // 0x49 'I'
+    { 1176, 10, 12 }, // 0x4A 'J'
+    { 1204, 10, 12 }, // 0x4B 'K'
+    { 1232, 10, 12 }, // 0x4C 'L'
+    { 1260, 10, 12 }, // 0x4D 'M'
+    { 1288, 10, 12 }, // 0x4E 'N'
+    { 1316, 10, 12 }, // 0x4F 'O'
+    { 1344, 10, 12 }, // 0x50 'P'
+    { 1372, 10, 12 }, // 0x51 'Q'
+    { 1400, 10, 12 }, // 0x52 'R'
+    { 1428, 10, 12 }, // 0x53 'S'
+    { 1456, 10, 12 }, // 0x54 'T'
+    { 1484, 10, 12 }, // 0x55 'U'
+    { 1512, 10, 12 }, // 0x56 'V'
+    { 1540, 10, 12 }, // 0x57 'W'
+    { 1568, 10, 12 }, // 0x58 'X'
+    { 1596, 10, 12 }, // 0x59 'Y'
+    { 1624, 10, 12 }, // 0x5A 'Z'
+    { 1652, 10, 12 }, // 0x5B '['
+    { 1680, 10, 12 }, // 0x5C '\\'
+    { 1708, 10, 12 }, // 0x5D ']'
+    { 1736, 10, 12 }, // 0x5E '^'
+    { 1764, 10, 12 }, // 0x5F '_'
+    { 1792, 10, 12 }, // 0x60 '`'
+    { 1820, 10, 12 }, // 0x61 'a'
+    { 1848, 10, 12 }, // 0x62 'b'
+    { 1876, 10, 12 }, // 0x63 'c'
+    { 1904, 10, 12 }, // 0x64 'd'
+    { 1932, 10, 12 }, // 0x65 'e'
+    { 1960, 10, 12 }, // 0x66 'f'
+    { 1988, 10, 12 }, // 0x67 'g'
+    { 2016, 10, 12 }, // 0x68 'h'
+    { 2044, 10, 12 }, // 0x69 'i'
+    { 2072, 10, 12 }, // 0x6A 'j'
+    { 2100, 10, 12 }, // 0x6B 'k'
+    { 2128, 10, 12 }, // 0x6C 'l'
+    { 2156, 10, 12 }, // 0x6D 'm'
+    { 2184, 10, 12 }, // 0x6E 'n'
+    { 2212, 10, 12 }, // 0x6F 'o'
+    { 2240, 10, 12 }, // 0x70 'p'
+    { 2268, 10, 12 }, // 0x71 'q'
+    { 2296, 10, 12 }, // 0x72 'r'
+    { 2324, 10, 12 }, // 0x73 's'
+    { 2352, 10, 12 }, // 0x74 't'
+    { 2380, 10, 12 }, // 0x75 'u'
+    { 2408, 10, 12 }, // 0x76 'v'
+    { 2436, 10, 12 }, // 0x77 'w'
+    { 2464, 10, 12 }, // 0x78 'x'
+    { 2492, 10, 12 }, // 0x79 'y'
+    { 2520, 10, 12 }, // 0x7A 'z'
+    { 2548, 10, 12 }, // 0x7B '{'
+    { 2576, 10, 12 }, // 0x7C '|'
+    { 2604, 10, 12 }, // 0x7D '}'
+    { 2632, 10, 12 }, // 0x7E '~'
+};
+
+const gfx_font_t gfx_font_10x14 = {
+    gfx_font_10x14_bitmap, gfx_font_10x14_glyphs, 0x20, 0x7E, 14, 16
+};
+
+/* Fonte proporcional 5x7 (glcdfont sem colunas vazias) */
+static const uint8_t gfx_font_prop_bitmap[] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x80, 0x00, 0xA0, 0xA0, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x50, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0x50, 0x00, 0x20, 0x78, 0xA0, 0x70, 0x28, 0xF0, 0x20, 0x00,
+    0xC0, 0xC8, 0x10, 0x20, 0x40, 0x98, 0x18, 0x00, 0x60, 0x90, 0xA0, 0x40, 0xA8, 0x90, 0x68, 0x00,
+    0xC0, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x40, 0x80, 0x80, 0x80, 0x40, 0x20, 0x00,
+    0x80, 0x40, 0x20, 0x20, 0x20, 0x40, 0x80, 0x00, 0x00, 0x20, 0xA8, 0x70, 0xA8, 0x20, 0x00, 0x00,
+    0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x40, 0x80, 0x00,
+    0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00,
+    0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70, 0x00,
+    0x40, 0xC0, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xF8, 0x00,
+    0xF8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70, 0x00, 0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10, 0x00,
+    0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, 0x00, 0x30, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70, 0x00,
+    0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x00, 0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00,
+    0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0xC0, 0xC0, 0x00, 0x00,
+    0x00, 0xC0, 0xC0, 0x00, 0xC0, 0x40, 0x80, 0x00, 0x10, 0x20, 0x40, 0x80, 0x40, 0x20, 0x10, 0x00,
+    0x00, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x20, 0x40, 0x80, 0x00,
+    0x70, 0x88, 0x08, 0x10, 0x20, 0x00, 0x20, 0x00, 0x70, 0x88, 0x08, 0x68, 0xA8, 0xA8, 0x70, 0x00,
+    0x70, 0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x00, 0xF0, 0x88, 0x88, 0xF0, 0x88, 0x88, 0xF0, 0x00,
+    0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70, 0x00, 0xE0, 0x90, 0x88, 0x88, 0x88, 0x90, 0xE0, 0x00,
+    0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, 0x00, 0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0x80, 0x00,
+    0x70, 0x88, 0x80, 0xB8, 0x88, 0x88, 0x78, 0x00, 0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x00,
+    0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x38, 0x10, 0x10, 0x10, 0x10, 0x90, 0x60, 0x00,
+    0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00,
+    0x88, 0xD8, 0xA8, 0xA8, 0x88, 0x88, 0x88, 0x00, 0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88, 0x00,
+    0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0xF0, 0x88, 0x88, 0xF0, 0x80, 0x80, 0x80, 0x00,
+    0x70, 0x88, 0x88, 0x88, 0xA8, 0x90, 0x68, 0x00, 0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88, 0x00,
+    0x78, 0x80, 0x80, 0x70, 0x08, 0x08, 0xF0, 0x00, 0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00,
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00,
+    0x88, 0x88, 0x88, 0xA8, 0xA8, 0xA8, 0x50, 0x00, 0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00,
+    0x88, 0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x00, 0xF8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xF8, 0x00,
+    0xE0, 0x80, 0x80, 0x80, 0x80, 0x80, 0xE0, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x00,
+    0xE0, 0x20, 0x20, 0x20, 0x20, 0x20, 0xE0, 0x00, 0x20, 0x50, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x80, 0x40, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x70, 0x08, 0x78, 0x88, 0x78, 0x00, 0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0xF0, 0x00,
+    0x00, 0x00, 0x70, 0x80, 0x80, 0x88, 0x70, 0x00, 0x08, 0x08, 0x68, 0x98, 0x88, 0x88, 0x78, 0x00,
+    0x00, 0x00, 0x70, 0x88, 0xF8, 0x80, 0x70, 0x00, 0x30, 0x48, 0x40, 0xE0, 0x40, 0x40, 0x40, 0x00,
+    0x00, 0x78, 0x88, 0x88, 0x78, 0x08, 0x70, 0x00, 0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0x88, 0x00,
+    0x40, 0x00, 0xC0, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x10, 0x00, 0x30, 0x10, 0x10, 0x90, 0x60, 0x00,
+    0x80, 0x80, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x00, 0xC0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00,
+    0x00, 0x00, 0xD0, 0xA8, 0xA8, 0x88, 0x88, 0x00, 0x00, 0x00, 0xB0, 0xC8, 0x88, 0x88, 0x88, 0x00,
+    0x00, 0x00, 0x70, 0x88, 0x88, 0x88, 0x70, 0x00, 0x00, 0x00, 0xF0, 0x88, 0xF0, 0x80, 0x80, 0x00,
+    0x00, 0x00, 0x68, 0x98, 0x78, 0x08, 0x08, 0x00, 0x00, 0x00, 0xB0, 0xC8, 0x80, 0x80, 0x80, 0x00,
+    0x00, 0x00, 0x70, 0x80, 0x70, 0x08, 0xF0, 0x00, 0x40, 0x40, 0xE0, 0x40, 0x40, 0x48, 0x30, 0x00,
+    0x00, 0x00, 0x88, 0x88, 0x88, 0x98, 0x68, 0x00, 0x00, 0x00, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00,
+    0x00, 0x00, 0x88, 0x88, 0xA8, 0xA8, 0x50, 0x00, 0x00, 0x00, 0x88, 0x50, 0x20, 0x50, 0x88, 0x00,
+    0x00, 0x00, 0x88, 0x88, 0x78, 0x08, 0x70, 0x00, 0x00, 0x00, 0xF8, 0x10, 0x20, 0x40, 0xF8, 0x00,
+    0x20, 0x40, 0x40, 0x80, 0x40, 0x40, 0x20, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00,
+    0x80, 0x40, 0x40, 0x20, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00, 0x40, 0xA8, 0x10, 0x00, 0x00, 0x00,
+};
+
+static const gfx_glyph_t gfx_font_prop_glyphs[] = {
+    {    0,  0,  3 }, // 0x20 ' '
+    {    0,  1,  2 }, // 0x21 '!'
+    {    8,  3,  4 }, // 0x22 '"'
+    {   16,  5,  6 }, // 0x23 '#'
+    {   24,  5,  6 }, // 0x24 '$'
+    {   32,  5,  6 }, // 0x25 '%'
+    {   40,  5,  6 }, // 0x26 '&'
+    {   48,  2,  3 }, // 0x27 '\''
+    {   56,  3,  4 }, // 0x28 '('
+    {   64,  3,  4 }, // 0x29 ')'
+    {   72,  5,  6 }, // 0x2A '*'
+    {   80,  5,  6 }, // 0x2B '+'
+    {   88,  2,  3 }, // 0x2C ','
+    {   96,  5,  6 }, // 0x2D '-'
+    {  104,  2,  3 }, // 0x2E '.'
+    {  112,  5,  6 }, // 0x2F '/'
+    {  120,  5,  6 }, // 0x30 '0'
+    {  128,  3,  4 }, // 0x31 '1'
+    {  136,  5,  6 }, // 0x32 '2'
+    {  144,  5,  6 }, // 0x33 '3'
+    {  152,  5,  6 }, // 0x34 '4'
+    {  160,  5,  6 }, // 0x35 '5'
+    {  168,  5,  6 }, // 0x36 '6'
+    {  176,  5,  6 }, // 0x37 '7'
+    {  184,  5,  6 }, // 0x38 '8'
+    {  192,  5,  6 }, // 0x39 '9'
+    {  200,  2,  3 }, // 0x3A ':'
+    {  208,  2,  3 }, // 0x3B ';'
+    {  216,  4,  5 }, // 0x3C '<'
+    {  224,  5,  6 }, // 0x3D '='
+    {  232,  4,  5 }, // 0x3E '>'
+    {  240,  5,  6 }, // 0x3F '?'
+    {  248,  5,  6 }, // 0x40 '@'
+    {  256,  5,  6 }, // 0x41 'A'
+    {  264,  5,  6 }, // 0x42 'B'
+    {  272,  5,  6 }, // 0x43 'C'
+    {  280,  5,  6 }, // 0x44 'D'
+    {  288,  5,  6 }, // 0x45 'E'
+    {  296,  5,  6 }, // 0x46 'F'
+    {  304,  5,  6 }, // 0x47 'G'
+    {  312,  5,  6 }, // 0x48 'H'
+    {  320,  3,  4 }, // 0x49 'I'
+    {  328,  5,  6 }, // 0x4A 'J'
+    {  336,  5,  6 }, // 0x4B 'K'
+    {  344,  5,  6 }, // 0x4C 'L'
+    {  352,  5,  6 }, // 0x4D 'M'
+    {  360,  5,  6 }, // 0x4E 'N'
+    {  368,  5,  6 }, // 0x4F 'O'
+    {  376,  5,  6 }, // 0x50 'P'
+    {  384,  5,  6 }, // 0x51 'Q'
+    {  392,  5,  6 }, // 0x52 'R'
+    {  400,  5,  6 }, // 0x53 'S'
+    {  408,  5,  6 }, // 0x54 'T'
+    {  416,  5,  6 }, // 0x55 'U'
+    {  424,  5,  6 }, // 0x56 'V'
+    {  432,  5,  6 }, // 0x57 'W'
+    {  440,  5,  6 }, // 0x58 'X'
+    {  448,  5,  6 }, // 0x59 'Y'
+    {  456,  5,  6 }, // 0x5A 'Z'
+    {  464,  3,  4 }, // 0x5B '['
+    {  472,  5,  6 }, // 0x5C '\\'
+    {  480,  3,  4 }, // 0x5D ']'
+    {  488,  5,  6 }, // 0x5E '^'
+    {  496,  5,  6 }, // 0x5F '_'
+    {  504,  3,  4 }, // 0x60 '`'
+    {  512,  5,  6 }, // 0x61 'a'
+    {  520,  5,  6 }, // 0x62 'b'
+    {  528,  5,  6 }, // 0x63 'c'
+    {  536,  5,  6 }, // 0x64 'd'
+    {  544,  5,  6 }, // 0x65 'e'
+    {  552,  5,  6 }, // 0x66 'f'
+    {  560,  5,  6 }, // 0x67 'g'
+    {  568,  5,  6 }, // 0x68 'h'
+    {  576,  3,  4 }, // 0x69 'i'
+    {  584,  4,  5 }, // 0x6A 'j'
+    {  592,  4,  5 }, // 0x6B 'k'
+    {  600,  3,  4 }, // 0x6C 'l'
+    {  608,  5,  6 }, // 0x6D 'm'
+    {  616,  5,  6 }, // 0x6E 'n'
+    {  624,  5,  6 }, // 0x6F 'o'
+    {  632,  5,  6 }, // 0x70 'p'
+    {  640,  5,  6 }, // 0x71 'q'
+    {  648,  5,  6 }, // 0x72 'r'
+    {  656,  5,  6 }, // 0x73 's'
+    {  664,  5,  6 }, // 0x74 't'
+    {  672,  5,  6 }, // 0x75 'u'
+    {  680,  5,  6 }, // 0x76 'v'
+    {  688,  5,  6 }, // 0x77 'w'
+    {  696,  5,  6 }, // 0x78 'x'
+    {  704,  5,  6 }, // 0x79 'y'
+    {  712,  5,  6 }, // 0x7A 'z'
+    {  720,  3,  4 }, // 0x7B '{'
+    {  728,  1,  2 }, // 0x7C '|'
+    {  736,  3,  4 }, // 0x7D '}'
+    {  744,  5,  6 }, // 0x7E '~'
+};
+
+const gfx_font_t gfx_font_prop = {
+    gfx_font_prop_bitmap, gfx_font_prop_glyphs, 0x20, 0x7E, 8, 10
+};
+
+/* Numerais 7 segmentos 10x16 (' ', '-', '.', ':' e '0'-'9') */
+static const uint8_t gfx_font_seg7_bitmap[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0,
+    0x3F, 0x00, 0x3F, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x00,
+    0x3F, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x3F, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x00,
+    0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00,
+    0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00,
+    0x3F, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x3F, 0x00, 0x3F, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x3F, 0x00,
+    0x3F, 0x00, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x3F, 0x00, 0x3F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const gfx_glyph_t gfx_font_seg7_glyphs[] = {
+    {    0,  0, 12 }, // 0x20 ' '
+    {    0,  0,  0 }, // 0x21 '!'
+    {    0,  0,  0 }, // 0x22 '"'
+    {    0,  0,  0 }, // 0x23 '#'
+    {    0,  0,  0 }, // 0x24 '$'
+    {    0,  0,  0 }, // 0x25 '%'
+    {    0,  0,  0 }, // 0x26 '&'
+    {    0,  0,  0 }, // 0x27 '\''
+    {    0,  0,  0 }, // 0x28 '('
+    {    0,  0,  0 }, // 0x29 ')'
+    {    0,  0,  0 }, // 0x2A '*'
+    {    0,  0,  0 }, // 0x2B '+'
+    {    0,  0,  0 }, // 0x2C ','
+    {    0, 10, 12 }, // 0x2D '-'
+    {   32,  2,  4 }, // 0x2E '.'
+    {   48,  0,  0 }, // 0x2F '/'
+    {   48, 10, 12 }, // 0x30 '0'
+    {   80, 10, 12 }, // 0x31 '1'
+    {  112, 10, 12 }, // 0x32 '2'
+    {  144, 10, 12 }, // 0x33 '3'
+    {  176, 10, 12 }, // 0x34 '4'
+    {  208, 10, 12 }, // 0x35 '5'
+    {  240, 10, 12 }, // 0x36 '6'
+    {  272, 10, 12 }, // 0x37 '7'
+    {  304, 10, 12 }, // 0x38 '8'
+    {  336, 10, 12 }, // 0x39 '9'
+    {  368,  2,  4 }, // 0x3A ':'
+};
+
+const gfx_font_t gfx_font_seg7 = {
+    gfx_font_seg7_bitmap, gfx_font_seg7_glyphs, 0x20, 0x3A, 16, 20
+};
+
@@ -2,12 +2,13 @@
 // Driver I2C por bit-banging usando CSR (LiteX)
 
 #include "i2c_driver.h"
+#include "fastmem.h"
 
 #include <generated/csr.h>
 #include <system.h>   // busy_wait_us
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
+#include <stddef.h>   // NULL
 
 
 /* =========================================================
@@ -17,35 +18,35 @@
 static uint32_t i2c_w_reg = 0;
 
 /* Delay básico do barramento */
-static void i2c_delay(void) {
+static FAST_CODE void i2c_delay(void) {
     busy_wait_us(5);
 }
 
 /* Controle das linhas */
-static void i2c_set_scl(int val) {
+static FAST_CODE void i2c_set_scl(int val) {
     if (val) i2c_w_reg |=  (1 << CSR_I2C_W_SCL_OFFSET);
     else     i2c_w_reg &= ~(1 << CSR_I2C_W_SCL_OFFSET);
     i2c_w_write(i2c_w_reg);
 }
 
-static void i2c_set_sda(int val) {
+static FAST_CODE void i2c_set_sda(int val) {
     if (val) i2c_w_reg |=  (1 << CSR_I2C_W_SDA_OFFSET);
     else     i2c_w_reg &= ~(1 << CSR_I2C_W_SDA_OFFSET);
     i2c_w_write(i2c_w_reg);
 }
 
-static void i2c_set_oe(int val) {
+static FAST_CODE void i2c_set_oe(int val) {
     if (val) i2c_w_reg |=  (1 << CSR_I2C_W_OE_OFFSET);
     else     i2c_w_reg &= ~(1 << CSR_I2C_W_OE_OFFSET);
     i2c_w_write(i2c_w_reg);
 }
 
-static int i2c_read_sda(void) {
+static FAST_CODE int i2c_read_sda(void) {
     return (i2c_r_read() >> CSR_I2C_R_SDA_OFFSET) & 0x1;
 }
 
 /* Condições I2C */
-static void i2c_start(void) {
+static FAST_CODE void i2c_start(void) {
     i2c_set_sda(1);
     i2c_set_scl(1);
     i2c_delay();
@@ -54,7 +55,7 @@ static void i2c_start(void) {
     i2c_set_scl(0);
 }
 
-static void i2c_stop(void) {
+static FAST_CODE void i2c_stop(void) {
     i2c_set_sda(0);
     i2c_set_scl(1);
     i2c_delay();
@@ -63,7 +64,7 @@ static void i2c_stop(void) {
 }
 
 /* Byte-level */
-static bool i2c_write_byte(uint8_t data) {
+static FAST_CODE bool i2c_write_byte(uint8_t data) {
     for (int i = 0; i < 8; i++) {
         i2c_set_sda((data & 0x80) != 0);
         i2c_delay();
@@ -85,7 +86,7 @@ static bool i2c_write_byte(uint8_t data) {
     return ack;
 }
 
-static uint8_t i2c_read_byte(bool ack) {
+static FAST_CODE uint8_t i2c_read_byte(bool ack) {
     uint8_t data = 0;
 
     i2c_set_oe(0);
@@ -175,11 +176,8 @@ bool bb_i2c_read(uint8_t addr, uint8_t *data, uint8_t len) {
 int i2c_scan(uint8_t *found, uint8_t max_found) {
     uint8_t count = 0;
 
-    /* 1) Verifica se o barramento está em idle */
-    if (!bb_i2c_bus_idle()) {
-        printf(" ! I2C bus not idle (floating or stuck)\n");
-        return -1;
-    }
+    /* 1) Verifica se o barramento está em idle (quem chama avisa do -1) */
+    if (!bb_i2c_bus_idle()) return -1;
 
     /* 2) Scan */
     for (uint8_t addr = 1; addr < 127; addr++) {
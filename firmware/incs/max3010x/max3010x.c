@@ -1,12 +1,22 @@
 #include "max3010x.h"
+#include "fastmem.h"
+#include "prof.h"
 #include "i2c_driver.h"
 #include "time_driver.h"
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 /* Registradores */
+#define REG_INT_STATUS1   0x00
+#define REG_INT_STATUS2   0x01
+#define REG_INT_ENABLE1   0x02
+#define REG_FIFO_WR_PTR   0x04
+#define REG_OVF_COUNTER   0x05
+#define REG_FIFO_RD_PTR   0x06
 #define REG_FIFO_DATA     0x07
+#define REG_FIFO_CONFIG   0x08
 #define REG_MODE_CONFIG   0x09
 #define REG_SPO2_CONFIG   0x0A
 #define REG_LED1_PA       0x0C
@@ -15,8 +25,13 @@
 #define MODE_RESET 0x40
 #define MODE_SPO2  0x03
 
-#define PEAK_TH     800
-#define PEAK_HYST   300
+#define FIFO_PTR_MASK   0x1F
+#define SAMPLE_BYTES    6
+
+#define FINGER_TH       50000   // IR bruto abaixo disso: sem dedo
+#define PEAK_FLOOR      (20 << 8) // Limiar mínimo após o passa-banda (Q8)
+#define RR_MIN_MS       300     // 200 BPM
+#define RR_MAX_MS       2000    // 30 BPM
 
 /* ================= I2C ================= */
 
@@ -25,6 +40,11 @@ static bool write_reg(uint8_t addr, uint8_t reg, uint8_t val) {
     return bb_i2c_write(addr, buf, 2);
 }
 
+static bool read_regs(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len) {
+    if (!bb_i2c_write(addr, &reg, 1)) return false;
+    return bb_i2c_read(addr, buf, len);
+}
+
 /* ================= INIT ================= */
 
 bool max3010x_init(max3010x_ctx_t *ctx) {
@@ -34,11 +54,7 @@ bool max3010x_init(max3010x_ctx_t *ctx) {
     ctx->bpm = 0;
     ctx->finger_detected = false;
 
-    ctx->ir_idx = 0;
-    ctx->ir_dc = 0;
-    ctx->peak_high = false;
-    ctx->rr_i = 0;
-    ctx->last_peak_ms = 0;
+    ctx->fifo_overflows = 0;
 
     bb_i2c_init();
     delay_ms(10);
@@ -47,10 +63,111 @@ bool max3010x_init(max3010x_ctx_t *ctx) {
     delay_ms(100);
 
     write_reg(ctx->i2c_addr, REG_MODE_CONFIG, MODE_SPO2);
-    write_reg(ctx->i2c_addr, REG_SPO2_CONFIG, 0x27);
-    write_reg(ctx->i2c_addr, REG_LED1_PA, 0x24);
-    write_reg(ctx->i2c_addr, REG_LED2_PA, 0x24);
 
+    const max3010x_config_t cfg = MAX3010X_CONFIG_DEFAULT;
+    return max3010x_configure(ctx, &cfg);
+}
+
+/* ================= CONFIG ================= */
+
+static const uint16_t sr_hz[] = { 50, 100, 200, 400, 800, 1000, 1600, 3200 };
+
+/*
+ * Passa-banda RBJ (0.5-4 Hz, 3 oitavas, ganho 0 dB no centro) para cada taxa
+ * efetiva possível (taxa >> média). b1 = 0 e b2 = -b0; coeficientes em Q28.
+ */
+static const struct { uint16_t fs; int32_t b0, a1, a2; } bp_coef[] = {
+    {   25,   82413294,  -348790333,  103608868 },
+    {   31,   70526949,  -379667656,  127381558 },
+    {   50,   48461212,  -433019365,  171513032 },
+    {   62,   40475123,  -451246306,  187485210 },
+    {  100,   26602705,  -481757323,  215230046 },
+    {  125,   21709327,  -492206018,  225016803 },
+    {  200,   13990398,  -508387944,  240454659 },
+    {  250,   11309780,  -513926557,  245815896 },
+    {  400,    7181784,  -522378425,  254071887 },
+    {  500,    5776279,  -525235400,  256882897 },
+    {  800,    3639505,  -529559235,  261156447 },
+    { 1000,    2919513,  -531010921,  262596430 },
+    { 1600,    1832163,  -533198363,  264771129 },
+    { 3200,     919217,  -535030414,  266597021 },
+};
+
+static void ppg_reset(max3010x_ctx_t *ctx) {
+    unsigned i = 0;
+
+    memset(ctx->ir_buf, 0, sizeof(ctx->ir_buf));
+    memset(ctx->rr, 0, sizeof(ctx->rr));
+    ctx->ir_sum = 0;
+    ctx->ir_idx = 0;
+    ctx->ir_dc = 0;
+    ctx->bp_x1 = ctx->bp_x2 = ctx->bp_y1 = ctx->bp_y2 = 0;
+    ctx->peak_level = 0;
+    ctx->threshold = PEAK_FLOOR;
+    ctx->rising = false;
+    ctx->n_samples = 0;
+    ctx->last_peak_n = 0;
+    ctx->rr_sum = 0;
+    ctx->rr_i = 0;
+    ctx->rr_count = 0;
+    ctx->bpm = 0;
+
+    /* Constantes de tempo fixas em segundos, qualquer que seja a taxa:
+     * corte do DC ~0.3 Hz e decaimento do nível dos picos ~2 s */
+    ctx->dc_shift = 1;
+    while ((1u << ctx->dc_shift) < ctx->sample_rate_hz / 2u) ctx->dc_shift++;
+    ctx->peak_decay = 1;
+    while ((1u << ctx->peak_decay) < 2u * ctx->sample_rate_hz) ctx->peak_decay++;
+
+    /* Taxa fora da tabela: usa a mais próxima por baixo */
+    while (i + 1 < sizeof(bp_coef) / sizeof(bp_coef[0]) && bp_coef[i + 1].fs <= ctx->sample_rate_hz) i++;
+    ctx->bp_b0 = bp_coef[i].b0;
+    ctx->bp_a1 = bp_coef[i].a1;
+    ctx->bp_a2 = bp_coef[i].a2;
+
+    spo2_reset(&ctx->spo2, ctx->sample_rate_hz);
+}
+
+bool max3010x_configure(max3010x_ctx_t *ctx, const max3010x_config_t *cfg) {
+    if (!ctx || !cfg) return false;
+
+    uint8_t fifo_cfg = ((cfg->sample_avg & 0x07) << 5) |
+                       (cfg->fifo_rollover ? 0x10 : 0x00) |
+                       (cfg->fifo_a_full & 0x0F);
+    uint8_t spo2_cfg = ((cfg->adc_range & 0x03) << 5) |
+                       ((cfg->sample_rate & 0x07) << 2) |
+                       (cfg->pulse_width & 0x03);
+
+    if (!write_reg(ctx->i2c_addr, REG_FIFO_CONFIG, fifo_cfg)) return false;
+    if (!write_reg(ctx->i2c_addr, REG_SPO2_CONFIG, spo2_cfg)) return false;
+    if (!write_reg(ctx->i2c_addr, REG_LED1_PA, cfg->led_red_pa)) return false;
+    if (!write_reg(ctx->i2c_addr, REG_LED2_PA, cfg->led_ir_pa)) return false;
+
+    ctx->sample_rate_hz = sr_hz[cfg->sample_rate & 0x07] >> (cfg->sample_avg & 0x07);
+    ctx->fifo_a_full = cfg->fifo_a_full & 0x0F;
+    ppg_reset(ctx);
+
+    /* Descarta o que estava na FIFO com a configuração anterior */
+    write_reg(ctx->i2c_addr, REG_FIFO_WR_PTR, 0);
+    write_reg(ctx->i2c_addr, REG_OVF_COUNTER, 0);
+    write_reg(ctx->i2c_addr, REG_FIFO_RD_PTR, 0);
+
+    return true;
+}
+
+/* ================= INT ================= */
+
+bool max3010x_int_enable(max3010x_ctx_t *ctx, uint8_t mask) {
+    if (!ctx) return false;
+    return write_reg(ctx->i2c_addr, REG_INT_ENABLE1, mask & 0xE0);
+}
+
+bool max3010x_int_status(max3010x_ctx_t *ctx, uint8_t *status) {
+    uint8_t st[2];   // INT_STATUS1, INT_STATUS2
+
+    if (!ctx) return false;
+    if (!read_regs(ctx->i2c_addr, REG_INT_STATUS1, st, 2)) return false;
+    if (status) *status = st[0];
     return true;
 }
 
@@ -75,64 +192,162 @@ bool max3010x_read_fifo(max3010x_ctx_t *ctx) {
         raw[5];
     ctx->ir_value &= 0x3FFFF;
 
-    ctx->finger_detected = (ctx->ir_value > 50000);
+    ctx->finger_detected = (ctx->ir_value > FINGER_TH);
     return true;
 }
 
+int max3010x_fifo_drain(max3010x_ctx_t *ctx, max3010x_sample_t *out,
+                        uint8_t max, uint8_t *overflow) {
+    uint8_t ptr[3];   // FIFO_WR_PTR, OVF_COUNTER, FIFO_RD_PTR (consecutivos)
+    uint8_t raw[MAX3010X_FIFO_DEPTH * SAMPLE_BYTES];
+
+    if (!ctx || !out) return -1;
+    if (!read_regs(ctx->i2c_addr, REG_FIFO_WR_PTR, ptr, 3)) return -1;
+
+    uint8_t ovf = ptr[1] & FIFO_PTR_MASK;
+    uint8_t pending = (ptr[0] - ptr[2]) & FIFO_PTR_MASK;
+    if (ovf) pending = MAX3010X_FIFO_DEPTH;   // FIFO cheia: WR_PTR == RD_PTR
+
+    if (overflow) *overflow = ovf;
+    ctx->fifo_overflows += ovf;
+    ctx->n_samples += ovf;   // Mantém a base de tempo do PPG
+
+    if (pending > max) pending = max;
+    if (pending == 0) return 0;
+
+    /* Burst: FIFO_DATA não incrementa o endereço, cada 6 bytes é uma amostra */
+    if (!read_regs(ctx->i2c_addr, REG_FIFO_DATA, raw, pending * SAMPLE_BYTES)) return -1;
+
+    const uint8_t *p = raw;
+    for (uint8_t i = 0; i < pending; i++, p += SAMPLE_BYTES) {
+        out[i].red = (((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2]) & 0x3FFFF;
+        out[i].ir  = (((uint32_t)p[3] << 16) | ((uint32_t)p[4] << 8) | p[5]) & 0x3FFFF;
+    }
+
+    return pending;
+}
+
 /* ================= PPG ================= */
 
-static uint32_t ir_filtered(max3010x_ctx_t *ctx, uint32_t v) {
+/* Média móvel com soma corrente: entra a nova amostra, sai a mais antiga */
+static FAST_CODE uint32_t ir_filtered(max3010x_ctx_t *ctx, uint32_t v) {
+    if (ctx->ir_sum == 0) {      // Janela parte cheia com a 1ª amostra
+        for (int i = 0; i < IR_BUF; i++) ctx->ir_buf[i] = v;
+        ctx->ir_sum = v * IR_BUF;
+    }
+    ctx->ir_sum += v - ctx->ir_buf[ctx->ir_idx];
     ctx->ir_buf[ctx->ir_idx++] = v;
     if (ctx->ir_idx >= IR_BUF) ctx->ir_idx = 0;
+    return ctx->ir_sum / IR_BUF;
+}
 
-    uint64_t sum = 0;
-    for (int i = 0; i < IR_BUF; i++) sum += ctx->ir_buf[i];
-    return sum / IR_BUF;
+/* Remoção de DC: IIR de 1ª ordem com o nível em Q8; retorna o AC em Q8 */
+static FAST_CODE int32_t ir_ac(max3010x_ctx_t *ctx, uint32_t ir) {
+    int32_t x = (int32_t)(ir << 8);
+
+    if (ctx->ir_dc == 0) ctx->ir_dc = x;   // Parte do nível atual, sem transitório
+    ctx->ir_dc += (x - ctx->ir_dc) >> ctx->dc_shift;
+    return x - ctx->ir_dc;
 }
 
-static int32_t ir_ac(max3010x_ctx_t *ctx, uint32_t ir) {
-    ctx->ir_dc = (ctx->ir_dc * 31 + ir) / 32;
-    return (int32_t)ir - ctx->ir_dc;
+/*
+ * Biquad passa-banda (forma direta I, b1 = 0, b2 = -b0), sinal em Q8.
+ * Os bits fracionários e o arredondamento importam: a taxas altas os polos
+ * ficam colados em 1 e o erro de truncamento vira um offset grande.
+ */
+static FAST_CODE int32_t band_pass(max3010x_ctx_t *ctx, int32_t x) {
+    int64_t acc = (int64_t)ctx->bp_b0 * (x - ctx->bp_x2)
+                - (int64_t)ctx->bp_a1 * ctx->bp_y1
+                - (int64_t)ctx->bp_a2 * ctx->bp_y2;
+    int32_t y = (int32_t)((acc + (1 << 27)) >> 28);
+
+    ctx->bp_x2 = ctx->bp_x1;
+    ctx->bp_x1 = x;
+    ctx->bp_y2 = ctx->bp_y1;
+    ctx->bp_y1 = y;
+    return y;
 }
 
-static bool detect_peak(max3010x_ctx_t *ctx, int32_t ac) {
-    if (!ctx->peak_high && ac > PEAK_TH) {
-        ctx->peak_high = true;
-        return true;
-    }
-    if (ctx->peak_high && ac < PEAK_TH - PEAK_HYST) {
-        ctx->peak_high = false;
+/*
+ * Pico = troca de sinal da derivada (+ para -) acima do limiar, fora do
+ * período refratário. O limiar acompanha metade da amplitude média dos
+ * picos e decai devagar, então se ajusta ao tom de pele e à corrente do LED.
+ */
+static FAST_CODE bool detect_peak(max3010x_ctx_t *ctx, int32_t y_prev, int32_t y) {
+    bool rising = (y > y_prev);
+    bool peak = false;
+
+    if (ctx->rising && !rising && y_prev > ctx->threshold) {
+        uint32_t dt = ((ctx->n_samples - ctx->last_peak_n) * 1000) / ctx->sample_rate_hz;
+
+        if (ctx->last_peak_n == 0 || dt >= RR_MIN_MS) {
+            ctx->peak_level += (y_prev - ctx->peak_level) >> 2;
+            peak = true;
+        }
     }
-    return false;
+    ctx->rising = rising;
+
+    ctx->peak_level -= ctx->peak_level >> ctx->peak_decay;
+    ctx->threshold = ctx->peak_level / 2;
+    if (ctx->threshold < PEAK_FLOOR) ctx->threshold = PEAK_FLOOR;
+
+    return peak;
 }
 
-static uint32_t bpm_from_rr(max3010x_ctx_t *ctx, uint32_t dt) {
-    if (dt < 300 || dt > 2000) return 0;
+/* Média dos intervalos com soma corrente; 0 enquanto não há intervalos */
+static FAST_CODE uint32_t bpm_from_rr(max3010x_ctx_t *ctx, uint32_t dt) {
+    if (dt < RR_MIN_MS || dt > RR_MAX_MS) return 0;
 
+    ctx->rr_sum += dt - ctx->rr[ctx->rr_i];
     ctx->rr[ctx->rr_i++] = dt;
     if (ctx->rr_i >= RR_BUF) ctx->rr_i = 0;
+    if (ctx->rr_count < RR_BUF) ctx->rr_count++;
 
-    uint32_t sum = 0;
-    for (int i = 0; i < RR_BUF; i++) sum += ctx->rr[i];
-    return 60000 / (sum / RR_BUF);
+    return (60000 * ctx->rr_count) / ctx->rr_sum;
 }
 
-/* ================= UPDATE ================= */
-
-void max3010x_update(max3010x_ctx_t *ctx, uint32_t elapsed_ms) {
-    if (!ctx->finger_detected) {
-        ctx->bpm = 0;
-        return;
-    }
+/* Retorna true quando fecha um batimento */
+static FAST_CODE bool ppg_step(max3010x_ctx_t *ctx, uint32_t ir) {
+    int32_t y_prev = ctx->bp_y1;
+    int32_t y = band_pass(ctx, ir_ac(ctx, ir_filtered(ctx, ir)));
 
-    uint32_t ir_f = ir_filtered(ctx, ctx->ir_value);
-    int32_t ac = ir_ac(ctx, ir_f);
+    ctx->n_samples++;
 
-    if (detect_peak(ctx, ac)) {
-        uint32_t dt = elapsed_ms - ctx->last_peak_ms;
-        ctx->last_peak_ms = elapsed_ms;
+    if (!detect_peak(ctx, y_prev, y)) return false;
 
+    if (ctx->last_peak_n != 0) {
+        uint32_t dt = ((ctx->n_samples - ctx->last_peak_n) * 1000) / ctx->sample_rate_hz;
         uint32_t bpm = bpm_from_rr(ctx, dt);
         if (bpm > 30 && bpm < 200) ctx->bpm = bpm;
     }
+    ctx->last_peak_n = ctx->n_samples;
+    return true;
+}
+
+/* ================= UPDATE ================= */
+
+FAST_CODE void max3010x_process_block(max3010x_ctx_t *ctx, const max3010x_sample_t *s, int n) {
+    uint64_t t0 = time_get_cycles();
+
+    if (!ctx || !s || n <= 0 || !ctx->sample_rate_hz) return;
+
+    PROF_BEGIN("max3010x_process_block");
+    for (int i = 0; i < n; i++) {
+        ctx->finger_detected = (s[i].ir > FINGER_TH);
+        if (!ctx->finger_detected) {
+            if (ctx->n_samples) ppg_reset(ctx);
+            continue;
+        }
+        bool beat = ppg_step(ctx, s[i].ir);
+        spo2_step(&ctx->spo2, s[i].red, s[i].ir, beat);
+    }
+
+    ctx->ir_value = s[n - 1].ir;
+    ctx->red_value = s[n - 1].red;
+
+    PROF_END();
+
+    ctx->dsp_samples = n;
+    ctx->dsp_cycles = (uint32_t)(time_get_cycles() - t0);
+    if (ctx->dsp_cycles > (uint32_t)n * MAX3010X_DSP_BUDGET) ctx->dsp_over_budget++;
 }
@@ -4,11 +4,87 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "spo2.h"
+
 #define MAX3010X_I2C_ADDR 0x57
 
 #define IR_BUF     8
 #define RR_BUF     5
 
+/* Orçamento de ciclos por amostra do processamento (BPM + SpO2) */
+#define MAX3010X_DSP_BUDGET 3000
+
+/* Profundidade da FIFO do sensor (amostras) */
+#define MAX3010X_FIFO_DEPTH 32
+
+/* Uma amostra da FIFO (modo SpO2: LED1 = RED, LED2 = IR), 18 bits */
+typedef struct {
+    uint32_t red;
+    uint32_t ir;
+} max3010x_sample_t;
+
+/* FIFO_CONFIG[7:5]: média de amostras na FIFO */
+typedef enum {
+    MAX3010X_AVG_1  = 0,
+    MAX3010X_AVG_2  = 1,
+    MAX3010X_AVG_4  = 2,
+    MAX3010X_AVG_8  = 3,
+    MAX3010X_AVG_16 = 4,
+    MAX3010X_AVG_32 = 5
+} max3010x_avg_t;
+
+/* SPO2_CONFIG[6:5]: fundo de escala do ADC */
+typedef enum {
+    MAX3010X_ADC_2048NA  = 0,
+    MAX3010X_ADC_4096NA  = 1,
+    MAX3010X_ADC_8192NA  = 2,
+    MAX3010X_ADC_16384NA = 3
+} max3010x_adc_t;
+
+/* SPO2_CONFIG[4:2]: taxa de amostragem */
+typedef enum {
+    MAX3010X_SR_50   = 0,
+    MAX3010X_SR_100  = 1,
+    MAX3010X_SR_200  = 2,
+    MAX3010X_SR_400  = 3,
+    MAX3010X_SR_800  = 4,
+    MAX3010X_SR_1000 = 5,
+    MAX3010X_SR_1600 = 6,
+    MAX3010X_SR_3200 = 7
+} max3010x_sr_t;
+
+/* SPO2_CONFIG[1:0]: largura do pulso do LED (e resolução do ADC) */
+typedef enum {
+    MAX3010X_PW_69US  = 0, // 15 bits
+    MAX3010X_PW_118US = 1, // 16 bits
+    MAX3010X_PW_215US = 2, // 17 bits
+    MAX3010X_PW_411US = 3  // 18 bits
+} max3010x_pw_t;
+
+/* Configuração de aquisição (FIFO_CONFIG, SPO2_CONFIG e correntes dos LEDs) */
+typedef struct {
+    max3010x_avg_t sample_avg;
+    bool           fifo_rollover;
+    uint8_t        fifo_a_full;   // Amostras livres que disparam A_FULL (0-15)
+    max3010x_adc_t adc_range;
+    max3010x_sr_t  sample_rate;
+    max3010x_pw_t  pulse_width;
+    uint8_t        led_red_pa;    // Corrente LED1 (0.2 mA/LSB)
+    uint8_t        led_ir_pa;     // Corrente LED2 (0.2 mA/LSB)
+} max3010x_config_t;
+
+/* Configuração usada por max3010x_init (SPO2_CONFIG = 0x27: 4096 nA, 100 Hz, 411 us) */
+#define MAX3010X_CONFIG_DEFAULT {          \
+    .sample_avg    = MAX3010X_AVG_1,       \
+    .fifo_rollover = false,                \
+    .fifo_a_full   = 0,                    \
+    .adc_range     = MAX3010X_ADC_4096NA,  \
+    .sample_rate   = MAX3010X_SR_100,      \
+    .pulse_width   = MAX3010X_PW_411US,    \
+    .led_red_pa    = 0x24,                 \
+    .led_ir_pa     = 0x24,                 \
+}
+
 typedef struct {
     uint8_t  i2c_addr;
 
@@ -18,23 +94,73 @@ typedef struct {
     bool     finger_detected;
     int      bpm;
 
-    /* --- processamento interno --- */
+    uint16_t sample_rate_hz;   // Taxa efetiva na saída da FIFO (após a média)
+    uint8_t  fifo_a_full;      // Amostras livres no disparo de A_FULL
+    uint32_t fifo_overflows;   // Amostras perdidas por overflow (acumulado)
+
+    /* --- processamento interno (PPG, tudo O(1) por amostra) --- */
     uint32_t ir_buf[IR_BUF];
+    uint32_t ir_sum;           // Soma corrente da janela da média móvel
     uint8_t  ir_idx;
 
-    int32_t  ir_dc;
-    bool     peak_high;
+    int32_t  ir_dc;            // Nível DC em Q8 (IIR de 1ª ordem)
+    uint8_t  dc_shift;         // alfa = 1/2^n
+
+    int32_t  bp_b0, bp_a1, bp_a2;  // Biquad passa-banda 0.5-4 Hz (Q28)
+    int32_t  bp_x1, bp_x2;     // Estado em Q8
+    int32_t  bp_y1, bp_y2;
+
+    int32_t  peak_level;       // Amplitude média dos picos, Q8 (limiar = metade)
+    int32_t  threshold;
+    uint8_t  peak_decay;       // Decaimento do nível: 1/2^n por amostra
+    bool     rising;           // Derivada positiva na amostra anterior
+
+    uint32_t n_samples;        // Base de tempo: amostras desde o início
+    uint32_t last_peak_n;
 
-    uint32_t rr[RR_BUF];
+    uint32_t rr[RR_BUF];       // Intervalos entre batimentos (ms)
+    uint32_t rr_sum;
     uint8_t  rr_i;
+    uint8_t  rr_count;
 
-    uint32_t last_peak_ms;
+    spo2_ctx_t spo2;           // SpO2 (RED/IR) calculado junto com o BPM
+
+    uint32_t dsp_cycles;       // Custo do último bloco processado
+    uint16_t dsp_samples;      // Amostras do último bloco
+    uint32_t dsp_over_budget;  // Blocos acima de MAX3010X_DSP_BUDGET por amostra
 
 } max3010x_ctx_t;
 
 /* API */
 bool max3010x_init(max3010x_ctx_t *ctx);
+bool max3010x_configure(max3010x_ctx_t *ctx, const max3010x_config_t *cfg);
+
+/* Interrupções do sensor (INT_ENABLE1 / INT_STATUS1) */
+#define MAX3010X_INT_A_FULL   0x80  // FIFO quase cheia
+#define MAX3010X_INT_PPG_RDY  0x40  // Nova amostra
+#define MAX3010X_INT_ALC_OVF  0x20  // Cancelamento de luz ambiente saturado
+#define MAX3010X_INT_PWR_RDY  0x01
+
+bool max3010x_int_enable(max3010x_ctx_t *ctx, uint8_t mask);
+bool max3010x_int_status(max3010x_ctx_t *ctx, uint8_t *status); // Leitura limpa o pino INT
 bool max3010x_read_fifo(max3010x_ctx_t *ctx);
-void max3010x_update(max3010x_ctx_t *ctx, uint32_t elapsed_ms);
+
+/*
+ * Lê os ponteiros da FIFO e descarrega todas as amostras pendentes em uma
+ * única transação I2C (até max). Retorna o número de amostras lidas, ou -1
+ * em erro. Em *overflow (opcional) retorna as amostras perdidas desde a
+ * última leitura (OVF_COUNTER).
+ */
+int  max3010x_fifo_drain(max3010x_ctx_t *ctx, max3010x_sample_t *out,
+                         uint8_t max, uint8_t *overflow);
+
+/*
+ * Processa um bloco de amostras consecutivas (ex.: vindo de
+ * max3010x_fifo_drain). A base de tempo é a contagem de amostras à taxa
+ * configurada; amostras perdidas por overflow na FIFO já são contadas pelo
+ * dreno. Atualiza ir_value/red_value/finger_detected/bpm, o SpO2 em
+ * ctx->spo2 e registra o custo do bloco em dsp_cycles.
+ */
+void max3010x_process_block(max3010x_ctx_t *ctx, const max3010x_sample_t *s, int n);
 
 #endif
@@ -0,0 +1,151 @@
+#include "max3010x_irq.h"
+#include "fastmem.h"
+#include "time_driver.h"
+#include "ring.h"
+
+#include <stddef.h>
+#include <irq.h>
+#include <generated/csr.h>
+#include <generated/soc.h>
+
+RING_DEFINE(stamped_ring, max3010x_stamped_t, MAX3010X_IRQ_RING)
+
+static FAST_DATA stamped_ring_t ring;
+
+static volatile bool irq_flag;
+static volatile uint64_t irq_t_cycles;
+static volatile uint32_t irq_total;
+static uint32_t dropped;
+static uint32_t last_service_ms;
+static bool active;
+
+/* ================= ISR ================= */
+
+#ifdef CSR_MAX_INT_BASE
+static FAST_CODE void max3010x_isr(void) {
+    irq_t_cycles = time_get_cycles();
+    irq_flag = true;
+    irq_total++;
+    max_int_ev_pending_write(max_int_ev_pending_read());
+}
+#endif
+
+/* ================= INIT ================= */
+
+bool max3010x_irq_init(max3010x_ctx_t *ctx) {
+#ifdef CSR_MAX_INT_BASE
+    max3010x_config_t cfg = MAX3010X_CONFIG_DEFAULT;
+    uint8_t st;
+
+    if (!ctx) return false;
+
+    cfg.fifo_a_full = MAX3010X_IRQ_A_FULL;
+    if (!max3010x_configure(ctx, &cfg)) return false;
+    if (!max3010x_int_enable(ctx, MAX3010X_INT_A_FULL)) return false;
+    max3010x_int_status(ctx, &st);   // Solta o INT antes de armar a borda
+
+    stamped_ring_init(&ring);
+    irq_flag = false;
+    dropped = 0;
+    last_service_ms = time_get_ms();
+
+    max_int_mode_write(0);           // Borda
+    max_int_edge_write(1);           // Descida: INT é dreno aberto, ativo em 0
+    max_int_ev_pending_write(max_int_ev_pending_read());
+    max_int_ev_enable_write(1);
+
+    irq_attach(MAX_INT_INTERRUPT, max3010x_isr);
+    irq_setmask(irq_getmask() | (1 << MAX_INT_INTERRUPT));
+
+    active = true;
+    return true;
+#else
+    (void)ctx;
+    return false;
+#endif
+}
+
+void max3010x_irq_stop(void) {
+#ifdef CSR_MAX_INT_BASE
+    if (!active) return;
+    irq_setmask(irq_getmask() & ~(1 << MAX_INT_INTERRUPT));
+    max_int_ev_enable_write(0);
+    irq_detach(MAX_INT_INTERRUPT);
+#endif
+    active = false;
+}
+
+bool max3010x_irq_active(void) {
+    return active;
+}
+
+/* ================= SERVICE ================= */
+
+static void ring_push(const max3010x_sample_t *s, uint64_t t) {
+    max3010x_stamped_t *slot = stamped_ring_reserve(&ring);
+
+    if (!slot) {
+        dropped++;
+        return;
+    }
+    slot->s = *s;
+    slot->t_cycles = t;
+    stamped_ring_commit(&ring);
+}
+
+int max3010x_irq_service(max3010x_ctx_t *ctx) {
+    max3010x_sample_t s[MAX3010X_FIFO_DEPTH];
+    uint32_t now_ms = time_get_ms();
+    uint64_t t_irq, base, period;
+    bool had_irq;
+    uint8_t st;
+    int n;
+
+    if (!active || !ctx || !ctx->sample_rate_hz) return 0;
+
+    /* Sem sinal da ISR, só drena de tempos em tempos (borda perdida) */
+    if (!irq_flag && (now_ms - last_service_ms) < MAX3010X_IRQ_TIMEOUT_MS) return 0;
+    last_service_ms = now_ms;
+
+    unsigned int ie = irq_getie();
+    irq_setie(0);
+    had_irq = irq_flag;
+    t_irq = irq_t_cycles;
+    irq_flag = false;
+    irq_setie(ie);
+
+    if (!max3010x_int_status(ctx, &st)) return -1;
+    n = max3010x_fifo_drain(ctx, s, MAX3010X_FIFO_DEPTH, NULL);
+    if (n <= 0) return n;
+
+    /*
+     * No disparo de A_FULL havia (32 - a_full) amostras na FIFO: a última
+     * delas chegou em t_irq. As demais ficam espaçadas pelo período do
+     * sensor a partir desse ponto, sem o jitter do laço principal.
+     */
+    period = CONFIG_CLOCK_FREQUENCY / ctx->sample_rate_hz;
+    if (had_irq) {
+        uint32_t anchor = MAX3010X_FIFO_DEPTH - ctx->fifo_a_full - 1;
+        base = t_irq - anchor * period;
+    } else {
+        base = time_get_cycles() - (uint64_t)(n - 1) * period;
+    }
+
+    for (int i = 0; i < n; i++)
+        ring_push(&s[i], base + (uint64_t)i * period);
+
+    return n;
+}
+
+int max3010x_irq_read(max3010x_stamped_t *out, int max) {
+    if (max <= 0) return 0;
+    return (int)stamped_ring_pop_n(&ring, out, (uint32_t)max);
+}
+
+uint32_t max3010x_irq_count(void) {
+    return irq_total;
+}
+
+uint32_t max3010x_irq_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,40 @@
+#ifndef MAX3010X_IRQ_H
+#define MAX3010X_IRQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "max3010x.h"
+
+/*
+ * Aquisição do MAX3010x por interrupção (pino INT -> GPIO "max_int" do SoC).
+ *
+ * O sensor dispara A_FULL quando a FIFO atinge o nível configurado; a ISR só
+ * registra o instante (ciclos do uptime) e sinaliza. O dreno via I2C fica
+ * em max3010x_irq_service(), chamado do laço principal, porque o barramento
+ * é compartilhado com os outros sensores. As amostras vão para um buffer
+ * circular com o instante de cada uma reconstruído a partir do timestamp
+ * da interrupção e do período de amostragem do sensor.
+ */
+
+#define MAX3010X_IRQ_RING    64   // Potência de 2
+#define MAX3010X_IRQ_A_FULL  12   // Livres no disparo: 20 amostras, 120 ms de folga a 100 Hz
+#define MAX3010X_IRQ_TIMEOUT_MS 500 // Sem interrupção nesse tempo, drena assim mesmo
+
+typedef struct {
+    max3010x_sample_t s;
+    uint64_t t_cycles;            // Instante da amostra (time_get_cycles)
+} max3010x_stamped_t;
+
+/* Configura A_FULL no sensor e liga a IRQ; false se o SoC não tem o pino */
+bool max3010x_irq_init(max3010x_ctx_t *ctx);
+void max3010x_irq_stop(void);
+bool max3010x_irq_active(void);
+
+/* Dreno adiado: retorna amostras colocadas no buffer, ou -1 em erro */
+int  max3010x_irq_service(max3010x_ctx_t *ctx);
+int  max3010x_irq_read(max3010x_stamped_t *out, int max);
+
+uint32_t max3010x_irq_count(void);    // Interrupções recebidas
+uint32_t max3010x_irq_dropped(void);  // Amostras descartadas com o buffer cheio
+
+#endif
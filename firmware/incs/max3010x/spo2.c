@@ -0,0 +1,168 @@
+#include "spo2.h"
+#include "fastmem.h"
+
+#include <string.h>
+
+#define ADC_FULL        0x3FFFF
+#define ADC_SAT         (ADC_FULL - (ADC_FULL >> 6))   // ~98 % do fundo de escala
+
+#define R_MIN_Q10       410     // 0.4
+#define R_MAX_Q10       1843    // 1.8
+#define PERF_MIN        100     // 0.1 % (milésimos de %)
+#define MOTION_Q10      205     // |R - média| > 0.2
+
+/*
+ * SpO2 = -45.060 R² + 30.354 R + 94.845 (curva de referência da Maxim),
+ * em décimos de %, R de 0 a 2 em passos de 1/32. Substituir pela curva de
+ * calibração do sensor/montagem quando houver.
+ */
+static const uint16_t spo2_lut[65] = {
+     948,  957,  966,  973,  979,  985,  990,  993,
+     996,  998,  999, 1000,  999,  997,  995,  992,
+     988,  983,  977,  970,  962,  954,  944,  934,
+     923,  911,  898,  884,  869,  853,  837,  820,
+     801,  782,  762,  741,  720,  697,  673,  649,
+     624,  598,  571,  543,  514,  484,  454,  422,
+     390,  357,  323,  288,  252,  215,  178,  139,
+     100,   59,   18,    0,    0,    0,    0,    0,
+       0,
+};
+
+uint16_t spo2_from_ratio(uint16_t r_q10) {
+    uint32_t i = r_q10 >> 5;        // passo de 1/32 = 32 em Q10
+    uint32_t f = r_q10 & 31;
+
+    if (i >= 64) return spo2_lut[64];
+    return (uint16_t)((spo2_lut[i] * (32 - f) + spo2_lut[i + 1] * f) >> 5);
+}
+
+static void window_reset(spo2_ctx_t *sp) {
+    sp->max_red = sp->max_ir = INT32_MIN;
+    sp->min_red = sp->min_ir = INT32_MAX;
+    sp->beat_len = 0;
+    sp->sat = false;
+}
+
+void spo2_reset(spo2_ctx_t *sp, uint16_t fs) {
+    memset(sp, 0, sizeof(*sp));
+    sp->fs = fs ? fs : 100;
+
+    /* DC com corte ~0.3 Hz, igual ao do caminho de BPM */
+    sp->dc_shift = 1;
+    while ((1u << sp->dc_shift) < sp->fs / 2u) sp->dc_shift++;
+
+    window_reset(sp);
+}
+
+/*
+ * Mantissa de 16 bits ([2^15, 2^16)) e expoente: v ~ *v << e. Laço em vez
+ * de __builtin_clz, que sem Zbb vira chamada da libgcc.
+ */
+static FAST_CODE int norm16(uint32_t *v) {
+    int e = 0;
+
+    while (*v >= 1u << 16) { *v >>= 1; e++; }
+    while (*v < 1u << 15) { *v <<= 1; e--; }
+    return e;
+}
+
+/*
+ * (a * b << shift) / (c * d) só com mul/div de 32 bits, saturando em
+ * UINT32_MAX. A divisão de 64 bits chamaria __udivdi3, que roda da SDRAM
+ * e tira o sentido de beat_done estar na SRAM. Erro relativo ~2^-13,
+ * bem abaixo do passo de R (1/1024) e do de perfusão que importa.
+ */
+static FAST_CODE uint32_t mul_div(uint32_t a, uint32_t b, uint32_t c, uint32_t d, int shift) {
+    uint32_t n, m, q;
+    int e;
+
+    if (!a || !b) return 0;
+    if (!c || !d) return UINT32_MAX;
+
+    e = norm16(&a) + norm16(&b) - norm16(&c) - norm16(&d) + shift;
+    n = (a * b) >> 1;      // [2^29, 2^31)
+    m = (c * d) >> 16;     // [2^14, 2^16)
+    e += 1 - 16;
+    q = n / m;
+
+    if (e >= 0) return (e >= 32 || q > (UINT32_MAX >> e)) ? UINT32_MAX : q << e;
+    return e <= -32 ? 0 : q >> -e;
+}
+
+/* Fecha a janela: R do batimento, qualidade e média */
+static FAST_CODE void beat_done(spo2_ctx_t *sp) {
+    uint8_t flags = 0;
+    uint32_t ac_red = (uint32_t)(sp->max_red - sp->min_red);
+    uint32_t ac_ir  = (uint32_t)(sp->max_ir - sp->min_ir);
+    uint32_t dc_red = (uint32_t)sp->dc_red;
+    uint32_t dc_ir  = (uint32_t)sp->dc_ir;
+    uint32_t r = 0;
+
+    if (sp->beat_len < sp->fs * 3 / 10 || sp->beat_len > sp->fs * 2)
+        flags |= SPO2_F_BEAT_LEN;
+    if (sp->sat)
+        flags |= SPO2_F_SATURATED;
+
+    /* Sem DC não há perfusão: zera em vez de herdar a do batimento anterior */
+    if (dc_ir) {
+        uint32_t pi = mul_div(ac_ir, 100000, dc_ir, 1, 0);
+        sp->perf_x1000 = (pi > UINT16_MAX) ? UINT16_MAX : (uint16_t)pi;
+    } else {
+        sp->perf_x1000 = 0;
+    }
+    if (sp->perf_x1000 < PERF_MIN || ac_red == 0)
+        flags |= SPO2_F_LOW_PERF;
+
+    if (!(flags & (SPO2_F_LOW_PERF | SPO2_F_BEAT_LEN)) && dc_red) {
+        r = mul_div(ac_red, dc_ir, dc_red, ac_ir, 10);
+        if (r < R_MIN_Q10 || r > R_MAX_Q10) flags |= SPO2_F_R_RANGE;
+    }
+
+    if (flags == 0 && sp->r_count >= SPO2_MIN_BEATS) {
+        uint32_t mean = sp->r_sum / sp->r_count;
+        uint32_t d = (r > mean) ? r - mean : mean - r;
+        if (d > MOTION_Q10) flags |= SPO2_F_MOTION;
+    }
+
+    if (flags == 0) {
+        sp->r_sum += r - sp->r_hist[sp->r_i];
+        sp->r_hist[sp->r_i++] = (uint16_t)r;
+        if (sp->r_i >= SPO2_BEATS) sp->r_i = 0;
+        if (sp->r_count < SPO2_BEATS) sp->r_count++;
+        if (sp->good_beats < 255) sp->good_beats++;
+
+        sp->r_q10 = (uint16_t)(sp->r_sum / sp->r_count);
+        sp->spo2_x10 = spo2_from_ratio(sp->r_q10);
+    } else {
+        sp->good_beats = 0;
+    }
+
+    if (sp->good_beats >= SPO2_MIN_BEATS) flags |= SPO2_F_VALID;
+    sp->flags = flags;
+}
+
+FAST_CODE void spo2_step(spo2_ctx_t *sp, uint32_t red, uint32_t ir, bool beat) {
+    int32_t xr = (int32_t)(red << 8);
+    int32_t xi = (int32_t)(ir << 8);
+
+    if (sp->dc_ir == 0) {
+        sp->dc_red = xr;
+        sp->dc_ir = xi;
+    }
+    sp->dc_red += (xr - sp->dc_red) >> sp->dc_shift;
+    sp->dc_ir  += (xi - sp->dc_ir)  >> sp->dc_shift;
+
+    if (beat) {
+        if (sp->beat_len) beat_done(sp);
+        window_reset(sp);
+    }
+
+    int32_t ar = xr - sp->dc_red;
+    int32_t ai = xi - sp->dc_ir;
+    if (ar > sp->max_red) sp->max_red = ar;
+    if (ar < sp->min_red) sp->min_red = ar;
+    if (ai > sp->max_ir) sp->max_ir = ai;
+    if (ai < sp->min_ir) sp->min_ir = ai;
+    if (red >= ADC_SAT || ir >= ADC_SAT) sp->sat = true;
+    if (sp->beat_len < UINT16_MAX) sp->beat_len++;
+}
@@ -0,0 +1,56 @@
+#ifndef SPO2_H
+#define SPO2_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Estimador de SpO2 por "ratio of ratios", só com inteiros.
+ *
+ * Cada canal (RED e IR) tem o DC acompanhado por um IIR e o AC medido como
+ * pico-a-pico dentro de cada batimento (janela entre dois picos do detector
+ * de BPM). Por batimento: R = (ACr/DCr) / (ACir/DCir) em Q10, média dos
+ * últimos SPO2_BEATS batimentos válidos e SpO2 por tabela com interpolação.
+ */
+
+#define SPO2_BEATS      4       // Batimentos na média de R
+#define SPO2_MIN_BEATS  3       // Batimentos válidos seguidos para confiar
+
+/* Motivos de rejeição / qualidade (bits de spo2_ctx_t.flags) */
+#define SPO2_F_VALID        0x01  // spo2_x10 confiável
+#define SPO2_F_LOW_PERF     0x02  // Perfusão IR baixa (AC/DC < 0.1 %)
+#define SPO2_F_R_RANGE      0x04  // R fora de 0.4..1.8
+#define SPO2_F_SATURATED    0x08  // ADC perto do fundo de escala
+#define SPO2_F_MOTION       0x10  // R do batimento longe da média (movimento)
+#define SPO2_F_BEAT_LEN     0x20  // Janela de batimento curta/longa demais
+
+typedef struct {
+    uint16_t fs;            // Taxa de amostragem (Hz)
+    uint8_t  dc_shift;
+
+    int32_t  dc_red, dc_ir; // Q8
+    int32_t  max_red, min_red;
+    int32_t  max_ir, min_ir;
+    uint16_t beat_len;      // Amostras na janela atual
+    bool     sat;           // Alguma amostra saturada na janela
+
+    uint16_t r_hist[SPO2_BEATS];
+    uint32_t r_sum;
+    uint8_t  r_i, r_count;
+    uint8_t  good_beats;    // Batimentos válidos consecutivos
+
+    uint16_t r_q10;         // Último R médio (Q10)
+    uint16_t spo2_x10;      // SpO2 em décimos de %
+    uint16_t perf_x1000;    // Índice de perfusão IR em milésimos de %
+    uint8_t  flags;
+} spo2_ctx_t;
+
+void spo2_reset(spo2_ctx_t *sp, uint16_t fs);
+
+/* Uma amostra; beat indica que o detector de BPM fechou um batimento */
+void spo2_step(spo2_ctx_t *sp, uint32_t red, uint32_t ir, bool beat);
+
+/* Tabela de calibração: R (Q10) -> SpO2 em décimos de % */
+uint16_t spo2_from_ratio(uint16_t r_q10);
+
+#endif
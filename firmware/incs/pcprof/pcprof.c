@@ -0,0 +1,142 @@
+// pcprof.c
+
+#include "pcprof.h"
+#include "fastmem.h"
+#include "uart_log.h"
+
+#include <stdio.h>
+#include <irq.h>
+#include <generated/csr.h>
+#include <generated/soc.h>
+
+/* Definidos no linker.ld */
+extern uint8_t _ftext[], _etext[];
+extern uint8_t _ffastcode[], _efastcode[];
+
+static uint32_t text_hist[PCPROF_TEXT_BUCKETS];
+static uint32_t fast_hist[PCPROF_FAST_BUCKETS];
+
+static uint32_t text_base, text_n;
+static uint32_t fast_base, fast_n;
+static volatile uint32_t samples;
+static volatile uint32_t other;      // Fora das duas faixas (ROM, .text além do coberto)
+static bool running;
+
+/* ================= ISR ================= */
+
+#ifdef CSR_TIMER1_BASE
+/*
+ * Roda dentro do trap da libbase, que não mexe no mepc: ele ainda aponta
+ * para a instrução interrompida. Trechos com IRQ desligada atrasam a
+ * amostra até o fim deles (ela cai logo depois do irq_setie(1)).
+ */
+static FAST_CODE void pcprof_isr(void) {
+    uint32_t pc, idx;
+
+    __asm__ volatile ("csrr %0, mepc" : "=r"(pc));
+    timer1_ev_pending_write(1);
+
+    if ((idx = (pc - text_base) >> PCPROF_SHIFT) < text_n) text_hist[idx]++;
+    else if ((idx = (pc - fast_base) >> PCPROF_SHIFT) < fast_n) fast_hist[idx]++;
+    else other++;
+    samples++;
+}
+
+static void timer_on(void) {
+    timer1_load_write(CONFIG_CLOCK_FREQUENCY / PCPROF_HZ);
+    timer1_reload_write(CONFIG_CLOCK_FREQUENCY / PCPROF_HZ);
+    timer1_ev_pending_write(1);
+    timer1_ev_enable_write(1);
+    irq_setmask(irq_getmask() | (1 << TIMER1_INTERRUPT));
+    timer1_en_write(1);
+}
+#else
+static void timer_on(void) {
+}
+#endif
+
+/* ================= API ================= */
+
+static uint32_t buckets(const uint8_t *from, const uint8_t *to, uint32_t max) {
+    uint32_t n = (uint32_t)(to - from) >> PCPROF_SHIFT;
+    return n < max ? n : max;
+}
+
+bool pcprof_init(void) {
+    text_base = (uint32_t)(uintptr_t)_ftext;
+    text_n = buckets(_ftext, _etext, PCPROF_TEXT_BUCKETS);
+    fast_base = (uint32_t)(uintptr_t)_ffastcode;
+    fast_n = buckets(_ffastcode, _efastcode, PCPROF_FAST_BUCKETS);
+    running = false;
+
+#ifdef CSR_TIMER1_BASE
+    timer1_en_write(0);
+    timer1_ev_enable_write(0);
+    irq_attach(TIMER1_INTERRUPT, pcprof_isr);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool pcprof_start(void) {
+#ifdef CSR_TIMER1_BASE
+    pcprof_stop();
+    for (uint32_t i = 0; i < text_n; i++) text_hist[i] = 0;
+    for (uint32_t i = 0; i < fast_n; i++) fast_hist[i] = 0;
+    samples = 0;
+    other = 0;
+
+    timer_on();
+    running = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void pcprof_stop(void) {
+#ifdef CSR_TIMER1_BASE
+    timer1_en_write(0);
+    timer1_ev_enable_write(0);
+    irq_setmask(irq_getmask() & ~(1 << TIMER1_INTERRUPT));
+#endif
+    running = false;
+}
+
+bool pcprof_running(void) {
+    return running;
+}
+
+uint32_t pcprof_samples(void) {
+    return samples;
+}
+
+static void dump_range(const uint32_t *hist, uint32_t base, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++)
+        if (hist[i]) printf("%08lx %lu\n", (unsigned long)(base + (i << PCPROF_SHIFT)),
+                            (unsigned long)hist[i]);
+}
+
+void pcprof_dump(void) {
+    bool was = running;
+
+    /* Congela o histograma e espera o console em vez de perder linhas */
+    pcprof_stop();
+    uart_log_set_policy(UART_LOG_BLOCK);
+
+    printf("PCPROF BEGIN hz=%u samples=%lu other=%lu\n", PCPROF_HZ,
+           (unsigned long)samples, (unsigned long)other);
+    dump_range(text_hist, text_base, text_n);
+    dump_range(fast_hist, fast_base, fast_n);
+    printf("PCPROF END\n");
+
+    uart_log_flush();
+    uart_log_set_policy(UART_LOG_DROP);
+
+    /* Continua acumulando de onde parou */
+    if (was) {
+        timer_on();
+        running = true;
+    }
+}
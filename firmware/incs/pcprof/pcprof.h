@@ -0,0 +1,39 @@
+// pcprof.h
+// Perfil estatístico por amostragem do PC: a IRQ do timer1 lê o mepc (onde
+// o programa estava quando foi interrompido) e soma um no balde daquele
+// endereço. O histograma fica na SDRAM; pcprof_dump() manda em texto pela
+// serial e tools/pcprof.py resolve os endereços contra main.elf/main.elf.map.
+//
+// Precisa do timer1 no SoC (colorlight_i5.py --with-pc-sampler): o timer0
+// é do busy_wait_us e do contador de uptime.
+
+#ifndef PCPROF_H
+#define PCPROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Primo, para não andar em fase com laços de período redondo */
+#define PCPROF_HZ           997
+
+/* Um balde por instrução (RV32IM, sem compactas) */
+#define PCPROF_SHIFT        2
+#define PCPROF_TEXT_BUCKETS (64 * 1024)   // Cobre 256 KB de .text (256 KB de SDRAM)
+#define PCPROF_FAST_BUCKETS (8 * 1024)    // A SRAM inteira (.fastcode)
+
+bool pcprof_init(void);       // false se o SoC não tem o timer1
+bool pcprof_start(void);      // Zera o histograma e liga a amostragem
+void pcprof_stop(void);
+bool pcprof_running(void);
+uint32_t pcprof_samples(void);
+
+/*
+ * Texto para o tools/pcprof.py, só os baldes não vazios:
+ *   PCPROF BEGIN hz=<hz> samples=<n> other=<n>
+ *   <endereço hex> <contagem>
+ *   PCPROF END
+ * Bloqueia no console até sair tudo.
+ */
+void pcprof_dump(void);
+
+#endif // PCPROF_H
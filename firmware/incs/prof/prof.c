@@ -0,0 +1,103 @@
+// prof.c
+
+#include "prof.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <generated/soc.h>   // CONFIG_CLOCK_FREQUENCY
+
+static prof_region_t regions[PROF_MAX_REGIONS];
+static int n_regions;
+static uint32_t overhead;
+static uint32_t since_ms;
+
+prof_region_t *prof_region(const char *name) {
+    for (int i = 0; i < n_regions; i++)
+        if (strcmp(regions[i].name, name) == 0) return &regions[i];
+    if (n_regions == PROF_MAX_REGIONS) return NULL;
+
+    regions[n_regions].name = name;
+    regions[n_regions].min = UINT32_MAX;
+    return &regions[n_regions++];
+}
+
+void prof_add(prof_region_t *r, uint32_t cycles, uint32_t instret) {
+    if (!r) return;
+
+    cycles = cycles > overhead ? cycles - overhead : 0;
+    r->count++;
+    r->total += cycles;
+    r->instret += instret;
+    if (cycles < r->min) r->min = cycles;
+    if (cycles > r->max) r->max = cycles;
+}
+
+void prof_reset(void) {
+    for (int i = 0; i < n_regions; i++) {
+        regions[i].count = 0;
+        regions[i].total = 0;
+        regions[i].instret = 0;
+        regions[i].min = UINT32_MAX;
+        regions[i].max = 0;
+    }
+#if PROF && defined(__riscv)
+    since_ms = time_get_ms();
+#endif
+}
+
+void prof_init(void) {
+#if PROF && defined(__riscv)
+    uint32_t best = UINT32_MAX;
+
+    /* Menor de algumas medidas vazias: o piso do próprio relógio */
+    overhead = 0;
+    for (int i = 0; i < 8; i++) {
+        uint32_t t0 = prof_cycles();
+        uint32_t dt = prof_cycles() - t0;
+        if (dt < best) best = dt;
+    }
+    overhead = best;
+#endif
+    n_regions = 0;
+    prof_reset();
+}
+
+void prof_dump(void) {
+    int idx[PROF_MAX_REGIONS];
+    uint64_t elapsed = 0;
+    uint32_t ms = 0;
+
+#if PROF && defined(__riscv)
+    ms = time_get_ms() - since_ms;
+    elapsed = (uint64_t)ms * (CONFIG_CLOCK_FREQUENCY / 1000);
+#endif
+
+    /* Inserção pelo total, maior primeiro: poucas regiões */
+    for (int i = 0; i < n_regions; i++) {
+        int j = i;
+        while (j > 0 && regions[idx[j - 1]].total < regions[i].total) {
+            idx[j] = idx[j - 1];
+            j--;
+        }
+        idx[j] = i;
+    }
+
+    printf("prof: %lu ms, medida %lu ciclos descontada\n",
+           (unsigned long)ms, (unsigned long)overhead);
+    printf("  %-20s %8s %10s %9s %9s %9s %5s\n",
+           "regiao", "n", "kciclos", "media", "min", "max", "%");
+    for (int k = 0; k < n_regions; k++) {
+        const prof_region_t *r = &regions[idx[k]];
+
+        if (r->count == 0) continue;
+        printf("  %-20s %8lu %10lu %9lu %9lu %9lu %5lu", r->name,
+               (unsigned long)r->count, (unsigned long)(r->total / 1000),
+               (unsigned long)(r->total / r->count), (unsigned long)r->min,
+               (unsigned long)r->max,
+               (unsigned long)(elapsed ? r->total * 100 / elapsed : 0));
+        if (r->instret && r->total)
+            printf("  IPC %lu.%02lu", (unsigned long)(r->instret / r->total),
+                   (unsigned long)(r->instret * 100 / r->total % 100));
+        printf("\n");
+    }
+}
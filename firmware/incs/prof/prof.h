@@ -0,0 +1,94 @@
+// prof.h
+// Perfil por região em ciclos: PROF_BEGIN/PROF_END em volta de um trecho
+// acumulam contagem, total, mínimo e máximo numa tabela estática;
+// prof_dump() imprime o relatório ordenado pelo total.
+//
+//   PROF_BEGIN("st7789_fill_rect");
+//   ...
+//   PROF_END();
+//
+// BEGIN abre um bloco que END fecha: os dois no mesmo escopo, e um return
+// no meio pula a medida. Só no laço principal (a tabela não é protegida
+// contra ISRs).
+//
+// Relógio: o contador de uptime do timer0 (time_get_cycles), que toda
+// build tem. Com PROF_MCYCLE (CPU com os contadores do CsrPlugin, variantes
+// "full" do VexRiscv) usa mcycle/minstret, mais barato e com instruções.
+// PROF=0 (make PROF=0) apaga as macros; fora da placa elas também somem.
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+
+#ifndef PROF
+#define PROF 1
+#endif
+
+#define PROF_MAX_REGIONS 24
+
+typedef struct {
+    const char *name;
+    uint32_t count;
+    uint64_t total;        // Ciclos, já sem o custo da própria medida
+    uint32_t min;
+    uint32_t max;
+    uint64_t instret;      // Instruções (só com PROF_MCYCLE)
+} prof_region_t;
+
+#if PROF && defined(__riscv)
+
+#include "time_driver.h"
+
+static inline uint32_t prof_cycles(void) {
+#ifdef PROF_MCYCLE
+    uint32_t c;
+    __asm__ volatile ("csrr %0, mcycle" : "=r"(c));
+    return c;
+#else
+    return (uint32_t)time_get_cycles();
+#endif
+}
+
+static inline uint32_t prof_instret(void) {
+#ifdef PROF_MCYCLE
+    uint32_t c;
+    __asm__ volatile ("csrr %0, minstret" : "=r"(c));
+    return c;
+#else
+    return 0;
+#endif
+}
+
+/* A região de cada ponto de uso é achada (ou criada) pelo nome uma vez só */
+#define PROF_BEGIN(name)                                              \
+    do {                                                              \
+        static prof_region_t *prof_r_;                                \
+        uint32_t prof_i0_, prof_t0_;                                  \
+        if (!prof_r_) prof_r_ = prof_region(name);                    \
+        prof_i0_ = prof_instret();                                    \
+        prof_t0_ = prof_cycles();
+
+#define PROF_END()                                                    \
+        prof_add(prof_r_, prof_cycles() - prof_t0_,                   \
+                 prof_instret() - prof_i0_);                          \
+    } while (0)
+
+#else
+
+#define PROF_BEGIN(name)    do {
+#define PROF_END()          } while (0)
+
+#endif
+
+/* Mede o custo de um PROF_BEGIN/END vazio, descontado das regiões */
+void prof_init(void);
+void prof_reset(void);
+
+prof_region_t *prof_region(const char *name);   // NULL com a tabela cheia
+void prof_add(prof_region_t *r, uint32_t cycles, uint32_t instret);
+
+/* Relatório pela serial, do maior total para o menor */
+void prof_dump(void);
+
+#endif // PROF_H
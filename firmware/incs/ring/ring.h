@@ -0,0 +1,142 @@
+// ring.h
+// Buffer circular SPSC (um produtor, um consumidor) sem trava, só cabeçalho.
+//
+// Feito para ligar uma ISR ao laço principal (ou o contrário) sem desligar
+// interrupções: o produtor só escreve head, o consumidor só escreve tail, e
+// cada índice é publicado com release / lido com acquire. No VexRiscv
+// (rv32im, um núcleo) isso vira lw/sw com "fence" em volta; no PC, as
+// mesmas builtins dão a ordem certa entre threads.
+//
+// Uso:
+//   RING_DEFINE(uart_tx, uint8_t, 256)   // tipo uart_tx_t e funções uart_tx_*
+//   static uart_tx_t tx;
+//
+//   produtor:  uart_tx_push(&tx, &c);           ou, sem cópia:
+//              uint8_t *p = uart_tx_reserve(&tx); *p = c; uart_tx_commit(&tx);
+//   consumidor: uart_tx_pop(&tx, &c);           ou, sem cópia:
+//              const uint8_t *p = uart_tx_peek(&tx); usa(*p); uart_tx_release(&tx);
+//
+// head e tail correm livres em 32 bits; o índice é o contador & (N - 1),
+// por isso N precisa ser potência de 2. Cheio = head - tail == N.
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define RING_LOAD_ACQ(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_LOAD_RLX(p)     __atomic_load_n((p), __ATOMIC_RELAXED)
+#define RING_STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#define RING_IS_POW2(n)      ((n) >= 2 && ((n) & ((n) - 1)) == 0)
+
+#define RING_DEFINE(name, type, size)                                            \
+_Static_assert(RING_IS_POW2(size), #name ": capacidade deve ser potencia de 2"); \
+                                                                                 \
+typedef struct {                                                                 \
+    uint32_t head;              /* Escrito só pelo produtor */                   \
+    uint32_t tail;              /* Escrito só pelo consumidor */                 \
+    type buf[size];                                                              \
+} name##_t;                                                                      \
+                                                                                 \
+enum { name##_CAPACITY = (size) };                                               \
+                                                                                 \
+static inline void name##_init(name##_t *r) {                                    \
+    r->head = 0;                                                                 \
+    r->tail = 0;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Ocupação vista de qualquer lado (instantâneo) */                              \
+static inline uint32_t name##_count(const name##_t *r) {                         \
+    return RING_LOAD_ACQ(&r->head) - RING_LOAD_ACQ(&r->tail);                    \
+}                                                                                \
+                                                                                 \
+static inline uint32_t name##_space(const name##_t *r) {                         \
+    return (size) - name##_count(r);                                             \
+}                                                                                \
+                                                                                 \
+static inline bool name##_empty(const name##_t *r) {                             \
+    return name##_count(r) == 0;                                                 \
+}                                                                                \
+                                                                                 \
+/* ---- Produtor ---- */                                                        \
+                                                                                 \
+/* Slot livre para escrever no lugar, ou NULL se cheio */                        \
+static inline type *name##_reserve(name##_t *r) {                                \
+    uint32_t h = RING_LOAD_RLX(&r->head);                                        \
+    if (h - RING_LOAD_ACQ(&r->tail) >= (size)) return NULL;                      \
+    return &r->buf[h & ((size) - 1)];                                            \
+}                                                                                \
+                                                                                 \
+/* Publica o slot devolvido por reserve() */                                     \
+static inline void name##_commit(name##_t *r) {                                  \
+    RING_STORE_REL(&r->head, RING_LOAD_RLX(&r->head) + 1);                       \
+}                                                                                \
+                                                                                 \
+static inline bool name##_push(name##_t *r, const type *v) {                     \
+    type *slot = name##_reserve(r);                                              \
+    if (!slot) return false;                                                     \
+    *slot = *v;                                                                  \
+    name##_commit(r);                                                            \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Copia até n elementos (no máximo o espaço livre); retorna quantos */          \
+static inline uint32_t name##_push_n(name##_t *r, const type *v, uint32_t n) {   \
+    uint32_t h = RING_LOAD_RLX(&r->head);                                        \
+    uint32_t free_ = (size) - (h - RING_LOAD_ACQ(&r->tail));                     \
+    uint32_t i, first;                                                           \
+    if (n > free_) n = free_;                                                    \
+    i = h & ((size) - 1);                                                        \
+    first = (size) - i;                                                          \
+    if (first > n) first = n;                                                    \
+    memcpy(&r->buf[i], v, first * sizeof(type));                                 \
+    memcpy(&r->buf[0], v + first, (n - first) * sizeof(type));                   \
+    RING_STORE_REL(&r->head, h + n);                                             \
+    return n;                                                                    \
+}                                                                                \
+                                                                                 \
+/* ---- Consumidor ---- */                                                      \
+                                                                                 \
+/* Elemento mais antigo, lido no lugar, ou NULL se vazio */                      \
+static inline const type *name##_peek(name##_t *r) {                             \
+    uint32_t t = RING_LOAD_RLX(&r->tail);                                        \
+    if (RING_LOAD_ACQ(&r->head) == t) return NULL;                               \
+    return &r->buf[t & ((size) - 1)];                                            \
+}                                                                                \
+                                                                                 \
+/* Devolve o slot lido por peek() ao produtor */                                 \
+static inline void name##_release(name##_t *r) {                                 \
+    RING_STORE_REL(&r->tail, RING_LOAD_RLX(&r->tail) + 1);                       \
+}                                                                                \
+                                                                                 \
+static inline bool name##_pop(name##_t *r, type *v) {                            \
+    const type *slot = name##_peek(r);                                           \
+    if (!slot) return false;                                                     \
+    *v = *slot;                                                                  \
+    name##_release(r);                                                           \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+static inline uint32_t name##_pop_n(name##_t *r, type *v, uint32_t n) {          \
+    uint32_t t = RING_LOAD_RLX(&r->tail);                                        \
+    uint32_t avail = RING_LOAD_ACQ(&r->head) - t;                                \
+    uint32_t i, first;                                                           \
+    if (n > avail) n = avail;                                                    \
+    i = t & ((size) - 1);                                                        \
+    first = (size) - i;                                                          \
+    if (first > n) first = n;                                                    \
+    memcpy(v, &r->buf[i], first * sizeof(type));                                 \
+    memcpy(v + first, &r->buf[0], (n - first) * sizeof(type));                   \
+    RING_STORE_REL(&r->tail, t + n);                                             \
+    return n;                                                                    \
+}                                                                                \
+                                                                                 \
+/* Descarta tudo (lado consumidor) */                                            \
+static inline void name##_flush(name##_t *r) {                                   \
+    RING_STORE_REL(&r->tail, RING_LOAD_ACQ(&r->head));                           \
+}
+
+#endif // RING_H
@@ -0,0 +1,29 @@
+// sensor.h
+// Estados comuns das medições não bloqueantes (start / poll / fetch)
+
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Ciclo de uma medição:
+ *   xxx_start()  dispara a conversão e anota quando ela deve terminar;
+ *   xxx_poll()   nunca espera: antes do prazo só compara o tempo, depois
+ *                lê o bit de status do chip uma única vez;
+ *   xxx_fetch()  lê e converte o resultado quando poll() disse READY.
+ */
+typedef enum {
+    SENSOR_IDLE = 0,   // Nada em andamento
+    SENSOR_BUSY,       // Conversão em andamento
+    SENSOR_READY,      // Resultado disponível para fetch()
+    SENSOR_ERROR       // Falha de I2C ou timeout
+} sensor_status_t;
+
+/* Comparação de instantes em ms que sobrevive ao overflow de 32 bits */
+static inline bool sensor_time_reached(uint32_t now_ms, uint32_t deadline_ms) {
+    return (int32_t)(now_ms - deadline_ms) >= 0;
+}
+
+#endif // SENSOR_H
@@ -0,0 +1,93 @@
+// sensor_frame.c
+
+#include "sensor_frame.h"
+#include "time_driver.h"
+
+#include <string.h>
+
+static uint32_t frame_period_ms;
+static uint32_t frame_margin_ms;
+static uint32_t window_ms;
+static uint32_t next_ms;
+static uint32_t deadline_ms;
+static uint32_t trig_us;
+static uint32_t seq;
+static bool open;
+
+void sensor_frame_init(uint32_t period_ms, uint32_t margin_ms) {
+    frame_period_ms = period_ms;
+    frame_margin_ms = margin_ms;
+    next_ms = time_get_ms();
+    seq = 0;
+    open = false;
+}
+
+static void assemble(sensor_frame_t *f, bool timeout) {
+    uint32_t now_us = time_get_us();
+    uint32_t first = 0, last = 0;
+
+    f->seq = seq++;
+    f->trig_us = trig_us;
+    f->window_ms = window_ms;
+    f->t_us = now_us;
+    f->n = 0;
+    f->n_synced = 0;
+    f->timeout = timeout;
+
+    for (int i = 0; i < sensor_registry_count(); i++) {
+        const sensor_slot_t *s = sensor_registry_slot(i);
+        sensor_channel_t *c = &f->ch[f->n++];
+
+        c->name = s->drv->name;
+        c->t_us = s->res.t_us;
+        c->age_us = now_us - s->res.t_us;
+        c->count = s->res.count;
+        c->valid = s->res.valid;
+        memcpy(c->v, s->res.v, sizeof(c->v));
+
+        /* Só quem foi disparado nesta janela; streaming tem sempre leitura
+         * recente e mediria o laço, não o disparo. Diferença com sinal:
+         * sobrevive ao overflow do contador em us. */
+        c->synced = s->triggered && c->valid && (int32_t)(c->t_us - trig_us) >= 0;
+        if (!c->synced) continue;
+
+        if (f->n_synced == 0 || (int32_t)(c->t_us - first) < 0) first = c->t_us;
+        if (f->n_synced == 0 || (int32_t)(c->t_us - last) > 0) last = c->t_us;
+        f->n_synced++;
+    }
+
+    f->skew_us = last - first;
+}
+
+bool sensor_frame_poll(sensor_frame_t *out) {
+    uint32_t now = time_get_ms();
+
+    if (!open) {
+        uint32_t conv_ms;
+
+        if (!sensor_time_reached(now, next_ms)) return false;
+
+        next_ms = now + frame_period_ms;
+        trig_us = time_get_us();
+        sensor_registry_trigger(&conv_ms);
+        /* O prazo acompanha o auto-range (ex.: BH1750 H2 com MTreg alto) */
+        window_ms = conv_ms + frame_margin_ms;
+        if (window_ms > frame_period_ms) window_ms = frame_period_ms;
+        deadline_ms = now + window_ms;
+        open = true;
+        return false;
+    }
+
+    if (sensor_registry_pending() && !sensor_time_reached(now, deadline_ms))
+        return false;
+
+    open = false;
+    assemble(out, sensor_registry_pending());
+    return true;
+}
+
+const sensor_channel_t *sensor_frame_find(const sensor_frame_t *f, const char *name) {
+    for (int i = 0; i < f->n; i++)
+        if (strcmp(f->ch[i].name, name) == 0) return &f->ch[i];
+    return NULL;
+}
@@ -0,0 +1,50 @@
+// sensor_frame.h
+// Frame de amostras: a última leitura de cada sensor, com carimbo de tempo
+// e idade por canal, montado a partir de uma janela de disparo comum.
+
+#ifndef SENSOR_FRAME_H
+#define SENSOR_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sensor_registry.h"
+
+typedef struct {
+    const char *name;
+    uint32_t t_us;        // Instante da leitura (res.t_us)
+    uint32_t age_us;      // Idade no fechamento do frame
+    uint32_t count;       // res.count: detecta canal parado
+    int32_t  v[4];        // Mesmo significado de res.v[] no driver
+    bool     valid;
+    bool     synced;      // Disparado e convertido dentro da janela deste frame
+} sensor_channel_t;
+
+typedef struct {
+    uint32_t seq;
+    uint32_t trig_us;     // Abertura da janela (disparo)
+    uint32_t t_us;        // Fechamento
+    uint32_t skew_us;     // Maior distância entre leituras sincronizadas
+    uint32_t window_ms;   // Prazo usado nesta janela
+    uint8_t  n;
+    uint8_t  n_synced;
+    bool     timeout;     // Fechou pelo prazo com sensor ainda pendente
+    sensor_channel_t ch[SENSOR_MAX_SLOTS];
+} sensor_frame_t;
+
+/*
+ * A cada period_ms dispara todos os sensores com trigger na mesma passada
+ * (sensor_registry_trigger) e fecha o frame quando todos responderam ou
+ * quando o prazo vence: a maior conversion_ms() dos disparados mais
+ * margin_ms, limitado ao período. Sensores sem trigger (streaming, por
+ * evento) entram com o último valor e a idade dele, fora de synced/skew.
+ */
+void sensor_frame_init(uint32_t period_ms, uint32_t margin_ms);
+
+/* Chamar a cada volta do laço, depois de sensor_registry_run();
+ * retorna true quando *out recebeu um frame novo */
+bool sensor_frame_poll(sensor_frame_t *out);
+
+const sensor_channel_t *sensor_frame_find(const sensor_frame_t *f, const char *name);
+
+#endif // SENSOR_FRAME_H
@@ -0,0 +1,200 @@
+// sensor_registry.c
+
+#include "sensor_registry.h"
+#include "i2c_driver.h"
+#include "time_driver.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const sensor_driver_t *const *drv_table;
+static int drv_count;
+
+static sensor_slot_t slots[SENSOR_MAX_SLOTS];
+static int slot_count;
+static sensor_ready_fn on_ready;
+static sensor_log_fn on_log;
+
+/* ================= PROBE ================= */
+
+static bool probe_id(const sensor_driver_t *drv, uint8_t addr) {
+    uint8_t reg, id;
+
+    if (drv->id_reg == SENSOR_NO_ID) return true;   // Só o ACK do endereço
+
+    reg = (uint8_t)drv->id_reg;
+    if (!bb_i2c_write(addr, &reg, 1)) return false;
+    if (!bb_i2c_read(addr, &id, 1)) return false;
+
+    for (int i = 0; i < 2; i++)
+        if (drv->id_values[i] && drv->id_values[i] == id) return true;
+
+    return false;
+}
+
+static const sensor_driver_t *match(uint8_t addr) {
+    for (int d = 0; d < drv_count; d++) {
+        const sensor_driver_t *drv = drv_table[d];
+
+        if (drv->addrs[0] != addr && drv->addrs[1] != addr) continue;
+        if (probe_id(drv, addr)) return drv;
+    }
+    return NULL;
+}
+
+/* ================= API ================= */
+
+void sensor_registry_init(const sensor_driver_t *const *drivers, int n) {
+    drv_table = drivers;
+    drv_count = n;
+    slot_count = 0;
+    on_ready = NULL;
+    on_log = NULL;
+}
+
+void sensor_registry_on_ready(sensor_ready_fn fn) {
+    on_ready = fn;
+}
+
+void sensor_registry_on_log(sensor_log_fn fn) {
+    on_log = fn;
+}
+
+static void log_msg(const char *txt) {
+    if (on_log) on_log(txt);
+    else printf("%s\n", txt);
+}
+
+static bool contains(const uint8_t *v, int n, uint8_t addr) {
+    for (int i = 0; i < n; i++)
+        if (v[i] == addr) return true;
+    return false;
+}
+
+int sensor_registry_bind(const uint8_t *found, int n) {
+    char msg[48];
+    int changes = 0;
+
+    if (n < 0) n = 0;   // Scan falhou: remove todos
+
+    /* Remove os que sumiram (mantendo a ordem dos demais) */
+    for (int i = 0; i < slot_count; ) {
+        if (contains(found, n, slots[i].addr)) {
+            i++;
+            continue;
+        }
+        snprintf(msg, sizeof(msg), "Sensor removido: %02X (%s)", slots[i].addr, slots[i].drv->name);
+        log_msg(msg);
+        if (slots[i].drv->remove) slots[i].drv->remove(slots[i].drv->ctx);
+        memmove(&slots[i], &slots[i + 1], (slot_count - i - 1) * sizeof(slots[0]));
+        slot_count--;
+        changes++;
+    }
+
+    /* Liga os novos ao driver que responde pelo endereço e pelo ID */
+    for (int i = 0; i < n && slot_count < SENSOR_MAX_SLOTS; i++) {
+        const sensor_driver_t *drv;
+        bool bound = false;
+
+        for (int k = 0; k < slot_count; k++)
+            if (slots[k].addr == found[i]) bound = true;
+        if (bound) continue;
+
+        drv = match(found[i]);
+        if (!drv) continue;
+
+        snprintf(msg, sizeof(msg), "Novo dispositivo: %02X - %s", found[i], drv->name);
+        log_msg(msg);
+        if (drv->init && !drv->init(drv->ctx, found[i])) {
+            snprintf(msg, sizeof(msg), "Erro %s", drv->name);
+            log_msg(msg);
+            continue;
+        }
+
+        sensor_slot_t *s = &slots[slot_count++];
+        memset(s, 0, sizeof(*s));
+        s->drv = drv;
+        s->addr = found[i];
+        s->next_ms = time_get_ms();
+        s->status = SENSOR_IDLE;
+        for (int k = 0; k < 4; k++) stream_stats_init(&s->stats[k], SENSOR_EWMA_SHIFT);
+        changes++;
+    }
+
+    return changes;
+}
+
+void sensor_registry_run(void) {
+    uint32_t now = time_get_ms();
+
+    for (int i = 0; i < slot_count; i++) {
+        sensor_slot_t *s = &slots[i];
+
+        if (!s->drv->sample || !sensor_time_reached(now, s->next_ms)) continue;
+        if (s->drv->trigger && !s->armed) continue;   // Espera a janela do frame
+
+        s->next_ms = now + s->drv->period_ms;
+        s->status = s->drv->sample(s->drv->ctx, &s->res);
+        if (s->status != SENSOR_BUSY) s->armed = false;
+        if (s->status == SENSOR_READY) {
+            s->res.t_us = time_get_us();
+            s->res.t_ms = now;
+            s->res.count++;
+            s->res.valid = true;
+            for (int k = 0; k < 4; k++) stream_stats_add(&s->stats[k], s->res.v[k]);
+            if (!s->drv->report || report_check(s->drv->report, &s->report, s->res.v, now))
+                s->fresh = true;
+            if (on_ready) on_ready(s);
+        }
+    }
+}
+
+int sensor_registry_trigger(uint32_t *conv_ms) {
+    uint32_t now = time_get_ms();
+    uint32_t conv = 0;
+    int n = 0;
+
+    for (int i = 0; i < slot_count; i++) {
+        sensor_slot_t *s = &slots[i];
+
+        s->triggered = false;
+        if (!s->drv->trigger) continue;
+
+        /* Antes do disparo: é a configuração que esta conversão vai usar */
+        uint32_t ms = s->drv->conversion_ms ? s->drv->conversion_ms(s->drv->ctx) : 0;
+
+        /* Disparo que falhou fica de fora; o canal só envelhece */
+        s->armed = s->drv->trigger(s->drv->ctx);
+        if (!s->armed) continue;
+        s->triggered = true;
+        s->next_ms = now + s->drv->period_ms;
+        if (ms > conv) conv = ms;
+        n++;
+    }
+    if (conv_ms) *conv_ms = conv;
+    return n;
+}
+
+void sensor_registry_republish(void) {
+    for (int i = 0; i < slot_count; i++) report_reset(&slots[i].report);
+}
+
+bool sensor_registry_pending(void) {
+    for (int i = 0; i < slot_count; i++)
+        if (slots[i].armed) return true;
+    return false;
+}
+
+int sensor_registry_count(void) {
+    return slot_count;
+}
+
+sensor_slot_t *sensor_registry_slot(int i) {
+    return (i >= 0 && i < slot_count) ? &slots[i] : NULL;
+}
+
+sensor_slot_t *sensor_registry_find(const char *name) {
+    for (int i = 0; i < slot_count; i++)
+        if (strcmp(slots[i].drv->name, name) == 0) return &slots[i];
+    return NULL;
+}
@@ -0,0 +1,111 @@
+// sensor_registry.h
+// Registro de drivers de sensores I2C: o scan liga cada endereço encontrado
+// ao driver que o reconhece, e o laço principal trata todos do mesmo jeito.
+
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sensor.h"
+#include "stream_stats.h"
+#include "report.h"
+
+#define SENSOR_MAX_SLOTS  8
+#define SENSOR_NO_ID      (-1)
+#define SENSOR_EWMA_SHIFT 3       // alfa = 1/8 nas estatísticas por canal
+
+/* Último resultado de um sensor; o significado de v[] é do driver */
+typedef struct {
+    uint32_t t_ms;        // Instante da leitura (time_get_ms)
+    uint32_t t_us;        // O mesmo, do contador de ciclos (time_get_us)
+    uint32_t count;       // Leituras completas desde o bind
+    int32_t  v[4];
+    bool     valid;
+} sensor_result_t;
+
+typedef struct sensor_slot sensor_slot_t;
+
+/* Descritor de um driver: adicionar um sensor = adicionar um descritor */
+typedef struct {
+    const char *name;
+    uint8_t  addrs[2];        // Endereços possíveis (0 = não usado)
+    int16_t  id_reg;          // Byte escrito antes de ler o ID, ou SENSOR_NO_ID
+    uint8_t  id_values[2];    // IDs aceitos (0 = não usado)
+    uint16_t period_ms;       // Intervalo entre chamadas de sample()
+                              // (com trigger: intervalo de poll na janela)
+    void    *ctx;             // Contexto do driver
+
+    bool            (*init)(void *ctx, uint8_t addr);
+    /*
+     * Dispara uma conversão (opcional). Sensores com trigger não andam
+     * sozinhos: convertem juntos quando sensor_registry_trigger() abre a
+     * janela do frame, e sample() só faz poll/fetch até o READY.
+     */
+    bool            (*trigger)(void *ctx);
+    /* Duração da conversão que trigger() dispara agora, em ms (opcional);
+     * muda com o auto-range e define o prazo da janela do frame */
+    uint32_t        (*conversion_ms)(void *ctx);
+    /* Um passo não bloqueante; READY quando res foi atualizado */
+    sensor_status_t (*sample)(void *ctx, sensor_result_t *res);
+    /* Texto de uma linha para a serial (opcional) */
+    void            (*format)(const sensor_slot_t *slot, char *buf, int len);
+    /* Desenha a linha na tabela a partir de y; retorna o y seguinte (opcional) */
+    int             (*render)(const sensor_slot_t *slot, int y);
+    /* Sensor sumiu do barramento (opcional) */
+    void            (*remove)(void *ctx);
+    /*
+     * Publicação por exceção (opcional): só leituras que passam no filtro
+     * marcam fresh (tela, serial, telemetria). NULL = toda leitura publica.
+     * Estatísticas e o hook de READY veem todas as leituras.
+     */
+    const report_cfg_t *report;
+} sensor_driver_t;
+
+struct sensor_slot {
+    const sensor_driver_t *drv;
+    uint8_t addr;
+    uint32_t next_ms;
+    sensor_status_t status;   // Último retorno de sample()
+    bool fresh;               // Resultado publicado desde o último render
+    bool armed;               // Disparado, esperando o READY desta janela
+    bool triggered;           // Entrou no último disparo do frame
+    sensor_result_t res;
+    stream_stats_t stats[4];  // Por valor de res.v[], desde o bind
+    report_state_t report;
+};
+
+void sensor_registry_init(const sensor_driver_t *const *drivers, int n);
+
+/* Chamado a cada READY, com res já carimbado (ex.: gravar em séries); NULL desliga */
+typedef void (*sensor_ready_fn)(const sensor_slot_t *slot);
+void sensor_registry_on_ready(sensor_ready_fn fn);
+
+/* Mensagens do bind (sensor novo, removido, erro de init); NULL = printf.
+ * Com a telemetria binária o texto cru quebraria o fluxo COBS: o app passa
+ * o próprio log, que sabe o modo. */
+typedef void (*sensor_log_fn)(const char *txt);
+void sensor_registry_on_log(sensor_log_fn fn);
+
+/* Liga/desliga endereços conforme o scan; retorna quantos slots mudaram */
+int  sensor_registry_bind(const uint8_t *found, int n);
+
+/* Chama sample() de cada sensor cujo período venceu */
+void sensor_registry_run(void);
+
+/* Dispara todos os sensores com trigger na mesma passada; retorna quantos.
+ * Em *conv_ms (se não NULL) vai a maior conversion_ms() dos disparados. */
+int  sensor_registry_trigger(uint32_t *conv_ms);
+
+/* Próxima leitura de cada sensor publica (ex.: tela redesenhada) */
+void sensor_registry_republish(void);
+
+/* Algum sensor disparado ainda sem resultado */
+bool sensor_registry_pending(void);
+
+int  sensor_registry_count(void);
+sensor_slot_t *sensor_registry_slot(int i);
+sensor_slot_t *sensor_registry_find(const char *name);
+
+#endif // SENSOR_REGISTRY_H
@@ -0,0 +1,45 @@
+// report.c
+
+#include "report.h"
+
+#include <string.h>
+
+void report_reset(report_state_t *st) {
+    st->has = false;
+}
+
+static bool outside_band(const report_cfg_t *cfg, const report_state_t *st, const int32_t *v) {
+    for (int i = 0; i < cfg->nv && i < REPORT_MAX_VALUES; i++) {
+        int64_t d = (int64_t)v[i] - st->last[i];
+
+        if (d < 0) d = -d;
+        if (d > cfg->deadband[i]) return true;
+    }
+    return false;
+}
+
+bool report_check(const report_cfg_t *cfg, report_state_t *st,
+                  const int32_t *v, uint32_t now_ms) {
+    uint32_t elapsed = now_ms - st->last_ms;
+    bool pub;
+
+    if (!st->has) {
+        pub = true;
+    } else if (elapsed < cfg->min_interval_ms) {
+        pub = false;
+    } else {
+        pub = outside_band(cfg, st, v) ||
+              (cfg->max_silence_ms && elapsed >= cfg->max_silence_ms);
+    }
+
+    if (!pub) {
+        st->suppressed++;
+        return false;
+    }
+
+    memcpy(st->last, v, sizeof(st->last));
+    st->last_ms = now_ms;
+    st->has = true;
+    st->published++;
+    return true;
+}
@@ -0,0 +1,36 @@
+// report.h
+// Publicação por exceção: decide quando uma leitura nova vale ir para a
+// tela, a serial ou a telemetria. Publica quando algum valor sai da banda
+// morta em torno do último publicado, nunca antes de min_interval_ms e
+// sempre depois de max_silence_ms (sinal de vida).
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define REPORT_MAX_VALUES 4
+
+typedef struct {
+    uint8_t  nv;                           // Quantos valores de v[] comparar
+    int32_t  deadband[REPORT_MAX_VALUES];  // Variação que publica (0 = qualquer mudança)
+    uint32_t min_interval_ms;              // Intervalo mínimo entre publicações
+    uint32_t max_silence_ms;               // Publica mesmo parado (0 = nunca)
+} report_cfg_t;
+
+typedef struct {
+    int32_t  last[REPORT_MAX_VALUES];      // Últimos valores publicados
+    uint32_t last_ms;
+    bool     has;                          // Já publicou desde o reset
+    uint32_t published;
+    uint32_t suppressed;
+} report_state_t;
+
+void report_reset(report_state_t *st);
+
+/* true = publicar v (e o estado passa a compará-lo daqui em diante) */
+bool report_check(const report_cfg_t *cfg, report_state_t *st,
+                  const int32_t *v, uint32_t now_ms);
+
+#endif // REPORT_H
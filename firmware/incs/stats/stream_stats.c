@@ -0,0 +1,84 @@
+// stream_stats.c
+
+#include "stream_stats.h"
+
+#include <string.h>
+
+void stream_stats_init(stream_stats_t *s, uint8_t ewma_shift) {
+    memset(s, 0, sizeof(*s));
+    s->ewma_shift = ewma_shift;
+}
+
+void stream_stats_reset(stream_stats_t *s) {
+    stream_stats_init(s, s->ewma_shift);
+}
+
+/* Média em Q8 arredondada, a partir da soma exata */
+static int64_t mean_q8(const stream_stats_t *s) {
+    int64_t n = s->n, q, r;
+
+    if (n == 0) return 0;
+    q = s->sum / n;
+    r = s->sum % n;   // Mesmo sinal da soma
+    return q * 256 + (r * 256 + (r >= 0 ? n / 2 : -n / 2)) / n;
+}
+
+static int32_t round_q8(int64_t v) {
+    return (int32_t)((v >= 0 ? v + 128 : v - 128) / 256);
+}
+
+void stream_stats_add(stream_stats_t *s, int32_t x) {
+    int64_t x8 = (int64_t)x * 256;
+    int64_t d_old, t;
+
+    if (s->n == 0) {
+        s->min = s->max = x;
+        s->ewma_q8 = x8;
+    } else {
+        if (x < s->min) s->min = x;
+        if (x > s->max) s->max = x;
+        s->ewma_q8 += (x8 - s->ewma_q8) / (1 << s->ewma_shift);
+    }
+
+    /* Welford: M2 += (x - média antiga) * (x - média nova), em Q16; a parte
+     * inteira vai para m2 e a fração fica em m2_frac para o próximo passo */
+    d_old = x8 - mean_q8(s);
+    s->n++;
+    s->sum += x;
+    t = d_old * (x8 - mean_q8(s)) + s->m2_frac;
+    s->m2 += t >> 16;
+    s->m2_frac = (uint16_t)(t & 0xFFFF);
+}
+
+int32_t stream_stats_mean(const stream_stats_t *s) {
+    return round_q8(mean_q8(s));
+}
+
+int32_t stream_stats_ewma(const stream_stats_t *s) {
+    return round_q8(s->ewma_q8);
+}
+
+uint32_t stream_stats_variance(const stream_stats_t *s) {
+    int64_t v;
+
+    if (s->n < 2 || s->m2 <= 0) return 0;
+    v = (s->m2 + (s->n - 1) / 2) / (int64_t)(s->n - 1);
+    return v > UINT32_MAX ? UINT32_MAX : (uint32_t)v;   // Ex.: IR cru, dedo entra/sai
+}
+
+/* Raiz inteira bit a bit: sem float nem libm */
+uint32_t stream_stats_stddev(const stream_stats_t *s) {
+    uint32_t v = stream_stats_variance(s), r = 0, bit = 1u << 30;
+
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
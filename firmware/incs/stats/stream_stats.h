@@ -0,0 +1,38 @@
+// stream_stats.h
+// Estatística por canal em ponto fixo, uma amostra por vez: média e
+// variância (Welford), mínimo, máximo e média móvel exponencial (EWMA).
+
+#ifndef STREAM_STATS_H
+#define STREAM_STATS_H
+
+#include <stdint.h>
+
+/*
+ * A média sai da soma exata (sem o truncamento de "média += d / n", que
+ * congela a média quando n cresce). M2 em unidades², com o resto Q16 de
+ * cada passo do Welford carregado em m2_frac em vez de descartado. EWMA em
+ * Q8 (1/256 da unidade do canal). Com valores até +-2^23 (lux * 100, PPG
+ * de 18 bits, °C * 100...) a soma e o produto do Welford cabem em 64 bits.
+ */
+typedef struct {
+    uint32_t n;
+    int32_t  min;
+    int32_t  max;
+    int64_t  sum;
+    int64_t  m2;
+    uint16_t m2_frac;        // Q16
+    int64_t  ewma_q8;
+    uint8_t  ewma_shift;     // alfa = 1 / 2^shift
+} stream_stats_t;
+
+void stream_stats_init(stream_stats_t *s, uint8_t ewma_shift);
+void stream_stats_reset(stream_stats_t *s);
+void stream_stats_add(stream_stats_t *s, int32_t x);
+
+/* Arredondados para a unidade do canal */
+int32_t  stream_stats_mean(const stream_stats_t *s);
+int32_t  stream_stats_ewma(const stream_stats_t *s);
+uint32_t stream_stats_variance(const stream_stats_t *s);   // Amostral (n - 1), satura em UINT32_MAX
+uint32_t stream_stats_stddev(const stream_stats_t *s);     // Satura em 65535 junto
+
+#endif // STREAM_STATS_H
@@ -0,0 +1,201 @@
+// telemetry.c
+
+#include "telemetry.h"
+#include "time_driver.h"
+
+#include <string.h>
+#include <crc.h>
+
+#include "uart_log.h"
+
+static telemetry_mode_t mode;
+static telemetry_sink_t sink;
+static bool held;
+static uint8_t seq;
+static uint32_t bytes_out;
+
+/* Lote de PPG em montagem */
+static max3010x_sample_t ppg_buf[TELEMETRY_PPG_BATCH];
+static int ppg_n;
+static uint32_t ppg_t_us;
+static uint16_t ppg_fs;
+
+/* ================= ENQUADRAMENTO ================= */
+
+/* Quadro montado inteiro antes de ir para a UART: sob pressão o buffer do
+ * console descarta o quadro todo, nunca metade (o PC vê o salto no seq) */
+static uint8_t frame[TELEMETRY_MAX_RECORD + 2 + 8];
+static int frame_len;
+
+static void put(uint8_t b) {
+    frame[frame_len++] = b;
+}
+
+/*
+ * COBS: cada bloco é "código + até 254 bytes não nulos", com o código =
+ * tamanho do bloco + 1. Os dados já estão num buffer, então basta procurar
+ * o próximo zero e copiar o trecho.
+ */
+static bool cobs_send(const uint8_t *p, int len, bool retry) {
+    int i = 0;
+
+    frame_len = 0;
+    put(0x00);
+    while (i <= len) {
+        int run = 0;
+
+        while (i + run < len && p[i + run] != 0 && run < 254) run++;
+        put((uint8_t)(run + 1));
+        for (int k = 0; k < run; k++) put(p[i + k]);
+
+        i += run;
+        if (run == 254 && i < len) continue;   // Bloco cheio: não consome zero
+        i++;                                   // Pula o zero (ou o fim)
+    }
+    put(0x00);
+
+    if (!(retry ? uart_log_try_write(frame, frame_len) : uart_log_write(frame, frame_len)))
+        return false;
+    bytes_out += frame_len;
+    return true;
+}
+
+static uint8_t rec[TELEMETRY_MAX_RECORD + 2];
+static int rec_len;
+
+static void rec_begin(uint8_t type, uint32_t t_us) {
+    rec[0] = type;
+    rec[1] = seq++;
+    memcpy(&rec[2], &t_us, 4);   // VexRiscv e PC são little-endian
+    rec_len = 6;
+}
+
+static void rec_put(const void *p, int n) {
+    if (rec_len + n > TELEMETRY_MAX_RECORD) n = TELEMETRY_MAX_RECORD - rec_len;
+    memcpy(&rec[rec_len], p, n);
+    rec_len += n;
+}
+
+static void rec_u8(uint8_t v) {
+    rec_put(&v, 1);
+}
+
+static void rec_u24(uint32_t v) {
+    rec_put(&v, 3);
+}
+
+/* retry: o registro fica com quem chama e volta depois (não conta descarte) */
+static bool send(const uint8_t *r, int len, bool retry) {
+    uint16_t crc = crc16(r, len);
+
+    if (r != rec) memcpy(rec, r, len);
+    memcpy(&rec[len], &crc, 2);
+    return cobs_send(rec, len + 2, retry);
+}
+
+static void rec_end(void) {
+    if (sink) sink(rec, rec_len);
+    if (mode == TELEMETRY_BINARY) send(rec, rec_len, false);
+}
+
+/* Há alguém consumindo registros: a UART em modo binário ou o sink */
+static bool active(void) {
+    return !held && (mode == TELEMETRY_BINARY || sink);
+}
+
+/* ================= API ================= */
+
+void telemetry_init(void) {
+    mode = TELEMETRY_TEXT;
+    sink = NULL;
+    held = false;
+    seq = 0;
+    bytes_out = 0;
+    ppg_n = 0;
+}
+
+void telemetry_set_mode(telemetry_mode_t m) {
+    telemetry_ppg_flush();   // O lote aberto sai no destino antigo
+    mode = m;
+}
+
+void telemetry_set_sink(telemetry_sink_t fn) {
+    telemetry_ppg_flush();
+    sink = fn;
+}
+
+void telemetry_hold(bool on) {
+    if (on) telemetry_ppg_flush();
+    held = on;
+}
+
+bool telemetry_send_raw(const uint8_t *r, int len) {
+    if (len <= 0 || len > TELEMETRY_MAX_RECORD) return true;   // Inválido: descarta
+    return send(r, len, true);
+}
+
+telemetry_mode_t telemetry_mode(void) {
+    return mode;
+}
+
+bool telemetry_binary(void) {
+    return mode == TELEMETRY_BINARY;
+}
+
+void telemetry_ppg_flush(void) {
+    if (ppg_n == 0 || !active()) {
+        ppg_n = 0;
+        return;
+    }
+
+    rec_begin(TELEMETRY_REC_PPG, ppg_t_us);
+    rec_put(&ppg_fs, 2);
+    rec_u8((uint8_t)ppg_n);
+    for (int i = 0; i < ppg_n; i++) {
+        rec_u24(ppg_buf[i].red);
+        rec_u24(ppg_buf[i].ir);
+    }
+    rec_end();
+    ppg_n = 0;
+}
+
+void telemetry_ppg(uint32_t t_us, uint16_t fs, const max3010x_sample_t *s, int n) {
+    if (!active() || fs == 0) return;
+
+    if (ppg_n > 0 && fs != ppg_fs) telemetry_ppg_flush();
+
+    for (int i = 0; i < n; i++) {
+        if (ppg_n == 0) {
+            ppg_t_us = t_us + (uint32_t)i * 1000000u / fs;   // i < 25: cabe em 32 bits
+            ppg_fs = fs;
+        }
+        ppg_buf[ppg_n++] = s[i];
+        if (ppg_n == TELEMETRY_PPG_BATCH) telemetry_ppg_flush();
+    }
+}
+
+void telemetry_sensor(const char *name, const sensor_result_t *res) {
+    uint8_t len = (uint8_t)strlen(name);
+
+    if (!active()) return;
+
+    rec_begin(TELEMETRY_REC_SENSOR, res->t_us);
+    rec_put(&res->count, 4);
+    rec_u8(4);
+    rec_put(res->v, sizeof(res->v));
+    rec_u8(len);
+    rec_put(name, len);
+    rec_end();
+}
+
+void telemetry_log(const char *text) {
+    if (!active()) return;
+
+    rec_begin(TELEMETRY_REC_LOG, time_get_us());
+    rec_put(text, (int)strlen(text));
+    rec_end();
+}
+
+uint32_t telemetry_bytes(void) {
+    return bytes_out;
+}
@@ -0,0 +1,80 @@
+// telemetry.h
+// Telemetria binária pela UART: registros tipados, com CRC16 (crc16 da
+// libbase) e enquadramento COBS. Substitui o printf das leituras quando o
+// modo binário está ligado; o decodificador do PC é tools/telemetry_decode.py.
+//
+// Quadro na linha:
+//   0x00 | COBS( tipo u8 | seq u8 | t_us u32 | corpo | crc16 u16 ) | 0x00
+//
+// Tudo little-endian. O CRC (CCITT/XMODEM, o crc16 da libbase) cobre do
+// tipo ao fim do corpo. O 0x00 no início isola o quadro de qualquer texto
+// que tenha saído antes dele; quadros vazios são ignorados no PC.
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "max3010x.h"
+#include "sensor_registry.h"
+
+typedef enum {
+    TELEMETRY_TEXT = 0,     // printf legível (padrão)
+    TELEMETRY_BINARY        // Quadros COBS
+} telemetry_mode_t;
+
+/* Tipos de registro */
+#define TELEMETRY_REC_PPG     0x01   // Lote de amostras RED/IR cruas
+#define TELEMETRY_REC_SENSOR  0x02   // Resultado de um slot do registro
+#define TELEMETRY_REC_LOG     0x03   // Linha de texto
+
+/*
+ * PPG: fs u16 | n u8 | n x (red u24, ir u24); t_us é o instante da primeira
+ * amostra e as demais seguem espaçadas de 1/fs. 18 bits de ADC cabem em 3
+ * bytes: 6 bytes por amostra contra ~25 do "IR:%lu RED:%lu\n".
+ */
+#define TELEMETRY_PPG_BATCH   25     // Amostras por registro (250 ms a 100 Hz)
+
+/* SENSOR: count u32 | nv u8 | nv x int32 | nome (len u8 + bytes) */
+
+#define TELEMETRY_MAX_RECORD  200    // Maior registro antes do COBS
+
+/*
+ * Destino extra dos registros (ex.: flashlog_append), chamado com o
+ * registro cru (sem CRC nem COBS) em qualquer modo; NULL desliga.
+ */
+typedef bool (*telemetry_sink_t)(const void *rec, int len);
+
+void telemetry_init(void);
+void telemetry_set_sink(telemetry_sink_t fn);
+void telemetry_set_mode(telemetry_mode_t mode);
+telemetry_mode_t telemetry_mode(void);
+bool telemetry_binary(void);
+
+/*
+ * Acumula amostras do PPG e emite um registro a cada TELEMETRY_PPG_BATCH.
+ * t_us é o instante de s[0] e só vale para abrir um lote: dentro dele o
+ * tempo segue de 1/fs. Depois de uma perda (overflow da FIFO, buffer da
+ * IRQ cheio) chamar telemetry_ppg_flush() para o próximo lote reancorar.
+ */
+void telemetry_ppg(uint32_t t_us, uint16_t fs, const max3010x_sample_t *s, int n);
+void telemetry_ppg_flush(void);
+
+void telemetry_sensor(const char *name, const sensor_result_t *res);
+void telemetry_log(const char *text);
+
+/*
+ * Segura os registros ao vivo (PPG, SENSOR, LOG): descartados enquanto on,
+ * o lote de PPG aberto sai antes. Para o export do flashlog, cujos
+ * registros antigos o PC não teria como separar dos novos.
+ */
+void telemetry_hold(bool on);
+
+/* Enquadra e envia um registro cru já pronto (replay do flashlog; passa
+ * mesmo com telemetry_hold); false se o console não tem espaço agora */
+bool telemetry_send_raw(const uint8_t *rec, int len);
+
+uint32_t telemetry_bytes(void);    // Bytes aceitos pelo console desde o init
+
+#endif // TELEMETRY_H
@@ -2,7 +2,63 @@
 
 #include <generated/csr.h>
 #include "time_driver.h"
+#include "fastmem.h"
 #include <system.h> // busy_wait_us
+#include <irq.h>
+
+/* Todo prazo do firmware (drivers, registro, frames, flashlog) sai daqui:
+ * sem o uptime o relógio pararia em 0 e nenhum deles venceria */
+#ifndef CSR_TIMER0_UPTIME_CYCLES_ADDR
+#error "timer0 uptime necessário: gere o SoC com timer_uptime=True"
+#endif
+
+FAST_CODE uint64_t time_get_cycles(void) {
+    // latch + leitura em duas palavras: uma ISR no meio rasgaria o valor
+    unsigned int ie = irq_getie();
+    irq_setie(0);
+    timer0_uptime_latch_write(1);
+    uint64_t c = timer0_uptime_cycles_read();
+    irq_setie(ie);
+    return c;
+}
+
+/*
+ * Os 32 bits de baixo de c / k sem dividir 64 bits (no rv32im isso é o
+ * __udivdi3 da libgcc). A parte alta do quociente (hi / k) só mexe acima
+ * do bit 32, então basta o resto hi % k; o resto do dividendo vai de byte
+ * em byte, com (r << 8) | byte < 2^32 enquanto k <= 2^24. Com k constante
+ * cada divisão vira multiplicação pelo recíproco.
+ */
+static inline uint32_t cycles_div(uint64_t c, uint32_t k) {
+    uint32_t lo = (uint32_t)c;
+    uint32_t r = (uint32_t)(c >> 32) % k;
+    uint32_t q = 0;
+
+    for (int sh = 24; sh >= 0; sh -= 8) {
+        uint32_t cur = (r << 8) | ((lo >> sh) & 0xFF);
+        q = (q << 8) | (cur / k);
+        r = cur % k;
+    }
+    return q;
+}
+
+_Static_assert(CONFIG_CLOCK_FREQUENCY / 1000 <= (1u << 24), "cycles_div: divisor acima de 2^24");
+
+uint32_t time_cycles_to_us(uint64_t cycles) {
+    return cycles_div(cycles, CONFIG_CLOCK_FREQUENCY / 1000000);
+}
+
+uint32_t time_cycles_to_ms(uint64_t cycles) {
+    return cycles_div(cycles, CONFIG_CLOCK_FREQUENCY / 1000);
+}
+
+uint32_t time_get_us(void) {
+    return time_cycles_to_us(time_get_cycles());
+}
+
+uint32_t time_get_ms(void) {
+    return time_cycles_to_ms(time_get_cycles());
+}
 
 void delay_ms(uint32_t ms) {
     for (uint32_t i = 0; i < ms; i++) {
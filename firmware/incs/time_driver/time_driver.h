@@ -14,6 +14,27 @@
  */
 uint32_t time_get_ms(void);
 
+/**
+ * Contador de ciclos de clock do sistema desde o reset (64 bits).
+ * Lido do uptime do TIMER0: o SoC precisa ser gerado com
+ * timer_uptime=True (sem ele, time_driver.c não compila).
+ * @return Ciclos de CONFIG_CLOCK_FREQUENCY.
+ */
+uint64_t time_get_cycles(void);
+
+/**
+ * Tempo atual do sistema em microssegundos (a partir de time_get_cycles).
+ */
+uint32_t time_get_us(void);
+
+/**
+ * Ciclos (time_get_cycles) em us / ms, com a mesma volta em 32 bits de
+ * time_get_us/time_get_ms. Sem divisão de 64 bits: use estas em vez de
+ * dividir um carimbo de ciclos por CONFIG_CLOCK_FREQUENCY.
+ */
+uint32_t time_cycles_to_us(uint64_t cycles);
+uint32_t time_cycles_to_ms(uint64_t cycles);
+
 /**
  * Causa um atraso de tempo (busy-waiting).
  * Baseado em loops de NOP ou no registrador TIMER0.
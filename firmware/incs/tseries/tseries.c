@@ -0,0 +1,269 @@
+// tseries.c
+
+#include "tseries.h"
+
+#include <stddef.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t cap;
+    uint32_t next;        // Próxima posição a escrever
+    uint32_t count;
+} ring_idx_t;
+
+/* Balde aberto: soma em 64 bits (PPG cru a 100 Hz estoura 32 em 1 min) */
+typedef struct {
+    uint32_t t_ms;
+    int32_t  min;
+    int32_t  max;
+    int64_t  sum;
+    uint32_t n;
+} bucket_t;
+
+typedef struct {
+    const char *name;
+    ring_idx_t raw_idx;
+    tseries_sample_t *raw;
+    ring_idx_t agg_idx[TSERIES_TIERS];
+    tseries_agg_t *agg[TSERIES_TIERS];
+    bucket_t open[TSERIES_TIERS];
+} channel_t;
+
+static const uint32_t tier_ms[TSERIES_TIERS] = TSERIES_TIER_MS;
+static const uint32_t tier_cap[TSERIES_TIERS] = TSERIES_TIER_CAP;
+
+static uint8_t arena[TSERIES_ARENA_BYTES] __attribute__((aligned(8)));
+static channel_t channels[TSERIES_MAX_CHANNELS];
+static tseries_stats_t st;
+
+/* ================= ARENA / ANEL ================= */
+
+static void *arena_alloc(uint32_t bytes) {
+    void *p;
+
+    bytes = (bytes + 7u) & ~7u;
+    if (bytes > TSERIES_ARENA_BYTES - st.arena_used) return NULL;
+    p = &arena[st.arena_used];
+    st.arena_used += bytes;
+    return p;
+}
+
+/* Reserva a próxima posição do anel (sobrescreve a mais antiga se cheio) */
+static uint32_t ring_push(ring_idx_t *r) {
+    uint32_t pos = r->next;
+
+    r->next = (r->next + 1 == r->cap) ? 0 : r->next + 1;
+    if (r->count < r->cap) r->count++;
+    return pos;
+}
+
+/* Posição física do i-ésimo elemento, contando do mais antigo */
+static uint32_t ring_pos(const ring_idx_t *r, uint32_t i) {
+    uint32_t pos = r->next + r->cap - r->count + i;
+    return pos >= r->cap ? pos - r->cap : pos;
+}
+
+static bool before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/*
+ * Faixa [t0, t1] num anel de elementos que começam por um t_ms crescente
+ * (tseries_sample_t e tseries_agg_t): duas buscas binárias e a conversão
+ * para até dois trechos físicos.
+ */
+static void span_find(const void *base, size_t size, const ring_idx_t *r,
+                      uint32_t t0, uint32_t t1, const void **p, uint32_t *n) {
+    const uint8_t *b = base;
+    uint32_t lo = 0, hi = r->count, first, end, pos, len;
+
+#define T_AT(i) (*(const uint32_t *)(b + (size_t)ring_pos(r, (i)) * size))
+
+    while (lo < hi) {                        // Primeiro com t >= t0
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (before(T_AT(mid), t0)) lo = mid + 1;
+        else hi = mid;
+    }
+    first = lo;
+
+    hi = r->count;
+    while (lo < hi) {                        // Primeiro com t > t1
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (before(t1, T_AT(mid))) hi = mid;
+        else lo = mid + 1;
+    }
+    end = lo;
+
+#undef T_AT
+
+    p[0] = p[1] = base;
+    n[0] = n[1] = 0;
+    if (end <= first) return;
+
+    pos = ring_pos(r, first);
+    len = end - first;
+    p[0] = b + (size_t)pos * size;
+    n[0] = (len < r->cap - pos) ? len : r->cap - pos;
+    n[1] = len - n[0];
+}
+
+/* ================= AGREGADOS ================= */
+
+static void bucket_start(bucket_t *bk, uint32_t t_ms, uint32_t period) {
+    bk->t_ms = t_ms - t_ms % period;
+    bk->min = INT32_MAX;
+    bk->max = INT32_MIN;
+    bk->sum = 0;
+    bk->n = 0;
+}
+
+static void tier_feed(channel_t *c, int tier, uint32_t t_ms,
+                      int32_t min, int32_t max, int64_t sum, uint32_t n);
+
+/* Fecha o balde do nível: vai para o anel e sobe para o nível seguinte */
+static void tier_close(channel_t *c, int tier) {
+    bucket_t *bk = &c->open[tier];
+    tseries_agg_t *a;
+
+    if (bk->n == 0) return;
+
+    a = &c->agg[tier][ring_push(&c->agg_idx[tier])];
+    a->t_ms = bk->t_ms;
+    a->min = bk->min;
+    a->max = bk->max;
+    a->mean = (int32_t)(bk->sum / (int64_t)bk->n);
+    a->n = bk->n;
+
+    if (tier + 1 < TSERIES_TIERS)
+        tier_feed(c, tier + 1, bk->t_ms, bk->min, bk->max, bk->sum, bk->n);
+    bk->n = 0;
+}
+
+static void tier_feed(channel_t *c, int tier, uint32_t t_ms,
+                      int32_t min, int32_t max, int64_t sum, uint32_t n) {
+    bucket_t *bk = &c->open[tier];
+
+    if (bk->n > 0 && t_ms - bk->t_ms >= tier_ms[tier]) tier_close(c, tier);
+    if (bk->n == 0) bucket_start(bk, t_ms, tier_ms[tier]);
+
+    if (min < bk->min) bk->min = min;
+    if (max > bk->max) bk->max = max;
+    bk->sum += sum;
+    bk->n += n;
+}
+
+/* ================= API ================= */
+
+void tseries_init(void) {
+    memset(channels, 0, sizeof(channels));
+    memset(&st, 0, sizeof(st));
+}
+
+int tseries_find(const char *name) {
+    for (int i = 0; i < st.channels; i++)
+        if (strcmp(channels[i].name, name) == 0) return i;
+    return -1;
+}
+
+int tseries_channel(const char *name, uint32_t raw_cap) {
+    channel_t *c;
+    uint32_t mark = st.arena_used;
+    int ch = tseries_find(name);
+    bool ok;
+
+    if (ch >= 0) return ch;
+    if (st.channels >= TSERIES_MAX_CHANNELS || raw_cap == 0) return -1;
+
+    c = &channels[st.channels];
+    c->raw = arena_alloc(raw_cap * sizeof(tseries_sample_t));
+    ok = c->raw != NULL;
+    for (int t = 0; t < TSERIES_TIERS; t++) {
+        c->agg[t] = arena_alloc(tier_cap[t] * sizeof(tseries_agg_t));
+        ok = ok && c->agg[t];
+    }
+    if (!ok) {
+        st.arena_used = mark;   // Devolve o que chegou a reservar
+        memset(c, 0, sizeof(*c));
+        return -1;
+    }
+
+    c->name = name;
+    c->raw_idx.cap = raw_cap;
+    for (int t = 0; t < TSERIES_TIERS; t++) c->agg_idx[t].cap = tier_cap[t];
+    return st.channels++;
+}
+
+const char *tseries_name(int ch) {
+    return (ch >= 0 && ch < st.channels) ? channels[ch].name : NULL;
+}
+
+void tseries_add(int ch, uint32_t t_ms, int32_t v) {
+    channel_t *c;
+    tseries_sample_t *s;
+
+    if (ch < 0 || ch >= st.channels) return;
+    c = &channels[ch];
+
+    if (c->raw_idx.count > 0) {
+        const tseries_sample_t *last = &c->raw[ring_pos(&c->raw_idx, c->raw_idx.count - 1)];
+        if (before(t_ms, last->t_ms)) {
+            st.out_of_order++;
+            return;
+        }
+    }
+
+    s = &c->raw[ring_push(&c->raw_idx)];
+    s->t_ms = t_ms;
+    s->v = v;
+
+    tier_feed(c, 0, t_ms, v, v, v, 1);
+}
+
+bool tseries_raw(int ch, uint32_t t0, uint32_t t1, tseries_raw_span_t *out) {
+    const channel_t *c;
+
+    if (ch < 0 || ch >= st.channels) return false;
+    c = &channels[ch];
+    span_find(c->raw, sizeof(tseries_sample_t), &c->raw_idx, t0, t1,
+              (const void **)out->p, out->n);
+    return true;
+}
+
+bool tseries_agg(int ch, int tier, uint32_t t0, uint32_t t1, tseries_agg_span_t *out) {
+    const channel_t *c;
+
+    if (ch < 0 || ch >= st.channels || tier < 0 || tier >= TSERIES_TIERS) return false;
+    c = &channels[ch];
+    span_find(c->agg[tier], sizeof(tseries_agg_t), &c->agg_idx[tier], t0, t1,
+              (const void **)out->p, out->n);
+    return true;
+}
+
+bool tseries_agg_open(int ch, int tier, tseries_agg_t *out) {
+    const bucket_t *bk;
+
+    if (ch < 0 || ch >= st.channels || tier < 0 || tier >= TSERIES_TIERS) return false;
+    bk = &channels[ch].open[tier];
+    if (bk->n == 0) return false;
+
+    out->t_ms = bk->t_ms;
+    out->min = bk->min;
+    out->max = bk->max;
+    out->mean = (int32_t)(bk->sum / (int64_t)bk->n);
+    out->n = bk->n;
+    return true;
+}
+
+bool tseries_last(int ch, tseries_sample_t *out) {
+    const channel_t *c;
+
+    if (ch < 0 || ch >= st.channels) return false;
+    c = &channels[ch];
+    if (c->raw_idx.count == 0) return false;
+    *out = c->raw[ring_pos(&c->raw_idx, c->raw_idx.count - 1)];
+    return true;
+}
+
+const tseries_stats_t *tseries_stats(void) {
+    return &st;
+}
@@ -0,0 +1,111 @@
+// tseries.h
+// Séries temporais na SDRAM (main_ram): por canal, um anel de amostras cruas
+// e três níveis de agregados (min/max/média de 1 s, 10 s e 1 min) mantidos
+// a cada amostra, sem varrer o bruto de novo.
+
+#ifndef TSERIES_H
+#define TSERIES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Tudo sai de uma arena estática no .bss, que o linker põe na main_ram: a
+ * metade dos 8 MB. Os canais são criados no início e nunca liberados.
+ */
+#define TSERIES_ARENA_BYTES   (4u << 20)
+#define TSERIES_MAX_CHANNELS  16
+
+#define TSERIES_TIERS         3
+#define TSERIES_TIER_1S       0
+#define TSERIES_TIER_10S      1
+#define TSERIES_TIER_1MIN     2
+
+/* Baldes guardados por nível: 1 h de 1 s, 6 h de 10 s, 24 h de 1 min */
+#define TSERIES_TIER_CAP      { 3600, 2160, 1440 }
+#define TSERIES_TIER_MS       { 1000, 10000, 60000 }
+
+typedef struct {
+    uint32_t t_ms;
+    int32_t  v;
+} tseries_sample_t;
+
+typedef struct {
+    uint32_t t_ms;        // Início do balde (múltiplo do período do nível)
+    int32_t  min;
+    int32_t  max;
+    int32_t  mean;
+    uint32_t n;           // Amostras cruas agregadas
+} tseries_agg_t;
+
+/*
+ * Resultado de uma consulta, sem cópia: até dois trechos contíguos do anel
+ * (o segundo só quando a faixa dá a volta), do mais antigo ao mais novo.
+ * Os ponteiros apontam para dentro do anel e valem até o próximo
+ * tseries_add() no canal; produtor e leitores rodam no laço principal.
+ */
+typedef struct {
+    const tseries_sample_t *p[2];
+    uint32_t n[2];
+} tseries_raw_span_t;
+
+typedef struct {
+    const tseries_agg_t *p[2];
+    uint32_t n[2];
+} tseries_agg_span_t;
+
+typedef struct {
+    uint8_t  channels;
+    uint32_t arena_used;          // Bytes da arena já entregues
+    uint32_t out_of_order;        // Amostras com tempo anterior à última (descartadas)
+} tseries_stats_t;
+
+void tseries_init(void);
+
+/*
+ * Cria o canal (ou devolve o existente com o mesmo nome) com espaço para
+ * raw_cap amostras cruas; -1 se a arena ou a tabela de canais acabou.
+ * name não é copiado: precisa viver o programa todo.
+ */
+int  tseries_channel(const char *name, uint32_t raw_cap);
+int  tseries_find(const char *name);
+const char *tseries_name(int ch);
+
+/* Acrescenta uma amostra; t_ms não pode andar para trás */
+void tseries_add(int ch, uint32_t t_ms, int32_t v);
+
+/* Amostras / baldes fechados com t0 <= t_ms <= t1; false se canal inválido */
+bool tseries_raw(int ch, uint32_t t0, uint32_t t1, tseries_raw_span_t *out);
+bool tseries_agg(int ch, int tier, uint32_t t0, uint32_t t1, tseries_agg_span_t *out);
+
+/*
+ * Balde ainda aberto do nível (parcial); false se vazio. Cada nível só
+ * recebe baldes fechados do anterior: as amostras mais novas estão nos
+ * abertos dos níveis abaixo, e somar os abertos de todos não conta nada duas
+ * vezes.
+ */
+bool tseries_agg_open(int ch, int tier, tseries_agg_t *out);
+
+/* Última amostra crua; false se o canal está vazio */
+bool tseries_last(int ch, tseries_sample_t *out);
+
+const tseries_stats_t *tseries_stats(void);
+
+/* Acesso ao i-ésimo elemento de uma consulta, atravessando a volta do anel */
+static inline uint32_t tseries_raw_count(const tseries_raw_span_t *s) {
+    return s->n[0] + s->n[1];
+}
+
+static inline const tseries_sample_t *tseries_raw_at(const tseries_raw_span_t *s, uint32_t i) {
+    return i < s->n[0] ? &s->p[0][i] : &s->p[1][i - s->n[0]];
+}
+
+static inline uint32_t tseries_agg_count(const tseries_agg_span_t *s) {
+    return s->n[0] + s->n[1];
+}
+
+static inline const tseries_agg_t *tseries_agg_at(const tseries_agg_span_t *s, uint32_t i) {
+    return i < s->n[0] ? &s->p[0][i] : &s->p[1][i - s->n[0]];
+}
+
+#endif // TSERIES_H
@@ -0,0 +1,183 @@
+// uart_log.c
+
+#include "uart_log.h"
+#include "fastmem.h"
+#include "ring.h"
+
+#include <stdio.h>
+#include <irq.h>
+#include <uart.h>
+#include <generated/csr.h>
+#include <generated/soc.h>
+
+RING_DEFINE(tx_ring, uint8_t, UART_LOG_TX_SIZE)
+
+static FAST_DATA tx_ring_t tx;
+static uart_log_policy_t policy;
+static uint32_t dropped;
+static uint32_t high_water;
+static bool active;
+
+/* Linha do printf em montagem: vai para o buffer inteira (ver stdout_put) */
+static char line[UART_LOG_LINE];
+static int line_len;
+
+/* ================= TX ================= */
+
+/*
+ * Passa bytes do buffer para a FIFO da UART até ela encher. Invariante:
+ * ao sair, ou o buffer está vazio ou a FIFO está cheia; no segundo caso a
+ * borda "FIFO deixou de estar cheia" gera o evento de TX que chama de novo.
+ * Roda na ISR ou com a IRQ da UART mascarada (único consumidor por vez).
+ */
+static FAST_CODE void tx_drain(void) {
+    const uint8_t *c;
+
+    while (!uart_txfull_read() && (c = tx_ring_peek(&tx)) != NULL) {
+        uart_rxtx_write(*c);
+        tx_ring_release(&tx);
+    }
+}
+
+static FAST_CODE void uart_log_isr(void) {
+    uart_isr();   // RX da libbase; também limpa o pending de TX
+    tx_drain();
+}
+
+/*
+ * Garante a saída do que foi enfileirado. Chamada depois de todo push: a
+ * ISR pode ter esvaziado o buffer entre a checagem e o push e saído com a
+ * FIFO livre, e aí nenhum evento de TX viria. Com a FIFO já cheia não faz
+ * nada, então repetir é inofensivo.
+ */
+static void tx_kick(void) {
+    unsigned int mask = irq_getmask();
+
+    irq_setmask(mask & ~(1 << UART_INTERRUPT));
+    tx_drain();
+    irq_setmask(mask);
+}
+
+static void push(const void *buf, int len) {
+    uint32_t used;
+
+    tx_ring_push_n(&tx, buf, (uint32_t)len);
+
+    used = tx_ring_count(&tx);
+    if (used > high_water) high_water = used;
+
+    tx_kick();
+}
+
+/* retry: quem chama tenta de novo depois, então falta de espaço não é descarte */
+static int enqueue(const void *buf, int len, bool retry) {
+    if (len <= 0) return 0;
+    if (!active) {
+        for (int i = 0; i < len; i++) uart_write(((const char *)buf)[i]);
+        return len;
+    }
+    if ((uint32_t)len > UART_LOG_TX_SIZE) {
+        dropped += len;
+        return 0;
+    }
+
+    while (tx_ring_space(&tx) < (uint32_t)len) {
+        if (retry) return 0;
+        if (policy == UART_LOG_DROP) {
+            dropped += len;
+            return 0;
+        }
+        if (irq_getie()) tx_kick();   // A ISR esvazia; aqui só garante o início
+        else uart_log_flush();        // Sem IRQ: esvazia na mão
+    }
+
+    push(buf, len);
+    return len;
+}
+
+int uart_log_write(const void *buf, int len) {
+    return enqueue(buf, len, false);
+}
+
+int uart_log_try_write(const void *buf, int len) {
+    return enqueue(buf, len, true);
+}
+
+/* ================= STDOUT ================= */
+
+static void line_flush(void) {
+    int n = line_len;
+
+    line_len = 0;   // Antes: a política BLOCK sem IRQ volta por uart_log_flush()
+    if (n) uart_log_write(line, n);
+}
+
+/*
+ * put() do stdout do picolibc: um caractere por chamada. A linha é montada
+ * aqui (com CR antes de LF) e enfileirada inteira no '\n', para a política
+ * DROP descartar linhas, não pedaços delas. Linha maior que UART_LOG_LINE
+ * sai em trechos.
+ */
+static int stdout_put(char c, FILE *f) {
+    (void)f;
+    if (c == '\n') {
+        if (line_len > UART_LOG_LINE - 2) line_flush();
+        line[line_len++] = '\r';
+        line[line_len++] = '\n';
+        line_flush();
+    } else {
+        if (line_len == UART_LOG_LINE) line_flush();
+        line[line_len++] = c;
+    }
+    return (unsigned char)c;
+}
+
+/* ================= API ================= */
+
+void uart_log_init(void) {
+    tx_ring_init(&tx);
+    policy = UART_LOG_DROP;
+    dropped = 0;
+    high_water = 0;
+    line_len = 0;
+
+    uart_ev_pending_write(uart_ev_pending_read());
+    uart_ev_enable_write(UART_EV_TX | UART_EV_RX);
+    irq_attach(UART_INTERRUPT, uart_log_isr);
+    irq_setmask(irq_getmask() | (1 << UART_INTERRUPT));
+
+    stdout->put = stdout_put;
+    active = true;
+}
+
+void uart_log_set_policy(uart_log_policy_t p) {
+    policy = p;
+}
+
+void uart_log_flush(void) {
+    unsigned int mask;
+
+    if (!active) return;
+
+    line_flush();   // Linha sem '\n' ainda (prompt, panic)
+    mask = irq_getmask();
+    irq_setmask(mask & ~(1 << UART_INTERRUPT));
+    while (!tx_ring_empty(&tx)) {
+        while (uart_txfull_read());
+        tx_drain();
+    }
+    while (!uart_txempty_read());
+    irq_setmask(mask);
+}
+
+uint32_t uart_log_pending(void) {
+    return tx_ring_count(&tx);
+}
+
+uint32_t uart_log_dropped(void) {
+    return dropped;
+}
+
+uint32_t uart_log_high_water(void) {
+    return high_water;
+}
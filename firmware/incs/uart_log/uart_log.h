@@ -0,0 +1,46 @@
+// uart_log.h
+// Console serial não bloqueante: printf e a telemetria escrevem num buffer
+// circular grande, esvaziado pela interrupção de TX da UART.
+
+#ifndef UART_LOG_H
+#define UART_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_LOG_TX_SIZE  4096   // Potência de 2: ~0,35 s de linha a 115200
+#define UART_LOG_LINE     256    // Linha do printf montada antes de enfileirar
+
+/* O que fazer quando o buffer não comporta a mensagem */
+typedef enum {
+    UART_LOG_DROP = 0,   // Descarta a mensagem inteira e conta (padrão)
+    UART_LOG_BLOCK       // Espera a ISR abrir espaço (só com IRQs ligadas)
+} uart_log_policy_t;
+
+/*
+ * Chamar depois de uart_init(): liga o evento de TX/RX, instala a ISR
+ * (que também chama uart_isr() da libbase, para a recepção continuar
+ * funcionando em uart_read()) e desvia o stdout do printf para o buffer.
+ */
+void uart_log_init(void);
+void uart_log_set_policy(uart_log_policy_t policy);
+
+/* Enfileira len bytes de uma vez (nunca pela metade); retorna len ou 0 */
+int  uart_log_write(const void *buf, int len);
+
+/* Idem, mas sem espaço só retorna 0, sem esperar nem contar descarte:
+ * para quem guarda a mensagem e tenta de novo (export do flashlog) */
+int  uart_log_try_write(const void *buf, int len);
+
+/*
+ * Esvazia o buffer por polling, com a IRQ da UART mascarada, e espera a
+ * FIFO do hardware terminar. Serve com interrupções desligadas: panic,
+ * antes de reboot.
+ */
+void uart_log_flush(void);
+
+uint32_t uart_log_pending(void);     // Bytes ainda no buffer
+uint32_t uart_log_dropped(void);     // Bytes descartados de vez pela política DROP
+uint32_t uart_log_high_water(void);  // Maior ocupação observada
+
+#endif // UART_LOG_H
@@ -17,292 +17,637 @@
 #include "time_driver.h"
 #include "bh1750.h"
 #include "max3010x.h"
+#include "max3010x_irq.h"
 #include "TCS34725.h"
+#include "TCS34725_color.h"
+#include "TCS34725_irq.h"
 #include "ST7789.h"
 #include "gfx.h"
+#include "color565.h"
+#include "sensor_registry.h"
+#include "sensor_frame.h"
+#include "telemetry.h"
+#include "uart_log.h"
+#include "flashlog.h"
+#include "tseries.h"
+#include "fastmem.h"
+#include "prof.h"
+#include "pcprof.h"
 
 static max3010x_ctx_t hr;
 static bh1750_ctx_t bh1750;
 static tcs34725_ctx_t color;
-uint8_t sensores[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-int n_sensores = 0;
+static aht10_ctx_t aht;
+
+#define SCAN_PERIOD_MS   1000   // Novo scan do barramento I2C
+#define TELA_PERIOD_MS   250    // Redesenho da tabela
+#define FRAME_PERIOD_MS  1000   // Disparo conjunto dos sensores com trigger
+#define FRAME_MARGIN_MS  100    // Folga sobre a maior conversão disparada no frame
 
 
 // ============================================
 // === Protótipos Locais ===
 // ============================================
-static uint16_t rgb_to_565(uint16_t r, uint16_t g, uint16_t b);
 static void draw_color_square(uint16_t color_565);
 static void cabecalho_tabela(void);
-void color_task(void);
+static void limpa_tabela(void);
+static void series_ppg(uint32_t t0_ms, uint16_t fs, const max3010x_sample_t *s, int n);
 // ============================================
 // === Utils de cor / display ===
 // ============================================
 
-static uint16_t rgb_to_565_norm(uint16_t c,
-                                uint16_t r,
-                                uint16_t g,
-                                uint16_t b) {
+// Valores numéricos grandes: fonte 7 segmentos opaca, um glifo por janela.
+// O fundo preto apaga o valor anterior, sem a passada extra em preto, e o
+// recorte mantém o valor dentro da célula (largura w) sem invadir a grade.
+static void print_valor(int16_t x, int16_t y, int16_t w, const char *txt) {
+    gfx_rect_t salva = gfx_push_clip(x, y, w, gfx_font_seg7.height);
+    gfx_set_font(&gfx_font_seg7);
+    gfx_set_text_colors(ST77XX_WHITE, ST77XX_BLACK);
+    gfx_set_cursor(x, y);
+    gfx_print(txt);
+    gfx_set_font(NULL);
+    gfx_set_text_color(ST77XX_WHITE);
+    gfx_pop_clip(salva);
+}
 
-    if (c == 0) c = 1; // evita divisão por zero
+// Linha de log: texto na serial, ou registro LOG no modo binário
+static void log_linha(const char *txt) {
+    if (telemetry_binary()) telemetry_log(txt);
+    else printf("%s\n", txt);
+}
 
-    // Normaliza RGB pela luz total
-    r = (uint32_t)r * 255 / c;
-    g = (uint32_t)g * 255 / c;
-    b = (uint32_t)b * 255 / c;
+static void draw_color_square(uint16_t color_565) {
 
-    // Limita
-    if (r > 255) r = 255;
-    if (g > 255) g = 255;
-    if (b > 255) b = 255;
+    int size = 100;
+    int x = (240 - size) / 2;
+    int y = (320 - size) / 2;
 
-    return ((r & 0xF8) << 8) |
-           ((g & 0xFC) << 3) |
-           ( b >> 3);
+    gfx_fill_rect(x, y, size, size, color_565);
 }
 
+
 // ============================================
-// === Gamma correction (γ ≈ 2.2) ===
+// === Drivers registrados ===
 // ============================================
-static const uint8_t gamma8_lut[256] = {
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2,
-    2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 5, 5, 5, 5,
-    6, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 10, 10, 10, 11,
-    11, 12, 12, 13, 13, 14, 14, 15, 15, 16, 17, 17, 18, 18, 19, 20,
-    20, 21, 22, 22, 23, 24, 25, 25, 26, 27, 28, 29, 29, 30, 31, 32,
-    33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48,
-    49, 50, 51, 52, 54, 55, 56, 57, 58, 59, 61, 62, 63, 64, 66, 67,
-    68, 70, 71, 72, 74, 75, 76, 78, 79, 81, 82, 84, 85, 87, 88, 90,
-    91, 93, 94, 96, 97, 99, 101, 102, 104, 105, 107, 109, 110, 112, 114, 115,
-    117, 119, 120, 122, 124, 126, 127, 129, 131, 133, 134, 136, 138, 140, 142, 143,
-    145, 147, 149, 151, 152, 154, 156, 158, 160, 162, 164, 165, 167, 169, 171, 173,
-    175, 177, 179, 181, 183, 185, 187, 189, 191, 193, 195, 197, 199, 201, 203, 205,
-    207, 209, 211, 213, 215, 217, 219, 221, 223, 225, 227, 229, 231, 233, 235, 237,
-    239, 241, 243, 245, 247, 249, 251, 253, 255
-};
-static uint16_t rgb_to_565_wb_gamma(uint16_t c,
-                                    uint16_t r,
-                                    uint16_t g,
-                                    uint16_t b) {
+// Cada sensor: probe/init/sample (não bloqueante) e format/render da linha
+// na tabela. Os resultados ficam no slot do registro (res.v[]).
 
-    if (c == 0) c = 1;
+// --- BH1750: v[0] = lux * 100 (one time, disparado pelo frame) ---
 
-    // Normalização pelo canal CLEAR (0–255)
-    r = (uint32_t)r * 255 / c;
-    g = (uint32_t)g * 255 / c;
-    b = (uint32_t)b * 255 / c;
+static bool bh1750_drv_init(void *ctx, uint8_t addr) {
+    if (!bh1750_init(ctx, addr, BH1750_CONT_H_RES)) return false;
+    return bh1750_set_one_shot(ctx, true);
+}
 
-    if (r > 255) r = 255;
-    if (g > 255) g = 255;
-    if (b > 255) b = 255;
+static bool bh1750_drv_trigger(void *ctx) {
+    return bh1750_start(ctx);
+}
 
-    // -----------------------------
-    // White Balance (ganhos fixos)
-    // Escala em % (100 = 1.0)
-    // -----------------------------
-    r = (r * 110) / 100; // +10%
-    g = (g * 85)  / 100; // -15%
-    b = (b * 105) / 100; // +5%
+// Segue o degrau do auto-range: de 24 ms (L) a ~663 ms (H2, MTreg 254)
+static uint32_t bh1750_drv_conversion_ms(void *ctx) {
+    return bh1750_conversion_ms(ctx);
+}
 
-    if (r > 255) r = 255;
-    if (g > 255) g = 255;
-    if (b > 255) b = 255;
+static sensor_status_t bh1750_drv_sample(void *ctx, sensor_result_t *res) {
+    bh1750_ctx_t *s = ctx;
+    sensor_status_t st = bh1750_poll(s);
 
-    // Gamma correction
-    r = gamma8_lut[r];
-    g = gamma8_lut[g];
-    b = gamma8_lut[b];
+    if (st == SENSOR_READY) {
+        if (!bh1750_fetch(s)) return SENSOR_ERROR;
+        bh1750_autorange(s);   // Próxima conversão já no degrau certo
+        res->v[0] = s->lux_x100;
+    }
+    return st;
+}
 
-    // RGB565
-    return ((r & 0xF8) << 8) |
-           ((g & 0xFC) << 3) |
-           ( b >> 3);
+static void bh1750_drv_format(const sensor_slot_t *slot, char *buf, int len) {
+    snprintf(buf, len, "Iluminancia: %lu.%02lu lx",
+             (unsigned long)slot->res.v[0] / 100, (unsigned long)slot->res.v[0] % 100);
 }
 
+static int bh1750_drv_render(const sensor_slot_t *slot, int pos_y) {
+    char buf[16];
 
-static uint16_t rgb_to_565_gamma(uint16_t c,
-                                 uint16_t r,
-                                 uint16_t g,
-                                 uint16_t b) {
+    if (!slot->fresh) return pos_y + 8 + 22;   // Nada publicado: mantém a tela
 
-    if (c == 0) c = 1;
+    pos_y += 8;
+    gfx_set_cursor(18, pos_y);
+    gfx_print("BH1750");
+    snprintf(buf, sizeof(buf), "%5lu.%02lu",
+             (unsigned long)slot->res.v[0] / 100, (unsigned long)slot->res.v[0] % 100);
+    print_valor(116, pos_y, 92, buf);
+    gfx_print(" Lux");
+    pos_y += 22;
+    gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
+    return pos_y;
+}
 
-    // Normaliza para 0–255 usando o canal CLEAR
-    r = (uint32_t)r * 255 / c;
-    g = (uint32_t)g * 255 / c;
-    b = (uint32_t)b * 255 / c;
+// Publica com 0,5 lx de variação, ou a cada 10 s parado
+static const report_cfg_t bh1750_report = {
+    .nv = 1, .deadband = { 50 }, .max_silence_ms = 10000,
+};
 
-    if (r > 255) r = 255;
-    if (g > 255) g = 255;
-    if (b > 255) b = 255;
+static const sensor_driver_t drv_bh1750 = {
+    .name = "BH1750", .addrs = { BH1750_ADDR_LOW, BH1750_ADDR_HIGH },
+    .id_reg = SENSOR_NO_ID, .period_ms = 20, .ctx = &bh1750,
+    .init = bh1750_drv_init, .trigger = bh1750_drv_trigger,
+    .conversion_ms = bh1750_drv_conversion_ms, .sample = bh1750_drv_sample,
+    .format = bh1750_drv_format, .render = bh1750_drv_render,
+    .report = &bh1750_report,
+};
 
-    // Gamma correction
-    r = gamma8_lut[r];
-    g = gamma8_lut[g];
-    b = gamma8_lut[b];
+// --- MAX3010x: v[0] = BPM, v[1] = SpO2 * 10, v[2] = IR, v[3] = RED ---
 
-    // RGB565
-    return ((r & 0xF8) << 8) |
-           ((g & 0xFC) << 3) |
-           ( b >> 3);
+static bool max3010x_drv_init(void *ctx, uint8_t addr) {
+    (void)addr;
+    if (!max3010x_init(ctx)) return false;
+    if (max3010x_irq_init(ctx)) log_linha("MAX3010x: amostragem por INT");
+    return true;
 }
 
+static void max3010x_drv_remove(void *ctx) {
+    (void)ctx;
+    max3010x_irq_stop();
+}
 
+// Consome o que há na FIFO (ou no buffer da interrupção), sem esperar
+static sensor_status_t max3010x_drv_sample(void *ctx, sensor_result_t *res) {
+    max3010x_ctx_t *s = ctx;
+    max3010x_sample_t amostras[MAX3010X_FIFO_DEPTH];
+    int total = 0, n;
 
+    if (max3010x_irq_active()) {
+        static uint32_t descartadas;
+        max3010x_stamped_t lote[MAX3010X_FIFO_DEPTH];
 
-static uint16_t rgb_to_565(uint16_t r, uint16_t g, uint16_t b) {
+        if (max3010x_irq_service(s) < 0) return SENSOR_ERROR;
+        if (max3010x_irq_dropped() != descartadas) {
+            descartadas = max3010x_irq_dropped();
+            telemetry_ppg_flush();
+        }
+        while ((n = max3010x_irq_read(lote, MAX3010X_FIFO_DEPTH)) > 0) {
+            for (int i = 0; i < n; i++) amostras[i] = lote[i].s;
+            max3010x_process_block(s, amostras, n);
+            telemetry_ppg(time_cycles_to_us(lote[0].t_cycles),
+                          s->sample_rate_hz, amostras, n);
+            series_ppg(time_cycles_to_ms(lote[0].t_cycles),
+                       s->sample_rate_hz, amostras, n);
+            total += n;
+        }
+    } else {
+        uint8_t perdidas = 0;
+
+        n = max3010x_fifo_drain(s, amostras, MAX3010X_FIFO_DEPTH, &perdidas);
+        if (n < 0) return SENSOR_ERROR;
+        if (perdidas) {
+            char msg[48];
+            snprintf(msg, sizeof(msg), "MAX3010x: FIFO overflow, %u amostras perdidas", perdidas);
+            log_linha(msg);
+            telemetry_ppg_flush();
+        }
+        max3010x_process_block(s, amostras, n);
+        if (n > 0 && s->sample_rate_hz) {
+            // A mais nova chegou há pouco: as anteriores recuam de 1/fs
+            uint32_t t0 = time_get_us() - (uint32_t)(n - 1) * (1000000u / s->sample_rate_hz);
+            telemetry_ppg(t0, s->sample_rate_hz, amostras, n);
+            series_ppg(time_get_ms() - (uint32_t)(n - 1) * (1000u / s->sample_rate_hz),
+                       s->sample_rate_hz, amostras, n);
+        }
+        total = n;
+    }
 
-    // Converte 16 bits → 8 bits
-    r >>= 8;
-    g >>= 8;
-    b >>= 8;
+    if (total == 0) return SENSOR_BUSY;
 
-    return ((r & 0xF8) << 8) |
-           ((g & 0xFC) << 3) |
-           ( b >> 3);
+    res->v[0] = s->bpm;
+    res->v[1] = s->spo2.spo2_x10;
+    res->v[2] = s->ir_value;
+    res->v[3] = s->red_value;
+    return SENSOR_READY;
 }
 
-static void draw_color_square(uint16_t color_565) {
+static void max3010x_drv_format(const sensor_slot_t *slot, char *buf, int len) {
+    const max3010x_ctx_t *s = slot->drv->ctx;
 
-    int size = 100;
-    int x = (240 - size) / 2;
-    int y = (320 - size) / 2;
+    snprintf(buf, len, "IR:%lu RED:%lu BPM:%d SpO2:%u.%u%% (flags 0x%02X) DSP:%lu ciclos/%u",
+             s->ir_value, s->red_value, s->bpm,
+             s->spo2.spo2_x10 / 10, s->spo2.spo2_x10 % 10, s->spo2.flags,
+             s->dsp_cycles, s->dsp_samples);
+}
 
-    gfx_fill_rect(x, y, size, size, color_565);
+static int max3010x_drv_render(const sensor_slot_t *slot, int pos_y) {
+    char buf[16];
+
+    if (!slot->fresh) return pos_y + 8 + 12 + 8 + 4 + 22;
+
+    gfx_draw_line(180, pos_y, 180, pos_y + 8 + 22 * 2, ST77XX_WHITE);
+    gfx_draw_line(180 + 70, pos_y, 180 + 70, pos_y + 8 + 22 * 2, ST77XX_WHITE);
+    pos_y += 8;
+    gfx_set_cursor(116 + 12, pos_y);
+    gfx_print("BPM");
+    gfx_set_cursor(116 + 12 + 6 + 70, pos_y);
+    gfx_print("IR");
+    gfx_set_cursor(116 + 12 + 140, pos_y);
+    gfx_print("RED");
+    pos_y += 12;
+    gfx_set_cursor(8, pos_y);
+    gfx_print("MAX3010x");
+    pos_y += 8;
+    gfx_draw_line(110, pos_y, 320, pos_y, ST77XX_WHITE);
+    pos_y += 4;
+    snprintf(buf, sizeof(buf), "%3ld", (long)slot->res.v[0]);
+    print_valor(116 + 12, pos_y, 180 - (116 + 12), buf);
+    snprintf(buf, sizeof(buf), "%3lu", (unsigned long)slot->res.v[2] >> 10);
+    print_valor(116 + 70, pos_y, 250 - (116 + 70), buf);
+    snprintf(buf, sizeof(buf), "%3lu", (unsigned long)slot->res.v[3] >> 10);
+    print_valor(116 + 140, pos_y, 319 - (116 + 140), buf);
+    pos_y += 22;
+    gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
+    return pos_y;
 }
 
+// BPM inteiro, SpO2 em 0,5 %, IR/RED na resolução da tela (>> 10); no
+// máximo na cadência da tela
+static const report_cfg_t max3010x_report = {
+    .nv = 4, .deadband = { 0, 5, 1023, 1023 },
+    .min_interval_ms = 250, .max_silence_ms = 5000,
+};
 
-// ============================================
-// === Função de aplicação ===
-// ============================================
+static const sensor_driver_t drv_max3010x = {
+    .name = "MAX3010x", .addrs = { MAX3010X_I2C_ADDR, 0 },
+    .id_reg = 0xFF, .id_values = { 0x15, 0 },   // PART_ID: MAX30101/2 (o MAX30100 tem outro mapa)
+    .period_ms = 100, .ctx = &hr,
+    .init = max3010x_drv_init, .sample = max3010x_drv_sample,
+    .format = max3010x_drv_format, .render = max3010x_drv_render,
+    .remove = max3010x_drv_remove, .report = &max3010x_report,
+};
 
-static void lux(void) {
+// --- TCS34725: v[0..3] = C, R, G, B normalizados (16x / 154 ms) ---
+//
+// Depois da primeira leitura o sensor fica em modo limiar: AIEN liga com a
+// faixa em +-TCS_JANELA_PCT % do CLEAR e a cor só é lida de novo quando a
+// luz sai dela (INT no pino, ou AINT no STATUS sem o pino), ou a cada
+// TCS_REFRESH_MS para não ficar preso a uma leitura velha.
+
+#define TCS_JANELA_PCT  10
+#define TCS_REFRESH_MS  5000
+
+static tcs34725_color_t tcs_cal;
+static uint16_t tcs_565;
+static tcs34725_gain_t tcs_gain;          // Degrau com que tcs_cal/res.v foram integrados
+static tcs34725_integration_t tcs_atime;  // (o auto-range já pode ter mudado o do ctx)
+static uint32_t tcs_refresh_ms;
+
+static bool tcs34725_drv_init(void *ctx, uint8_t addr) {
+    (void)addr;
+    if (!tcs34725_init(ctx, TCS34725_GAIN_16X, TCS34725_INTEGRATION_154MS)) return false;
+    if (!tcs34725_set_persistence(ctx, TCS34725_PERS_2)) return false;   // Ignora cintilação isolada
+    if (tcs34725_irq_init()) log_linha("TCS34725: leitura por INT");
+    tcs34725_start(ctx);   // Recusa até passar o power-on; sample() repete
+    return true;
+}
 
-    if (!bh1750_read(&bh1750)) {
-        printf("Erro leitura BH1750\n");
-        return ;
+static void tcs34725_drv_remove(void *ctx) {
+    (void)ctx;
+    tcs34725_irq_stop();
+}
+
+static sensor_status_t tcs34725_drv_sample(void *ctx, sensor_result_t *res) {
+    tcs34725_ctx_t *s = ctx;
+    tcs34725_raw_t raw;
+    uint32_t norm[4];
+    uint8_t range;
+    uint32_t now = time_get_ms();
+    bool refresh = !s->aien || sensor_time_reached(now, tcs_refresh_ms);
+    sensor_status_t st;
+
+    // Com o pino INT, sem borda não há nada a fazer no barramento. O aviso
+    // só é limpo quando a leitura termina: poll() BUSY ou erro de I2C
+    // voltam aqui com a borda ainda marcada.
+    if (!refresh && tcs34725_irq_active() && !tcs34725_irq_pending()) return SENSOR_BUSY;
+
+    st = tcs34725_poll(s);
+    if (st == SENSOR_READY) {
+        // Ciclo completo, mas a luz não saiu da faixa: espera o próximo
+        if (!refresh && !tcs34725_int_pending(s)) {
+            tcs34725_irq_take();   // Borda sem AINT: nada a ler
+            tcs34725_start(s);
+            return SENSOR_BUSY;
+        }
+
+        if (!tcs34725_fetch(s, &raw)) {
+            tcs34725_start(s);
+            return SENSOR_ERROR;
+        }
+        // Atendida; o pino segue em 0 até o int_clear abaixo, então
+        // nenhuma borda nova cabe entre a leitura e este take
+        tcs34725_irq_take();
+
+        // Lux/CCT e cor com o ganho/ATIME desta leitura, antes do auto-range.
+        // RGB sem IR + matriz de calibração (só inteiros); a cor 565 usa
+        // razões, então as contagens cruas servem em qualquer degrau.
+        tcs34725_color_compute(s, &tcs34725_ccm_identity, raw.c, raw.r, raw.g, raw.b, &tcs_cal);
+        tcs_565 = color565_convert(raw.c, tcs_cal.r, tcs_cal.g, tcs_cal.b);
+
+        tcs34725_normalize(s, &raw, norm);
+        for (int i = 0; i < 4; i++) res->v[i] = (int32_t)norm[i];
+        tcs_gain = s->gain;
+        tcs_atime = s->integration;
+
+        // Limiares em contagens cruas: se o degrau mudou, a faixa vazia
+        // (baixo > alto) força a próxima leitura já no degrau novo
+        range = s->range;
+        tcs34725_autorange(s, &raw);
+        if (!s->aien) tcs34725_int_enable(s, true);
+        if (s->range != range) {
+            tcs34725_set_thresholds(s, 0xFFFF, 0);
+            tcs34725_int_clear(s);   // Solta o pino para a próxima borda
+        } else tcs34725_track(s, raw.c, TCS_JANELA_PCT);
+        tcs_refresh_ms = now + TCS_REFRESH_MS;
+
+        tcs34725_start(s);
+        return SENSOR_READY;
     }
+    if (st != SENSOR_BUSY) tcs34725_start(s);
+    return st;
+}
+
+static void tcs34725_drv_format(const sensor_slot_t *slot, char *buf, int len) {
+    snprintf(buf, len, "R:%lu G:%lu B:%lu RGB565:0x%04X CCT:%uK Lux:%lu.%02lu%s G%ux/%ums (%lu ciclos)",
+             (unsigned long)slot->res.v[1], (unsigned long)slot->res.v[2],
+             (unsigned long)slot->res.v[3], tcs_565, tcs_cal.cct_k,
+             tcs_cal.lux_x100 / 100, tcs_cal.lux_x100 % 100,
+             tcs_cal.saturated ? " SAT" : "",
+             tcs34725_gain_factor(tcs_gain), tcs34725_integration_ms(tcs_atime),
+             tcs_cal.cycles);
+}
+
+static int tcs34725_drv_render(const sensor_slot_t *slot, int pos_y) {
+    static uint32_t ant_r, ant_g, ant_b;
+    uint32_t r = slot->res.v[1], g = slot->res.v[2], b = slot->res.v[3];
+    char buf[16];
+
+    if (!slot->fresh) return pos_y + 8 + 24 * 2 + 22;   // Sem leitura nova: mantém a tela
 
-    //printf("Iluminancia: %lu.%02lu lx\n",
-    //       bh1750.lux_x100 / 100,
-    //       bh1750.lux_x100 % 100);
+    // Apaga os valores anteriores (texto em preto) antes de escrever os novos
+    pos_y += 8;
+    gfx_set_text_color(ST77XX_BLACK);
+    gfx_set_cursor(116, pos_y);
+    sprintf(buf, "R:%lu", ant_r >> 8);
+    gfx_print(buf);
+    gfx_set_cursor(116, pos_y + 24);
+    sprintf(buf, "G:%lu", ant_g >> 8);
+    gfx_print(buf);
+    gfx_set_cursor(116, pos_y + 48);
+    sprintf(buf, "B:%lu", ant_b >> 8);
+    gfx_print(buf);
+    ant_r = r;
+    ant_g = g;
+    ant_b = b;
 
+    gfx_set_text_color(ST77XX_WHITE);
+    gfx_fill_rect(185, pos_y, 125, 24 * 3 - 11, tcs_565);
+    gfx_set_cursor(116, pos_y);
+    sprintf(buf, "R:%lu", r >> 8);
+    gfx_print(buf);
+    pos_y += 24;
+    gfx_set_cursor(8, pos_y);
+    gfx_print("TCS34725");
+    gfx_set_cursor(116, pos_y);
+    sprintf(buf, "G:%lu", g >> 8);
+    gfx_print(buf);
+    pos_y = pos_y + 24;
+    gfx_set_cursor(116, pos_y);
+    sprintf(buf, "B:%lu", b >> 8);
+    gfx_print(buf);
+    pos_y += 22;
+    gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
+    return pos_y;
 }
 
+// C/R/G/B na resolução da tela (>> 8)
+static const report_cfg_t tcs34725_report = {
+    .nv = 4, .deadband = { 255, 255, 255, 255 }, .max_silence_ms = 10000,
+};
 
-static void heart_rate(void) {
-    static uint32_t t_ms = 0;
+static const sensor_driver_t drv_tcs34725 = {
+    .name = "TCS34725", .addrs = { TCS34725_I2C_ADDR, 0 },
+    .id_reg = 0x80 | 0x12, .id_values = { 0x44, 0x4D },   // ID: TCS34721/5, TCS34723/7
+    .period_ms = 20, .ctx = &color,
+    .init = tcs34725_drv_init, .sample = tcs34725_drv_sample,
+    .format = tcs34725_drv_format, .render = tcs34725_drv_render,
+    .remove = tcs34725_drv_remove, .report = &tcs34725_report,
+};
 
-    for(int i = 0; i < 100; i++) {
-        max3010x_read_fifo(&hr);
-        max3010x_update(&hr, t_ms);
+// --- AHT10: v[0] = °C * 100, v[1] = %RH * 100 (só serial; disparado pelo frame) ---
 
-        //printf("IR:%lu RED:%lu BPM:%d\n",
-        //       hr.ir_value,
-        //       hr.red_value,
-        //       hr.bpm);
+static bool aht10_drv_init(void *ctx, uint8_t addr) {
+    (void)addr;
+    return aht10_init(ctx);
+}
 
-        delay_ms(10);
-        t_ms += 10;
+static bool aht10_drv_trigger(void *ctx) {
+    return aht10_start(ctx);   // false ainda no power-on: fica para o próximo frame
+}
+
+static uint32_t aht10_drv_conversion_ms(void *ctx) {
+    (void)ctx;
+    return AHT10_MEASURE_MS;
+}
+
+static sensor_status_t aht10_drv_sample(void *ctx, sensor_result_t *res) {
+    aht10_ctx_t *s = ctx;
+    aht10_data_t d;
+    sensor_status_t st = aht10_poll(s);
+
+    if (st == SENSOR_READY) {
+        if (!aht10_fetch(s, &d)) return SENSOR_ERROR;
+        res->v[0] = d.temperatura;
+        res->v[1] = d.umidade;
     }
+    return st;
+}
+
+static void aht10_drv_format(const sensor_slot_t *slot, char *buf, int len) {
+    long t = slot->res.v[0];
+    snprintf(buf, len, "Temperatura: %s%ld.%02ld C Umidade: %ld.%02ld %%",
+             t < 0 ? "-" : "", labs(t) / 100, labs(t) % 100,
+             (long)slot->res.v[1] / 100, (long)slot->res.v[1] % 100);
+}
+
+// 0,1 °C / 0,5 %RH, ou a cada 30 s parado
+static const report_cfg_t aht10_report = {
+    .nv = 2, .deadband = { 10, 50 }, .max_silence_ms = 30000,
+};
+
+static const sensor_driver_t drv_aht10 = {
+    .name = "AHT10", .addrs = { AHT10_I2C_ADDR, 0 },
+    .id_reg = SENSOR_NO_ID, .period_ms = 10, .ctx = &aht,
+    .init = aht10_drv_init, .trigger = aht10_drv_trigger,
+    .conversion_ms = aht10_drv_conversion_ms, .sample = aht10_drv_sample,
+    .format = aht10_drv_format, .report = &aht10_report,
+};
+
+static const sensor_driver_t *const drivers[] = {
+    &drv_bh1750, &drv_max3010x, &drv_tcs34725, &drv_aht10,
+};
+
+// ============================================
+// === Séries temporais (SDRAM) ===
+// ============================================
+// Cada valor de res.v[] que vale guardar vira um canal; o PPG cru entra
+// amostra a amostra. Os agregados de 1 s / 10 s / 1 min ficam prontos para
+// tendências sem varrer o bruto.
+
+#define SERIE_RAW       16384   // Amostras cruas por canal lento (~128 KB)
+#define SERIE_RAW_PPG   65536   // PPG a 100 Hz: ~11 min de bruto
+
+typedef struct {
+    const char *sensor;   // drv->name
+    uint8_t idx;          // Índice em res.v[]
+    const char *nome;     // Nome do canal
+    int ch;
+} serie_t;
+
+static serie_t series[] = {
+    { "BH1750",   0, "lux_x100",  -1 },
+    { "MAX3010x", 0, "bpm",       -1 },
+    { "MAX3010x", 1, "spo2_x10",  -1 },
+    { "TCS34725", 0, "cor_c",     -1 },
+    { "AHT10",    0, "temp_x100", -1 },
+    { "AHT10",    1, "umid_x100", -1 },
+};
+
+static int serie_ir = -1, serie_red = -1;
+
+/*
+ * Relógio de amostra do PPG: cada amostra anda 1/fs a partir da anterior
+ * (com a fração de ms acumulada), em vez de recuar do carimbo de cada lote,
+ * que tem o jitter do dreno e faria o tempo voltar entre lotes. O carimbo
+ * só reancora quando se afasta mais que PPG_TOL_MS (lacuna depois de
+ * overflow, deriva do oscilador do sensor) ou quando fs muda.
+ */
+#define PPG_TOL_MS  50
+
+static struct {
+    uint32_t t_ms;      // Tempo da próxima amostra
+    uint32_t resto;     // Fração de ms acumulada, em unidades de 1/fs ms
+    uint32_t ultimo;    // Tempo da última amostra gravada
+    uint16_t fs;        // 0 = ainda sem âncora
+} ppg_rel;
+
+static void series_grava(const sensor_slot_t *slot) {
+    for (unsigned i = 0; i < sizeof(series) / sizeof(series[0]); i++)
+        if (strcmp(series[i].sensor, slot->drv->name) == 0)
+            tseries_add(series[i].ch, slot->res.t_ms, slot->res.v[series[i].idx]);
 }
 
-void color_task(void) {
-    uint16_t c, r, g, b;
+static void series_ppg(uint32_t t0_ms, uint16_t fs, const max3010x_sample_t *s, int n) {
+    int32_t desvio = (int32_t)(t0_ms - ppg_rel.t_ms);
 
-    if (!tcs34725_init(&color,
-                       TCS34725_GAIN_16X,
-                       TCS34725_INTEGRATION_154MS)) {
-        printf("Erro TCS34725\n");
-        return;
+    if (fs == 0) return;
+    if (ppg_rel.fs != fs || desvio > PPG_TOL_MS || desvio < -PPG_TOL_MS) {
+        if (ppg_rel.fs == 0) ppg_rel.ultimo = t0_ms;
+        ppg_rel.t_ms = t0_ms;
+        ppg_rel.resto = 0;
+        ppg_rel.fs = fs;
     }
 
-    while (1) {
-        if (tcs34725_read_raw(&color, &c, &r, &g, &b)) {
-            printf("C:%u R:%u G:%u B:%u\n", c, r, g, b);
+    for (int i = 0; i < n; i++) {
+        // Reancorar para trás não pode recuar o que já foi gravado
+        uint32_t t = (int32_t)(ppg_rel.t_ms - ppg_rel.ultimo) < 0 ? ppg_rel.ultimo : ppg_rel.t_ms;
+
+        tseries_add(serie_ir, t, (int32_t)s[i].ir);
+        tseries_add(serie_red, t, (int32_t)s[i].red);
+        ppg_rel.ultimo = t;
+
+        ppg_rel.resto += 1000;
+        while (ppg_rel.resto >= fs) {
+            ppg_rel.resto -= fs;
+            ppg_rel.t_ms++;
         }
-        delay_ms(1000000);
     }
 }
 
-static bool contem_elemento(uint8_t vetor[], int tamanho, uint8_t busca) {
-    for (int i = 0; i < tamanho; i++) {
-        if (vetor[i] == busca) {
-            return true; // Encontrou!
+static void series_init(void) {
+    tseries_init();
+    for (unsigned i = 0; i < sizeof(series) / sizeof(series[0]); i++)
+        series[i].ch = tseries_channel(series[i].nome, SERIE_RAW);
+    serie_ir = tseries_channel("ppg_ir", SERIE_RAW_PPG);
+    serie_red = tseries_channel("ppg_red", SERIE_RAW_PPG);
+    sensor_registry_on_ready(series_grava);
+}
+
+/*
+ * Tendência dos últimos 10 min de cada canal, pelos baldes de 1 min. O que
+ * ainda não subiu está nos baldes abertos de cada nível (o de 1 min só tem os
+ * 10 s já fechados, o de 10 s só os segundos fechados), que são disjuntos.
+ */
+static void imprime_historico(void) {
+    uint32_t agora = time_get_ms();
+
+    for (int ch = 0; ch < tseries_stats()->channels; ch++) {
+        tseries_agg_span_t span;
+        tseries_agg_t a;
+        int32_t min = INT32_MAX, max = INT32_MIN;
+        int64_t soma = 0;
+        uint32_t n = 0;
+
+        tseries_agg(ch, TSERIES_TIER_1MIN, agora - 10 * 60000u, agora, &span);
+        for (uint32_t i = 0; i < tseries_agg_count(&span); i++) {
+            const tseries_agg_t *b = tseries_agg_at(&span, i);
+            if (b->min < min) min = b->min;
+            if (b->max > max) max = b->max;
+            soma += (int64_t)b->mean * b->n;
+            n += b->n;
         }
+        for (int tier = 0; tier < TSERIES_TIERS; tier++) {
+            if (!tseries_agg_open(ch, tier, &a)) continue;
+            if (a.min < min) min = a.min;
+            if (a.max > max) max = a.max;
+            soma += (int64_t)a.mean * a.n;
+            n += a.n;
+        }
+        if (n == 0) continue;
+        printf("%-10s min %ld med %ld max %ld (%lu amostras, 10 min)\n", tseries_name(ch),
+               (long)min, (long)(soma / n), (long)max, (unsigned long)n);
     }
-    return false; // Percorreu tudo e não achou
 }
 
+// ============================================
+// === Função de aplicação ===
+// ============================================
+
 static void scan_init(void) {
+    static bool tela_pronta = false;
     uint8_t devices[16];
-    int n = i2c_scan(devices, sizeof(devices));
+    int n;
 
-    if(n_sensores != n){
-        n_sensores = n;
-        gfx_fill_screen(ST77XX_BLACK);
-        cabecalho_tabela(); 
-    }
+    PROF_BEGIN("i2c_scan");
+    n = i2c_scan(devices, sizeof(devices));
+    PROF_END();
 
     if (n < 0) {
-        printf("I2C scan failed — assuming no devices\n");
-        n = 0;  // força remoção
+        log_linha("I2C scan failed (bus not idle: floating or stuck) — assuming no devices");
+    } else if (!telemetry_binary()) {
+        printf("I2C devices found: %d\n", n);
     }
 
-    // --- 1. REMOVER SENSORES QUE SUMIRAM ---
-    for (int j = 0; j < 16; j++) {
-        // Se existe um sensor registrado que NÃO apareceu no scan físico atual
-        if (sensores[j] != 0 && !contem_elemento(devices, n, sensores[j])) {
-            printf("Sensor removido: %02X\n", sensores[j]);
-            sensores[j] = 0;
-        }
+    // Liga/desliga sensores; qualquer mudança redesenha a tabela
+    if (sensor_registry_bind(devices, n) || !tela_pronta) {
+        tela_pronta = true;
+        limpa_tabela();
     }
+}
 
+static bool tela_nova;          // Tabela recém-limpa: linhas vazias por desenhar
+static uint8_t linhas_vazias;   // Bit i: o slot i mostra a linha "--"
 
-    // Se n=0, o laço de remoção abaixo já vai limpar o array sensores automaticamente
-    printf("I2C devices found: %d\n", n);
-
-    // --- 2. ADICIONAR E INICIALIZAR NOVOS SENSORES ---
-    for (int i = 0; i < n; i++) {
-        // Se o dispositivo físico NÃO está na nossa lista lógica, adicionamos
-        if (!contem_elemento(sensores, 16, devices[i])) {
-            
-            // Procura o primeiro slot vazio (0) para inserir
-            for (int k = 0; k < 16; k++) {
-                if (sensores[k] == 0) {
-                    sensores[k] = devices[i];
-                    printf("Novo dispositivo: %02X - ", devices[i]);
-                    
-                    // Inicialização específica
-                    switch (devices[i]) {
-                        case 0x23:
-                            printf("BH1750\n");
-                            if (!bh1750_init(&bh1750, BH1750_ADDR_LOW, BH1750_CONT_H_RES)) printf("Erro BH1750\n");
-                            break;
-                        case 0x57:
-                            printf("MAX3010x\n");
-                            if (!max3010x_init(&hr)) printf("Erro MAX3010x\n");
-                            break;
-                        case 0x29:
-                            printf("TCS34725\n");
-                            if (!tcs34725_init(&color, TCS34725_GAIN_16X, TCS34725_INTEGRATION_154MS)) printf("Erro TCS34725\n");
-                            break;
-                        case 0x38:
-                            printf("AHT10\n");
-                            if (!aht10_init()) printf("Erro AHT10\n");
-                            break;
-                        default:
-                            printf("Desconhecido\n");
-                            break;
-                    }
-                    break; // Sai do laço k, já ocupou o slot
-                }
-            }
-        }
-    }
-    
+static void limpa_tabela(void) {
+    gfx_fill_screen(ST77XX_BLACK);
+    cabecalho_tabela();
+    sensor_registry_republish();   // Tela limpa: todos redesenham na próxima leitura
+    tela_nova = true;
+    linhas_vazias = 0;
 }
 
 static void cabecalho_tabela(void){
@@ -323,156 +668,195 @@ static void cabecalho_tabela(void){
     gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
 }
 
+// Sensor ainda sem leitura: nome e "--" na altura da linha dele, para as
+// linhas de baixo não mudarem de lugar quando a primeira leitura chegar
+static void linha_vazia(const sensor_slot_t *slot, int pos_y, int prox_y) {
+    gfx_set_text_color(ST77XX_WHITE);
+    gfx_set_cursor(8, pos_y + 8);
+    gfx_print(slot->drv->name);
+    gfx_set_cursor(116, pos_y + 8);
+    gfx_print("--");
+    gfx_draw_fast_hline(0, prox_y, 320, ST77XX_WHITE);
+}
+
 static void imprime_tabela(void){
 
     int pos_y = 8 + 22;
-    char buf[16];
+    char linha[112];
 
-    if(contem_elemento(sensores, 16, 0x38) && false) {
-            
-        }
+    // A linha vazia não tem o layout do driver: a primeira leitura redesenha tudo
+    for (int i = 0; i < sensor_registry_count(); i++)
+        if (sensor_registry_slot(i)->res.valid && (linhas_vazias & (1u << i))) limpa_tabela();
+
+    for (int i = 0; i < sensor_registry_count(); i++) {
+        sensor_slot_t *slot = sensor_registry_slot(i);
 
-    // sensor BH1750 (luminosidade)
-    if(contem_elemento(sensores, 16, 0x23)) {
-        pos_y += 8;
-        gfx_set_cursor(18, pos_y);
-        gfx_print("BH1750");
-        gfx_set_cursor(116,pos_y);
-
-       // ativa a cor do background para apagar o texto anterior
-        gfx_set_text_color(ST77XX_BLACK);
-        snprintf(buf, sizeof(buf), "%lu", bh1750.lux_x100 / 100);
-        gfx_print(buf);
-        gfx_print(".");
-        snprintf(buf, sizeof(buf), "%02lu", bh1750.lux_x100 % 100);
-        gfx_print(buf);
-        gfx_print(" Lux");
-
-        // realiza uma nova leitura
-        lux();
-        // volta a cor do texto para branco
-        gfx_set_text_color(ST77XX_WHITE);
-        gfx_set_cursor(116,pos_y);
-        snprintf(buf, sizeof(buf), "%lu", bh1750.lux_x100 / 100);
-        gfx_print(buf);
-        gfx_print(".");
-        snprintf(buf, sizeof(buf), "%02lu", bh1750.lux_x100 % 100);
-        gfx_print(buf);
-        gfx_print(" Lux");
-        pos_y += 22;
-        gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
-        printf("Iluminancia: %lu.%02lu lx\n", bh1750.lux_x100 / 100, bh1750.lux_x100 % 100);
+        // Sem leitura não há publicação (fresh): render() só devolve a altura
+        if (!slot->res.valid) {
+            int prox_y = slot->drv->render ? slot->drv->render(slot, pos_y) : pos_y;
+
+            if (tela_nova && prox_y > pos_y) {
+                linha_vazia(slot, pos_y, prox_y);
+                linhas_vazias |= 1u << i;
+            }
+            pos_y = prox_y;
+            continue;
+        }
+        if (slot->drv->render) pos_y = slot->drv->render(slot, pos_y);
+        if (slot->fresh) telemetry_sensor(slot->drv->name, &slot->res);   // UART e/ou flash
+        if (slot->fresh && !telemetry_binary() && slot->drv->format) {
+            slot->drv->format(slot, linha, sizeof(linha));
+            printf("%s\n", linha);
+        }
+        slot->fresh = false;
     }
-    if (contem_elemento(sensores, 16, 0x57))
-    {
-        gfx_draw_line(180, pos_y, 180, pos_y + 8 + 22 * 2, ST77XX_WHITE);
-        gfx_draw_line(180 + 70, pos_y, 180 + 70, pos_y + 8 + 22 * 2, ST77XX_WHITE);
-        pos_y += 8;
-        gfx_set_cursor(116 + 12, pos_y);
-        gfx_print("BPM");
-        gfx_set_cursor(116 + 12 + 6 + 70, pos_y);
-        gfx_print("IR");
-        gfx_set_cursor(116 + 12 + 140, pos_y);
-        gfx_print("RED");
-        pos_y += 12;
-        gfx_set_cursor(8, pos_y);
-        gfx_print("MAX3010x");
-        pos_y += 8;
-        gfx_draw_line(110, pos_y, 320, pos_y, ST77XX_WHITE);
-        pos_y += 4;
-        // apaga os valores antigos
-        gfx_set_text_color(ST77XX_BLACK);
-        gfx_set_cursor(116 + 12, pos_y);
-        snprintf(buf, sizeof(buf), "%d", hr.bpm);
-        gfx_print(buf);
-        gfx_set_cursor(116 + 70, pos_y);
-        snprintf(buf, sizeof(buf), "%lu", hr.ir_value >> 10);
-        gfx_print(buf);
-        gfx_set_cursor(116 + 140, pos_y);
-        snprintf(buf, sizeof(buf), "%lu", hr.red_value >> 10);
-        gfx_print(buf);
-        // volta a cor do texto para branco
-        gfx_set_text_color(ST77XX_WHITE);
-        heart_rate();
-        gfx_set_cursor(116 + 12, pos_y);
-        snprintf(buf, sizeof(buf), "%d", hr.bpm);
-        gfx_print(buf);
-        gfx_set_cursor(116 + 70, pos_y);
-        snprintf(buf, sizeof(buf), "%lu", hr.ir_value >> 10);
-        gfx_print(buf);
-        gfx_set_cursor(116 + 140, pos_y);
-        snprintf(buf, sizeof(buf), "%lu", hr.red_value >> 10);
-        gfx_print(buf);
-        pos_y += 22;
-        gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
-
-        printf("IR:%lu RED:%lu BPM:%d\n", hr.ir_value, hr.red_value, hr.bpm);
+    tela_nova = false;
+}
+
+// Uma linha por frame: idade de cada canal e o espalhamento da janela
+static void imprime_frame(const sensor_frame_t *f) {
+    printf("Frame %lu: janela %lu ms skew %lu us%s |", (unsigned long)f->seq,
+           (unsigned long)f->window_ms, (unsigned long)f->skew_us,
+           f->timeout ? " (timeout)" : "");
+    for (int i = 0; i < f->n; i++) {
+        const sensor_channel_t *c = &f->ch[i];
+
+        if (!c->valid) {
+            printf(" %s: -", c->name);
+            continue;
+        }
+        printf(" %s%s: %lu ms", c->name, c->synced ? "*" : "",
+               (unsigned long)(c->age_us / 1000));
     }
-    if (contem_elemento(sensores, 16, 0x29))
-    {
-        uint16_t c, r, g, b;
-        uint16_t color565;
-
-        pos_y += 8;
-        gfx_set_text_color(ST77XX_BLACK);
-        gfx_set_cursor(116, pos_y);
-        sprintf(buf, "R:%u", r >> 8);
-        gfx_print(buf);
-        pos_y += 24;
-        gfx_set_cursor(116, pos_y);
-        sprintf(buf, "G:%u", g >> 8);
-        gfx_print(buf);
-        pos_y += 24;
-        gfx_set_cursor(116, pos_y);
-        sprintf(buf, "B:%u", b >> 8);
-        gfx_print(buf);
-
-        if (tcs34725_read_raw(&color, &c, &r, &g, &b))
-        {
-            // color565 = rgb_to_565(r, g, b);
-
-            color565 = rgb_to_565_norm(c, r, g, b);
-
-            // color565 = rgb_to_565_gamma(c, r, g, b);
-
-            // color565 = rgb_to_565_wb_gamma(c, r, g, b);
-
-            pos_y -= 48;
-            gfx_set_text_color(ST77XX_WHITE);
-            gfx_fill_rect(185, pos_y, 125, 24 * 3 - 11, color565);
-            gfx_set_cursor(116, pos_y);
-            sprintf(buf, "R:%u", r >> 8);
-            gfx_print(buf);
-            pos_y += 24;
-            gfx_set_cursor(8, pos_y);
-            gfx_print("TCS34725");
-            gfx_set_cursor(116, pos_y);
-            sprintf(buf, "G:%u", g >> 8);
-            gfx_print(buf);
-            pos_y = pos_y + 24;
-            gfx_set_cursor(116, pos_y);
-            sprintf(buf, "B:%u", b >> 8);
-            gfx_print(buf);
-            pos_y += 22;
-            gfx_draw_fast_hline(0, pos_y, 320, ST77XX_WHITE);
-
-            printf("R:%u G:%u B:%u RGB565:0x%04X\n", r, g, b, color565);
+    if (uart_log_dropped())
+        printf(" | console: %lu B descartados", (unsigned long)uart_log_dropped());
+    printf("\n");
+}
+
+// Gravação na flash: os mesmos registros da telemetria vão para o flashlog
+static void gravacao(bool on) {
+    telemetry_set_sink(NULL);   // Fecha o lote de PPG aberto no destino antigo
+    flashlog_record(on);
+    if (flashlog_recording()) telemetry_set_sink(flashlog_append);
+    log_linha(flashlog_recording() ? "Flashlog: gravando" : "Flashlog: parado");
+}
+
+// Estatística de cada valor desde o bind e quanto a publicação por exceção
+// segurou (leituras que não foram para tela/serial/telemetria)
+static void imprime_estatisticas(void) {
+    for (int i = 0; i < sensor_registry_count(); i++) {
+        const sensor_slot_t *slot = sensor_registry_slot(i);
+        int nv = slot->drv->report ? slot->drv->report->nv : 4;
+
+        printf("%s: %lu publicadas, %lu seguradas\n", slot->drv->name,
+               (unsigned long)slot->report.published, (unsigned long)slot->report.suppressed);
+        for (int k = 0; k < nv; k++) {
+            const stream_stats_t *st = &slot->stats[k];
+            printf("  v%d: n %lu med %ld dp %lu min %ld max %ld ewma %ld\n", k,
+                   (unsigned long)st->n, (long)stream_stats_mean(st),
+                   (unsigned long)stream_stats_stddev(st), (long)st->min, (long)st->max,
+                   (long)stream_stats_ewma(st));
         }
     }
 }
 
+// Ciclos dos caminhos quentes, frio (caches invalidados, tudo vem da
+// memória) e quente (segunda passada). Antes/depois: comparar com um build
+// `make clean && make FASTMEM=0`, que deixa o mesmo código na main_ram.
+typedef void (*kernel_fn)(void);
+
+static max3010x_ctx_t dsp_copia;
+static max3010x_sample_t dsp_bloco[32];
+static uint8_t scan_achados[16];
+
+static void k_i2c(void)  { i2c_scan(scan_achados, sizeof(scan_achados)); }
+static void k_fill(void) { gfx_fill_rect(0, 0, 320, 30, ST77XX_BLUE); }
+static void k_dsp(void)  { max3010x_process_block(&dsp_copia, dsp_bloco, 32); }
+
+static void mede_kernel(const char *nome, kernel_fn fn) {
+    uint64_t t0, frio, quente;
+
+    flush_cpu_icache();
+    flush_cpu_dcache();
+    t0 = time_get_cycles();
+    fn();
+    frio = time_get_cycles() - t0;
+
+    t0 = time_get_cycles();
+    fn();
+    quente = time_get_cycles() - t0;
+
+    printf("  %-10s frio %8lu  quente %8lu ciclos\n", nome,
+           (unsigned long)frio, (unsigned long)quente);
+}
+
+static void mede_fastmem(void) {
+    // PPG sintético em torno da última leitura, numa cópia do contexto
+    dsp_copia = hr;
+    for (int i = 0; i < 32; i++) {
+        dsp_bloco[i].ir = hr.ir_value + (uint32_t)(i & 7) * 64;
+        dsp_bloco[i].red = hr.red_value + (uint32_t)(i & 7) * 48;
+    }
+
+    printf("fastmem: FASTMEM=%d, .fastcode %lu B, .fastdata %lu B\n", FASTMEM,
+           (unsigned long)fastmem_code_bytes(), (unsigned long)fastmem_data_bytes());
+    mede_kernel("i2c scan", k_i2c);
+    mede_kernel("fill 320x30", k_fill);
+    mede_kernel("dsp 32", k_dsp);
+    cabecalho_tabela();   // O fill pintou por cima do cabeçalho
+}
+
+// 'b' liga a telemetria binária, 't' volta ao texto; 'r' liga/desliga a
+// gravação na flash, 'x' exporta o log pela UART (em quadros binários);
+// 'h' resume os últimos 10 min das séries na SDRAM, 'e' as estatísticas
+// por canal, 'm' mede os caminhos quentes (fastmem), 'p' imprime o perfil
+// por região (PROF_BEGIN/END) e 'z' zera as contagens; 'k' liga/desliga a
+// amostragem de PC e 'd' despeja o histograma (tools/pcprof.py)
+static void comandos_uart(void) {
+    if (!uart_read_nonblock()) return;
+
+    switch (uart_read()) {
+    case 'b': telemetry_set_mode(TELEMETRY_BINARY); break;
+    case 't': telemetry_set_mode(TELEMETRY_TEXT);   break;
+    case 'r': gravacao(!flashlog_recording());      break;
+    case 'h': if (!telemetry_binary()) imprime_historico(); break;
+    case 'e': if (!telemetry_binary()) imprime_estatisticas(); break;
+    case 'm': if (!telemetry_binary()) mede_fastmem(); break;
+    case 'p': if (!telemetry_binary()) prof_dump(); break;
+    case 'k':
+        if (pcprof_running()) pcprof_stop();
+        else if (!pcprof_start()) log_linha("PC sampling: SoC sem timer1 (--with-pc-sampler)");
+        break;
+    case 'd': if (!telemetry_binary()) pcprof_dump(); break;
+    case 'z': prof_reset(); break;
+    case 'x':
+        telemetry_set_sink(NULL);
+        telemetry_set_mode(TELEMETRY_BINARY);
+        flashlog_export_start();
+        // Só o log gravado na linha até o fim do export (ver o laço)
+        telemetry_hold(flashlog_exporting());
+        break;
+    default: break;
+    }
+}
+
 // ============================================
 // === main ===
 // ============================================
 
 int main(void) {
 
+    fastmem_init();   // Antes de qualquer ISR ou driver marcado FAST_CODE
+    prof_init();
+    pcprof_init();
+
 #ifdef CONFIG_CPU_HAS_INTERRUPT
     irq_setmask(0);
     irq_setie(1);
 #endif
 
     uart_init();
+    uart_log_init();   // printf sem espera: buffer + IRQ de TX
 
     bb_i2c_init();
 
@@ -484,6 +868,9 @@ int main(void) {
     gfx_set_text_size(2);
     gfx_set_text_color(ST77XX_WHITE);
 
+    // Conversão de cor do TCS34725: COLOR565_RAW, _NORM, _GAMMA ou _WB_GAMMA
+    color565_set_mode(COLOR565_NORM);
+
 #ifdef CSR_TIMER0_BASE
     timer0_en_write(0);
     timer0_reload_write(0);
@@ -493,11 +880,50 @@ int main(void) {
 #endif
 
 
+    telemetry_init();
+    if (!flashlog_init()) log_linha("Flashlog indisponivel");
+    sensor_registry_init(drivers, sizeof(drivers) / sizeof(drivers[0]));
+    sensor_registry_on_log(log_linha);   // Hot-plug sem quebrar a telemetria binária
+    series_init();
+    sensor_frame_init(FRAME_PERIOD_MS, FRAME_MARGIN_MS);
+
+    uint32_t prox_scan = time_get_ms();
+    uint32_t prox_tela = prox_scan;
+
+    // Sensores por streaming/evento andam no próprio período; os com
+    // trigger convertem juntos na janela do frame. Scan e tela têm os
+    // seus períodos, sem esperas bloqueantes no laço.
     while (1) {
-        scan_init();
-        imprime_tabela();
-    delay_ms(100000);
-}
+        static sensor_frame_t frame;
+        uint32_t agora = time_get_ms();
+
+        PROF_BEGIN("main_loop");   // Ciclos por volta (tools/sim_run.py)
+
+        if (sensor_time_reached(agora, prox_scan)) {
+            prox_scan = agora + SCAN_PERIOD_MS;
+            scan_init();
+        }
+
+        sensor_registry_run();
+
+        if (sensor_frame_poll(&frame) && !telemetry_binary()) imprime_frame(&frame);
+
+        // Um passo de erase/program por volta; o export anda pela folga do console
+        flashlog_poll();
+        if (flashlog_exporting() && !flashlog_export_step(telemetry_send_raw))
+            telemetry_hold(false);   // Fim do export: volta a telemetria ao vivo
+
+        if (sensor_time_reached(agora, prox_tela)) {
+            prox_tela = agora + TELA_PERIOD_MS;
+            imprime_tabela();
+        }
+
+        PROF_END();
+
+        // Fora da região: 'p' imprime o relatório e 'z' o zera; o sim_run.py
+        // os pede o tempo todo e eles não podem entrar no custo da volta
+        comandos_uart();
+    }
 
     return 0;
 }
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+#
+# bench_run.py - Coleta os resultados da imagem de benchmark (firmware/bench)
+#
+# Lê o bloco CSV entre "BENCH BEGIN" e "BENCH END" da placa (porta serial com
+# pyserial; o script envia 'r' para repetir a rodada), de um arquivo capturado
+# ou do stdin, ou roda a simulação (litex/colorlight_i5_sim.py) para cada
+# combinação de variante de CPU e tamanho de L2. Tudo sai num só CSV, uma
+# linha por núcleo e configuração:
+#   target,cpu_variant,l2,kernel,param,ok,reps,units,cycles_min,cycles_mean,cycles_per_unit
+#
+# Uso:
+#   python3 tools/bench_run.py /dev/ttyUSB0 -o placa.csv
+#   python3 tools/bench_run.py captura.txt -o placa.csv
+#   python3 tools/bench_run.py --sim --variants standard,full,lite --l2 0,8192,32768 -o sim.csv
+#
+# Na simulação, cada configuração gera os headers do SoC em build/sim_<variante>_<l2>,
+# recompila a imagem contra eles (make clean bench BUILD_DIR=...) e roda o
+# Verilator com a imagem pré-carregada na SDRAM até o fim do bloco. Passe
+# COREMARK_DIR no ambiente para incluir o CoreMark.
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+
+BEGIN_RE = re.compile(r"BENCH BEGIN (.*)$")
+FIELDS = ["kernel", "param", "ok", "reps", "units", "cycles_min", "cycles_mean", "cycles_per_unit"]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+FIRMWARE = os.path.normpath(os.path.join(HERE, ".."))
+REPO = os.path.normpath(os.path.join(FIRMWARE, ".."))
+SIM = os.path.join(REPO, "litex", "colorlight_i5_sim.py")
+
+# ----------------------------------------------------------------------------
+# Bloco de resultados
+# ----------------------------------------------------------------------------
+
+class Block:
+    def __init__(self):
+        self.header = {}
+        self.rows = []
+        self.done = False
+
+
+def parse_header(text):
+    """ident="..." cpu=X clk=N ... -> dict"""
+    return dict((k, v.strip('"')) for k, v in re.findall(r'(\w+)=("[^"]*"|\S+)', text))
+
+
+def feed(block, line):
+    """Alimenta uma linha; devolve o bloco corrente (None antes do BEGIN)."""
+    line = line.strip()
+    m = BEGIN_RE.search(line)
+    if m:
+        block = Block()
+        block.header = parse_header(m.group(1))
+        return block
+    if block is None or block.done:
+        return block
+    if line.startswith("BENCH END"):
+        block.done = True
+    elif line and not line.startswith("kernel,"):
+        parts = line.split(",")
+        if len(parts) == len(FIELDS):
+            block.rows.append(dict(zip(FIELDS, parts)))
+    return block
+
+
+def parse_lines(lines):
+    block = None
+    last = None
+    for line in lines:
+        block = feed(block, line)
+        if block is not None and block.done:
+            last = block
+    return last
+
+# ----------------------------------------------------------------------------
+# Fontes
+# ----------------------------------------------------------------------------
+
+def read_serial(port, baud, timeout):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial não instalado (pip install pyserial)")
+
+    block = None
+    with serial.Serial(port, baud, timeout=timeout) as s:
+        s.reset_input_buffer()
+        s.write(b"r")
+        while True:
+            raw = s.readline()
+            if not raw:
+                break   # Timeout sem fim de bloco
+            block = feed(block, raw.decode("ascii", "replace"))
+            if block is not None and block.done:
+                return block
+    return None
+
+
+def read_input(src, baud, timeout):
+    if src == "-":
+        return parse_lines(sys.stdin)
+    if src.startswith("/dev/") or src.upper().startswith("COM"):
+        return read_serial(src, baud, timeout)
+    with open(src, "r", errors="replace") as f:
+        return parse_lines(f)
+
+
+def run(cmd, **kw):
+    sys.stderr.write("$ %s\n" % " ".join(cmd))
+    subprocess.run(cmd, check=True, **kw)
+
+
+def run_sim(variant, l2, cpu_type, extra):
+    out = os.path.join(REPO, "build", "sim_%s_%d" % (variant, l2))
+    base = [sys.executable, SIM, "--cpu-type", cpu_type, "--cpu-variant", variant,
+            "--l2-cache-size", str(l2), "--output-dir", out] + extra
+
+    # Headers do SoC simulado e a imagem compilada contra eles
+    run(base + ["--no-compile-gateware"], stdout=subprocess.DEVNULL)
+    run(["make", "-C", FIRMWARE, "clean"], stdout=subprocess.DEVNULL)
+    run(["make", "-C", FIRMWARE, "bench", "BUILD_DIR=" + out], stdout=subprocess.DEVNULL)
+
+    # Verilator com a imagem na SDRAM: lê a console até o fim do bloco
+    cmd = base + ["--sdram-init", os.path.join(FIRMWARE, "bench.bin"), "--non-interactive"]
+    sys.stderr.write("$ %s\n" % " ".join(cmd))
+    p = subprocess.Popen(cmd, stdout=subprocess.PIPE, stdin=subprocess.DEVNULL,
+                         text=True, errors="replace")
+    block = None
+    try:
+        for line in p.stdout:
+            block = feed(block, line)
+            if block is not None and block.done:
+                break
+    finally:
+        p.terminate()
+        p.wait()
+    return block if block is not None and block.done else None
+
+# ----------------------------------------------------------------------------
+# Saída
+# ----------------------------------------------------------------------------
+
+def emit(writer, target, variant, l2, block):
+    for r in block.rows:
+        writer.writerow(dict(r, target=target, cpu_variant=variant, l2=l2))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Resultados da imagem de benchmark do firmware")
+    ap.add_argument("src", nargs="?", help="porta serial, arquivo capturado ou - para stdin")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("-t", "--timeout", type=float, default=30.0, help="espera pelo bloco na serial (s)")
+    ap.add_argument("-o", "--output", default="-", help="CSV de saída (padrão: stdout)")
+    ap.add_argument("--sim", action="store_true", help="roda na simulação em vez de ler a placa")
+    ap.add_argument("--cpu-type", default="vexriscv")
+    ap.add_argument("--variants", default="standard", help="variantes de CPU, separadas por vírgula")
+    ap.add_argument("--l2", default="8192", help="tamanhos de L2 em bytes, separados por vírgula")
+    ap.add_argument("--sim-arg", action="append", default=[], help="argumento extra para o colorlight_i5_sim.py")
+    args = ap.parse_args()
+
+    if not args.sim and not args.src:
+        ap.error("informe a porta/arquivo ou --sim")
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w", newline="")
+    writer = csv.DictWriter(out, fieldnames=["target", "cpu_variant", "l2"] + FIELDS)
+    writer.writeheader()
+
+    failed = 0
+    if args.sim:
+        for variant in args.variants.split(","):
+            for l2 in (int(x) for x in args.l2.split(",")):
+                block = run_sim(variant, l2, args.cpu_type, args.sim_arg)
+                if block is None:
+                    sys.stderr.write("%s/L2 %d: sem bloco BENCH completo\n" % (variant, l2))
+                    failed += 1
+                    continue
+                emit(writer, "sim", variant, l2, block)
+                out.flush()
+    else:
+        block = read_input(args.src, args.baud, args.timeout)
+        if block is None:
+            sys.exit("bloco BENCH BEGIN/END não encontrado")
+        emit(writer, "board", "", block.header.get("l2", ""), block)
+
+    if out is not sys.stdout:
+        out.close()
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
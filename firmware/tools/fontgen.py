@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# fontgen.py - Gera as tabelas de fontes extras da biblioteca GFX (gfx_fonts.c)
+#
+# As fontes são geradas offline a partir da glcdfont 5x7 definida em gfx.c:
+#   - gfx_font_10x14 : fonte fixa grande (glcdfont ampliada com Scale2x/EPX,
+#                      que suaviza diagonais em vez de replicar pixels)
+#   - gfx_font_prop  : fonte proporcional (glcdfont com colunas vazias removidas)
+#   - gfx_font_seg7  : numerais estilo display de 7 segmentos (BPM, lux)
+#
+# Os glifos são gravados como bitmasks row-major: cada linha ocupa
+# ceil(largura / 8) bytes, com o bit mais significativo sendo o pixel da
+# esquerda. Assim o desenho expande cada linha direto em pixels RGB565.
+#
+# Uso:
+#   python3 tools/fontgen.py incs/gfx/gfx.c > incs/gfx/gfx_fonts.c
+
+import re
+import sys
+
+# ----------------------------------------------------------------------------
+# Leitura da glcdfont (5 colunas por caractere, bit 0 = linha de cima)
+# ----------------------------------------------------------------------------
+
+def load_glcdfont(path):
+    src = open(path, encoding="utf-8").read()
+    body = re.search(r"glcdfont\[\]\s*=\s*\{(.*?)\};", src, re.S).group(1)
+    body = re.sub(r"//[^\n]*", "", body)
+    data = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]{2}", body)]
+    assert len(data) == 95 * 5, "glcdfont incompleta"
+    glyphs = {}
+    for i in range(95):
+        cols = data[i * 5:(i + 1) * 5]
+        glyphs[0x20 + i] = [[(cols[x] >> y) & 1 for x in range(5)] for y in range(8)]
+    return glyphs
+
+# ----------------------------------------------------------------------------
+# Transformações
+# ----------------------------------------------------------------------------
+
+def scale2x(rows):
+    h, w = len(rows), len(rows[0])
+    px = lambda x, y: rows[y][x] if 0 <= x < w and 0 <= y < h else 0
+    out = [[0] * (w * 2) for _ in range(h * 2)]
+    for y in range(h):
+        for x in range(w):
+            p = px(x, y)
+            a, b, c, d = px(x, y - 1), px(x + 1, y), px(x - 1, y), px(x, y + 1)
+            e0 = e1 = e2 = e3 = p
+            if b != c and a != d:
+                e0 = a if c == a else p
+                e1 = b if a == b else p
+                e2 = c if d == c else p
+                e3 = d if b == d else p
+            out[2 * y][2 * x], out[2 * y][2 * x + 1] = e0, e1
+            out[2 * y + 1][2 * x], out[2 * y + 1][2 * x + 1] = e2, e3
+    return out
+
+def trim(rows):
+    w = len(rows[0])
+    used = [x for x in range(w) if any(r[x] for r in rows)]
+    if not used:
+        return [[] for _ in rows]
+    return [r[used[0]:used[-1] + 1] for r in rows]
+
+SEG7_W, SEG7_H, SEG7_T = 10, 16, 2
+
+def seg7(segments):
+    w, h, t = SEG7_W, SEG7_H, SEG7_T
+    mid = h // 2 - t // 2
+    rows = [[0] * w for _ in range(h)]
+    def fill(x0, y0, x1, y1):
+        for y in range(y0, y1):
+            for x in range(x0, x1):
+                rows[y][x] = 1
+    boxes = {
+        "a": (t, 0, w - t, t),
+        "b": (w - t, t, w, mid),
+        "c": (w - t, mid + t, w, h - t),
+        "d": (t, h - t, w - t, h),
+        "e": (0, mid + t, t, h - t),
+        "f": (0, t, t, mid),
+        "g": (t, mid, w - t, mid + t),
+    }
+    for s in segments:
+        fill(*boxes[s])
+    return rows
+
+SEG7_DIGITS = {
+    "0": "abcdef", "1": "bc",     "2": "abdeg", "3": "abcdg",  "4": "bcfg",
+    "5": "acdfg",  "6": "acdefg", "7": "abc",   "8": "abcdefg", "9": "abcdfg",
+    "-": "g",
+}
+
+def seg7_dot(dots):
+    rows = [[0] * SEG7_T for _ in range(SEG7_H)]
+    for y0 in dots:
+        for y in range(y0, y0 + SEG7_T):
+            rows[y] = [1] * SEG7_T
+    return rows
+
+# ----------------------------------------------------------------------------
+# Emissão em C
+# ----------------------------------------------------------------------------
+
+def pack(rows):
+    out = []
+    for r in rows:
+        nbytes = (len(r) + 7) // 8
+        v = 0
+        for x, bit in enumerate(r):
+            v |= bit << (nbytes * 8 - 1 - x)
+        out += [(v >> (8 * (nbytes - 1 - i))) & 0xFF for i in range(nbytes)]
+    return out
+
+def emit(name, desc, first, last, height, y_advance, glyphs):
+    bitmap, table = [], []
+    for code in range(first, last + 1):
+        rows, advance = glyphs.get(code, ([], 0))
+        width = len(rows[0]) if rows and rows[0] else 0
+        table.append((len(bitmap), width, advance, code))
+        if width:
+            bitmap += pack(rows)
+    print("/* %s */" % desc)
+    print("static const uint8_t %s_bitmap[] = {" % name)
+    for i in range(0, len(bitmap), 16):
+        print("    " + ", ".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",")
+    print("};\n")
+    print("static const gfx_glyph_t %s_glyphs[] = {" % name)
+    for off, width, advance, code in table:
+        ch = chr(code) if chr(code) not in "\\'" else "\\" + chr(code)
+        print("    { %4d, %2d, %2d }, // 0x%02X '%s'" % (off, width, advance, code, ch))
+    print("};\n")
+    print("const gfx_font_t %s = {" % name)
+    print("    %s_bitmap, %s_glyphs, 0x%02X, 0x%02X, %d, %d" %
+          (name, name, first, last, height, y_advance))
+    print("};\n")
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else "incs/gfx/gfx.c"
+    glcd = load_glcdfont(src)
+
+    print("/*")
+    print(" * gfx_fonts.c - Fontes extras da biblioteca GFX")
+    print(" * ARQUIVO GERADO por tools/fontgen.py - NÃO EDITE À MÃO.")
+    print(" */\n")
+    print('#include "gfx_font.h"\n')
+
+    big = {c: (scale2x(g[:7]), 12) for c, g in glcd.items()}
+    emit("gfx_font_10x14", "Fonte fixa 10x14 (glcdfont + Scale2x)",
+         0x20, 0x7E, 14, 16, big)
+
+    prop = {}
+    for c, g in glcd.items():
+        rows = trim(g)
+        width = len(rows[0])
+        prop[c] = (rows, width + 1 if width else 3)
+    emit("gfx_font_prop", "Fonte proporcional 5x7 (glcdfont sem colunas vazias)",
+         0x20, 0x7E, 8, 10, prop)
+
+    digits = {ord(c): (seg7(s), SEG7_W + 2) for c, s in SEG7_DIGITS.items()}
+    digits[ord(" ")] = ([], SEG7_W + 2)
+    digits[ord(".")] = (seg7_dot([SEG7_H - SEG7_T]), SEG7_T + 2)
+    digits[ord(":")] = (seg7_dot([SEG7_H // 4, 3 * SEG7_H // 4 - SEG7_T]), SEG7_T + 2)
+    emit("gfx_font_seg7", "Numerais 7 segmentos 10x16 (' ', '-', '.', ':' e '0'-'9')",
+         0x20, 0x3A, SEG7_H, SEG7_H + 4, digits)
+
+if __name__ == "__main__":
+    main()
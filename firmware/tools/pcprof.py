@@ -0,0 +1,307 @@
+#!/usr/bin/env python3
+#
+# pcprof.py - Resolve o histograma de PCs do firmware (incs/pcprof)
+#
+# Lê o despejo de texto da UART (porta serial com pyserial, arquivo capturado
+# ou stdin), acha o bloco entre "PCPROF BEGIN" e "PCPROF END" e atribui cada
+# endereço à função que o contém, usando a tabela de símbolos do main.elf
+# (nm) ou, sem binutils RISC-V, o main.elf.map. O objeto de cada função sai
+# das seções de entrada do map (.text.<função> de cada .o).
+#
+# Saídas:
+#   perfil plano      função, amostras, %, objeto (padrão)
+#   --addr N          os N endereços mais quentes como função+offset
+#   --folded ARQ      linhas "objeto;função contagem" para o flamegraph.pl
+#
+# Uso:
+#   python3 tools/pcprof.py /dev/ttyUSB0 -b 115200
+#   python3 tools/pcprof.py captura.txt --elf main.elf --map main.elf.map
+#   python3 tools/pcprof.py captura.txt --folded perfil.folded
+#   flamegraph.pl perfil.folded > perfil.svg
+#
+# Com uma porta serial, o script envia 'd' e espera o bloco. A amostragem é
+# ligada/desligada no firmware com 'k'. Sem ponteiro de quadro não há como
+# desenrolar a pilha: a "pilha" do flamegraph é objeto;função.
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+# ----------------------------------------------------------------------------
+# Despejo
+# ----------------------------------------------------------------------------
+
+BEGIN_RE = re.compile(r"PCPROF BEGIN hz=(\d+) samples=(\d+) other=(\d+)")
+LINE_RE = re.compile(r"^([0-9a-fA-F]{8})\s+(\d+)\s*$")
+
+
+def parse_dump(lines):
+    """Devolve (hz, samples, other, {endereço: contagem}) do último bloco."""
+    result = None
+    cur = None
+    for line in lines:
+        line = line.strip()
+        m = BEGIN_RE.search(line)
+        if m:
+            cur = (int(m.group(1)), int(m.group(2)), int(m.group(3)), {})
+            continue
+        if cur is None:
+            continue
+        if line.startswith("PCPROF END"):
+            result = cur
+            cur = None
+            continue
+        m = LINE_RE.match(line)
+        if m:
+            addr = int(m.group(1), 16)
+            cur[3][addr] = cur[3].get(addr, 0) + int(m.group(2))
+    return result
+
+
+def read_serial(port, baud, timeout):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial não instalado (pip install pyserial)")
+
+    lines = []
+    with serial.Serial(port, baud, timeout=timeout) as s:
+        s.reset_input_buffer()
+        s.write(b"d")
+        started = False
+        while True:
+            raw = s.readline()
+            if not raw:
+                break   # Timeout sem fim de bloco
+            line = raw.decode("ascii", "replace")
+            if "PCPROF BEGIN" in line:
+                started = True
+            if started:
+                lines.append(line)
+                if line.startswith("PCPROF END"):
+                    break
+    return lines
+
+
+def read_input(src, baud, timeout):
+    if src == "-":
+        return sys.stdin.read().splitlines()
+    if src.startswith("/dev/") or src.upper().startswith("COM"):
+        return read_serial(src, baud, timeout)
+    with open(src, "r", errors="replace") as f:
+        return f.read().splitlines()
+
+# ----------------------------------------------------------------------------
+# Símbolos
+# ----------------------------------------------------------------------------
+
+NM_CANDIDATES = ("riscv64-unknown-elf-nm", "riscv32-unknown-elf-nm",
+                 "riscv64-linux-gnu-nm", "llvm-nm")
+
+
+def find_nm():
+    env = os.environ.get("NM")
+    if env:
+        return env
+    for name in NM_CANDIDATES:
+        if shutil.which(name):
+            return name
+    return None
+
+
+def symbols_from_elf(elf):
+    """[(endereço, tamanho ou None, nome)] das funções, via nm."""
+    nm = find_nm()
+    if nm is None or not os.path.exists(elf):
+        return None
+    try:
+        out = subprocess.run([nm, "-n", "-S", "--defined-only", elf],
+                             capture_output=True, text=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+    syms = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4:
+            addr, size, kind, name = parts
+            size = int(size, 16)
+        elif len(parts) == 3:
+            addr, kind, name = parts
+            size = None
+        else:
+            continue
+        if kind in "tTwW":
+            syms.append((int(addr, 16), size, name))
+    return syms
+
+
+# Seção de entrada do map, numa linha ou quebrada em duas quando o nome é longo:
+#  .text.i2c_scan
+#                 0x40001234       0x58 incs/i2c/i2c.o
+SECTION_RE = re.compile(r"^ (\.text\S*|\.fastcode\S*)\s*(?:(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+))?\s*$")
+CONT_RE = re.compile(r"^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+)\s*$")
+SYMBOL_RE = re.compile(r"^\s+(0x[0-9a-f]+)\s+([A-Za-z_.$][\w.$]*)\s*$")
+
+
+def parse_map(path):
+    """(símbolos [(endereço, None, nome)], seções [(início, fim, objeto)])."""
+    syms = []
+    sections = []
+    if not path or not os.path.exists(path):
+        return syms, sections
+
+    pending = False
+    in_code = False
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            m = SECTION_RE.match(line)
+            if m:
+                pending = m.group(2) is None
+                if not pending:
+                    in_code = _add_section(sections, m.group(2), m.group(3), m.group(4))
+                continue
+            if pending:
+                pending = False
+                m = CONT_RE.match(line)
+                if m:
+                    in_code = _add_section(sections, m.group(1), m.group(2), m.group(3))
+                    continue
+            if line.startswith(" .") or line.startswith("."):
+                in_code = False   # Outra seção de entrada (.rodata, .data, ...)
+                continue
+            m = SYMBOL_RE.match(line)
+            if m and in_code:
+                syms.append((int(m.group(1), 16), None, m.group(2)))
+
+    syms.sort()
+    sections.sort()
+    return syms, sections
+
+
+def _add_section(sections, addr, size, obj):
+    start, size = int(addr, 16), int(size, 16)
+    if size == 0 or start == 0:
+        return False
+    sections.append((start, start + size, os.path.basename(obj)))
+    return True
+
+
+class Resolver:
+    def __init__(self, syms, sections):
+        self.syms = sorted(syms, key=lambda s: s[0])
+        self.addrs = [s[0] for s in self.syms]
+        self.sections = sections
+        self.sec_starts = [s[0] for s in sections]
+
+    def function(self, addr):
+        """(nome, offset) ou (None, 0)."""
+        i = _bisect(self.addrs, addr)
+        if i < 0:
+            return None, 0
+        start, size, name = self.syms[i]
+        if size is not None and addr >= start + size:
+            return None, 0
+        return name, addr - start
+
+    def object(self, addr):
+        i = _bisect(self.sec_starts, addr)
+        if i < 0:
+            return "?"
+        start, end, obj = self.sections[i]
+        return obj if addr < end else "?"
+
+
+def _bisect(keys, x):
+    """Índice do maior elemento <= x, ou -1."""
+    lo, hi = 0, len(keys)
+    while lo < hi:
+        mid = (lo + hi) // 2
+        if keys[mid] <= x:
+            lo = mid + 1
+        else:
+            hi = mid
+    return lo - 1
+
+# ----------------------------------------------------------------------------
+# Relatórios
+# ----------------------------------------------------------------------------
+
+def flat_profile(hist, res):
+    funcs = {}
+    for addr, n in hist.items():
+        name, _ = res.function(addr)
+        key = (name or "0x%08x" % addr, res.object(addr))
+        funcs[key] = funcs.get(key, 0) + n
+    return sorted(funcs.items(), key=lambda kv: -kv[1])
+
+
+def print_flat(hz, total, other, rows, limit, out):
+    out.write("%d amostras a %d Hz (%.1f s), %d fora do .text/.fastcode\n\n"
+              % (total, hz, total / hz if hz else 0.0, other))
+    out.write("%8s %6s  %-32s %s\n" % ("amostras", "%", "função", "objeto"))
+    for (name, obj), n in rows[:limit]:
+        out.write("%8d %5.1f%%  %-32s %s\n" % (n, 100.0 * n / total if total else 0.0, name, obj))
+
+
+def print_addrs(hist, res, total, limit, out):
+    out.write("\n%8s %6s  %-10s %s\n" % ("amostras", "%", "endereço", "função+offset"))
+    for addr, n in sorted(hist.items(), key=lambda kv: -kv[1])[:limit]:
+        name, off = res.function(addr)
+        where = "%s+0x%x" % (name, off) if name else "?"
+        out.write("%8d %5.1f%%  0x%08x %s\n" % (n, 100.0 * n / total if total else 0.0, addr, where))
+
+
+def write_folded(rows, path):
+    with open(path, "w") as f:
+        for (name, obj), n in rows:
+            f.write("%s;%s %d\n" % (obj, name, n))
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    default_elf = os.path.join(here, "..", "main.elf")
+
+    ap = argparse.ArgumentParser(description="Perfil do firmware a partir do despejo do incs/pcprof")
+    ap.add_argument("src", help="porta serial, arquivo capturado ou - para stdin")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("-t", "--timeout", type=float, default=5.0, help="espera pelo bloco na serial (s)")
+    ap.add_argument("--elf", default=default_elf, help="main.elf (símbolos via nm)")
+    ap.add_argument("--map", default=None, help="main.elf.map (objetos; símbolos se não houver nm)")
+    ap.add_argument("-n", "--top", type=int, default=30, help="funções no perfil plano")
+    ap.add_argument("--addr", type=int, default=0, metavar="N", help="lista os N endereços mais quentes")
+    ap.add_argument("--folded", metavar="ARQ", help="grava pilhas dobradas para o flamegraph.pl")
+    args = ap.parse_args()
+
+    dump = parse_dump(read_input(args.src, args.baud, args.timeout))
+    if dump is None:
+        sys.exit("bloco PCPROF BEGIN/END não encontrado")
+    hz, samples, other, hist = dump
+
+    map_path = args.map or args.elf + ".map"
+    map_syms, sections = parse_map(map_path)
+    syms = symbols_from_elf(args.elf)
+    if syms is None:
+        if not map_syms:
+            sys.exit("sem símbolos: instale o nm do RISC-V (ou $NM) ou passe --map")
+        sys.stderr.write("nm indisponível: símbolos do %s (só funções globais)\n" % map_path)
+        syms = map_syms
+
+    res = Resolver(syms, sections)
+    total = sum(hist.values())
+    rows = flat_profile(hist, res)
+
+    print_flat(hz, total, other, rows, args.top, sys.stdout)
+    if args.addr:
+        print_addrs(hist, res, total, args.addr, sys.stdout)
+    if args.folded:
+        write_folded(rows, args.folded)
+        sys.stderr.write("%s: %d linhas\n" % (args.folded, len(rows)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+#
+# sim_run.py - Roda o firmware (main.bin) no SoC simulado e mede o laço principal
+#
+# Gera os headers do SoC da litex/colorlight_i5_sim.py, recompila o main.bin
+# contra eles e roda o Verilator com os modelos dos sensores e do display
+# (litex/sim_modules). Pela console, pede o relatório do incs/prof ('p')
+# até passar o aquecimento em tempo simulado, zera ('z') e mede de novo pelo
+# tempo pedido. Cada região vira uma linha de CSV:
+#   region,n,kcycles,mean,min,max,pct
+# "main_loop" é o custo de uma volta do laço principal, em ciclos, sem o
+# atendimento da console (os próprios 'p'/'z' ficam fora da região).
+#
+# Com --baseline, compara a média de cada região com um CSV anterior e sai
+# com erro se alguma piorou além da tolerância: serve de teste de regressão
+# de desempenho sem a placa.
+#
+# Uso:
+#   python3 tools/sim_run.py -o base.csv
+#   python3 tools/sim_run.py --baseline base.csv --tolerance 5
+#   python3 tools/sim_run.py --ms 10000 --sim-arg=--ppg --sim-arg=captura_ppg.csv
+#   python3 tools/sim_run.py --no-build --baseline base.csv      # reusa o build
+#
+# As telas capturadas pelo modelo do ST7789 ficam em <build>/frames.
+
+import argparse
+import csv
+import os
+import queue
+import re
+import subprocess
+import sys
+import threading
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+FIRMWARE = os.path.normpath(os.path.join(HERE, ".."))
+REPO = os.path.normpath(os.path.join(FIRMWARE, ".."))
+SIM = os.path.join(REPO, "litex", "colorlight_i5_sim.py")
+
+FIELDS = ["region", "n", "kcycles", "mean", "min", "max", "pct"]
+
+# ----------------------------------------------------------------------------
+# Relatório do incs/prof
+# ----------------------------------------------------------------------------
+
+HEAD_RE = re.compile(r"^prof: (\d+) ms")
+ROW_RE = re.compile(r"^\s+(\S+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)(?:\s+IPC\s+\S+)?\s*$")
+
+
+class Report:
+    def __init__(self, ms):
+        self.ms = ms
+        self.rows = []
+
+
+def read_report(lines, first):
+    """Lê o relatório que começa em first (linha "prof: N ms") até a primeira linha
+    que não é da tabela; devolve (Report, linha que sobrou ou None)."""
+    rep = Report(int(HEAD_RE.match(first).group(1)))
+    for line in lines:
+        line = line.rstrip("\r\n")
+        if line.strip().startswith("regiao"):
+            continue
+        m = ROW_RE.match(line)
+        if not m:
+            return rep, line
+        rep.rows.append(dict(zip(FIELDS, m.groups())))
+    return rep, None
+
+# ----------------------------------------------------------------------------
+# Simulação
+# ----------------------------------------------------------------------------
+
+def run(cmd, **kw):
+    sys.stderr.write("$ %s\n" % " ".join(cmd))
+    subprocess.run(cmd, check=True, **kw)
+
+
+def build(base):
+    run(base + ["--no-compile-gateware"], stdout=subprocess.DEVNULL)
+    run(["make", "-C", FIRMWARE, "clean"], stdout=subprocess.DEVNULL)
+    run(["make", "-C", FIRMWARE, "BUILD_DIR=" + base[base.index("--output-dir") + 1]],
+        stdout=subprocess.DEVNULL)
+
+
+class Console:
+    """stdout do simulador linha a linha, sem bloquear quem escreve no stdin."""
+
+    def __init__(self, proc):
+        self.proc = proc
+        self.q = queue.Queue()
+        threading.Thread(target=self._pump, daemon=True).start()
+
+    def _pump(self):
+        for line in self.proc.stdout:
+            self.q.put(line)
+        self.q.put(None)
+
+    def send(self, ch):
+        self.proc.stdin.write(ch)
+        self.proc.stdin.flush()
+
+    def lines(self, timeout):
+        """Linhas até timeout segundos sem nada; termina no fim do processo."""
+        while True:
+            try:
+                line = self.q.get(timeout=timeout)
+            except queue.Empty:
+                return
+            if line is None:
+                raise EOFError("simulação terminou")
+            yield line
+
+
+def measure(base, warmup_ms, ms, poll, timeout, log):
+    cmd = base + ["--sdram-init", os.path.join(FIRMWARE, "main.bin"), "--non-interactive"]
+    sys.stderr.write("$ %s\n" % " ".join(cmd))
+    p = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                         text=True, errors="replace", bufsize=1)
+    con = Console(p)
+    deadline = time.time() + timeout
+    warm = False
+    reset = False
+    last = 0
+
+    try:
+        while time.time() < deadline:
+            con.send("p")
+            it = con.lines(poll)
+            for line in it:
+                if log:
+                    log.write(line)
+                if not HEAD_RE.match(line):
+                    continue
+                rep, _ = read_report(it, line)
+                if not warm:
+                    if rep.ms >= warmup_ms:
+                        con.send("z")   # Fora o boot e o primeiro scan
+                        warm = True
+                        sys.stderr.write("aquecido em %d ms simulados\n" % rep.ms)
+                    last = rep.ms
+                elif not reset:
+                    # Pedidos de antes do 'z' ainda na fila: o tempo só cai depois dele
+                    reset = rep.ms < last
+                    last = rep.ms
+                elif rep.ms >= ms:
+                    return rep
+                else:
+                    sys.stderr.write("  %d ms simulados\n" % rep.ms)
+                break
+    finally:
+        p.terminate()
+        p.wait()
+    return None
+
+# ----------------------------------------------------------------------------
+# Comparação
+# ----------------------------------------------------------------------------
+
+def load_csv(path):
+    with open(path, newline="") as f:
+        return {r["region"]: r for r in csv.DictReader(f)}
+
+
+def compare(base, rows, tolerance, min_count, out):
+    """Imprime a variação da média por região; devolve as regiões que pioraram."""
+    worse = []
+    out.write("%-20s %10s %10s %8s\n" % ("regiao", "base", "atual", "delta"))
+    for r in rows:
+        b = base.get(r["region"])
+        if b is None or int(r["n"]) < min_count or int(b["n"]) < min_count:
+            continue
+        old, new = int(b["mean"]), int(r["mean"])
+        delta = 100.0 * (new - old) / old if old else 0.0
+        flag = ""
+        if delta > tolerance:
+            worse.append(r["region"])
+            flag = "  PIOROU"
+        out.write("%-20s %10d %10d %+7.1f%%%s\n" % (r["region"], old, new, delta, flag))
+    return worse
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Desempenho do firmware no SoC simulado")
+    ap.add_argument("-o", "--output", default="-", help="CSV de saída (padrão: stdout)")
+    ap.add_argument("--cpu-type", default="vexriscv")
+    ap.add_argument("--cpu-variant", default="standard")
+    ap.add_argument("--l2", type=int, default=8192, help="tamanho do L2 em bytes")
+    ap.add_argument("--sim-arg", action="append", default=[], help="argumento extra para o colorlight_i5_sim.py")
+    ap.add_argument("--no-build", action="store_true", help="não regera headers nem recompila o main.bin")
+    ap.add_argument("--warmup-ms", type=int, default=2000, help="tempo simulado antes de zerar o perfil")
+    ap.add_argument("--ms", type=int, default=5000, help="tempo simulado medido depois do aquecimento")
+    ap.add_argument("--poll", type=float, default=20.0, help="intervalo entre pedidos de relatório (s reais)")
+    ap.add_argument("--timeout", type=float, default=3600.0, help="limite de tempo real da simulação (s)")
+    ap.add_argument("--log", help="grava a console da simulação")
+    ap.add_argument("--baseline", help="CSV de uma rodada anterior para comparar")
+    ap.add_argument("--tolerance", type=float, default=5.0, help="piora máxima da média (%%)")
+    ap.add_argument("--min-count", type=int, default=10, help="ignora regiões com menos execuções")
+    args = ap.parse_args()
+
+    out_dir = os.path.join(REPO, "build", "sim_%s_%d" % (args.cpu_variant, args.l2))
+    base = [sys.executable, SIM, "--cpu-type", args.cpu_type, "--cpu-variant", args.cpu_variant,
+            "--l2-cache-size", str(args.l2), "--output-dir", out_dir,
+            "--frames-dir", os.path.join(out_dir, "frames")] + args.sim_arg
+
+    if not args.no_build:
+        build(base)
+
+    log = open(args.log, "w") if args.log else None
+    rep = measure(base, args.warmup_ms, args.ms, args.poll, args.timeout, log)
+    if log:
+        log.close()
+    if rep is None:
+        sys.exit("sem relatório do prof dentro do tempo limite")
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w", newline="")
+    writer = csv.DictWriter(out, fieldnames=FIELDS)
+    writer.writeheader()
+    writer.writerows(rep.rows)
+    if out is not sys.stdout:
+        out.close()
+
+    for r in rep.rows:
+        if r["region"] == "main_loop":
+            sys.stderr.write("main_loop: %s ciclos/volta em média (%s voltas em %d ms)\n"
+                             % (r["mean"], r["n"], rep.ms))
+
+    if args.baseline:
+        worse = compare(load_csv(args.baseline), rep.rows, args.tolerance, args.min_count, sys.stderr)
+        if worse:
+            sys.exit("regressão acima de %.1f%%: %s" % (args.tolerance, ", ".join(worse)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# telemetry_decode.py - Decodifica a telemetria binária do firmware (incs/telemetry)
+#
+# Lê o fluxo da UART (porta serial com pyserial, arquivo capturado ou stdin),
+# separa os quadros COBS, confere o CRC16 (CCITT/XMODEM, o crc16 da libbase)
+# e grava CSV com cabeçalho e colunas de tipo fixo, prontos para pandas /
+# Parquet:
+#   <prefixo>_ppg.csv     t_us,seq,fs,red,ir          (uma linha por amostra)
+#   <prefixo>_sensor.csv  t_us,seq,name,count,v0..v3
+#   <prefixo>_log.csv     t_us,seq,text
+#
+# Uso:
+#   python3 tools/telemetry_decode.py /dev/ttyUSB0 -b 115200 -o captura
+#   python3 tools/telemetry_decode.py captura.bin -o captura
+#   cat captura.bin | python3 tools/telemetry_decode.py - -o captura
+#
+# Com uma porta serial, o script envia 'b' para ligar o modo binário (e 't'
+# ao sair, com Ctrl+C); com --export envia 'x' e recebe o log gravado na flash
+# (incs/flashlog). Texto que chegue entre quadros é ignorado.
+
+import argparse
+import binascii
+import csv
+import os
+import struct
+import sys
+
+REC_PPG = 0x01
+REC_SENSOR = 0x02
+REC_LOG = 0x03
+
+HEADER = struct.Struct("<BBI")   # tipo, seq, t_us
+
+# ----------------------------------------------------------------------------
+# Enquadramento
+# ----------------------------------------------------------------------------
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("COBS inválido")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16(data):
+    return binascii.crc_hqx(data, 0)   # Polinômio 0x1021, início 0: igual à libbase
+
+
+class Deframer:
+    """Separa os quadros (ainda em COBS) entre delimitadores 0x00."""
+    def __init__(self):
+        self.buf = bytearray()
+
+    def feed(self, chunk):
+        self.buf += chunk
+        while True:
+            end = self.buf.find(b"\x00")
+            if end < 0:
+                return
+            raw = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if raw:
+                yield raw
+
+# ----------------------------------------------------------------------------
+# Registros
+# ----------------------------------------------------------------------------
+
+class Writer:
+    def __init__(self, prefix):
+        self.prefix = prefix
+        self.files = {}
+        self.stats = {"quadros": 0, "crc": 0, "cobs": 0, "seq": 0}
+        self.last_seq = None
+
+    def csv(self, kind, header):
+        if kind not in self.files:
+            f = open(f"{self.prefix}_{kind}.csv", "w", newline="")
+            w = csv.writer(f)
+            w.writerow(header)
+            self.files[kind] = (f, w)
+        return self.files[kind][1]
+
+    def close(self):
+        for f, _ in self.files.values():
+            f.close()
+
+    def record(self, rec):
+        rtype, seq, t_us = HEADER.unpack_from(rec)
+        body = rec[HEADER.size:]
+
+        if self.last_seq is not None and seq != (self.last_seq + 1) & 0xFF:
+            self.stats["seq"] += 1   # Quadro perdido (ou corrompido) no meio
+        self.last_seq = seq
+
+        if rtype == REC_PPG:
+            fs, n = struct.unpack_from("<HB", body)
+            w = self.csv("ppg", ["t_us", "seq", "fs", "red", "ir"])
+            for i in range(n):
+                off = 3 + i * 6
+                red = int.from_bytes(body[off:off + 3], "little")
+                ir = int.from_bytes(body[off + 3:off + 6], "little")
+                t = (t_us + i * 1000000 // fs) & 0xFFFFFFFF
+                w.writerow([t, seq, fs, red, ir])
+        elif rtype == REC_SENSOR:
+            count, nv = struct.unpack_from("<IB", body)
+            v = struct.unpack_from(f"<{nv}i", body, 5)
+            off = 5 + 4 * nv
+            name = body[off + 1:off + 1 + body[off]].decode("ascii", "replace")
+            w = self.csv("sensor", ["t_us", "seq", "name", "count", "v0", "v1", "v2", "v3"])
+            w.writerow([t_us, seq, name, count] + list(v[:4]) + [""] * (4 - len(v[:4])))
+        elif rtype == REC_LOG:
+            w = self.csv("log", ["t_us", "seq", "text"])
+            w.writerow([t_us, seq, body.decode("utf-8", "replace")])
+
+    def frame(self, raw):
+        try:
+            data = cobs_decode(raw)
+        except ValueError:
+            self.stats["cobs"] += 1
+            return
+        if len(data) < HEADER.size + 2:
+            self.stats["cobs"] += 1
+            return
+        rec, crc = data[:-2], struct.unpack("<H", data[-2:])[0]
+        if crc16(rec) != crc:
+            self.stats["crc"] += 1
+            return
+        self.stats["quadros"] += 1
+        self.record(rec)
+
+# ----------------------------------------------------------------------------
+
+def open_input(path, baud, cmd):
+    if path == "-":
+        return sys.stdin.buffer, None
+    if os.path.exists(path) and not path.startswith("/dev/"):
+        return open(path, "rb"), None
+    import serial   # pyserial, só para leitura ao vivo
+    port = serial.Serial(path, baud, timeout=0.1)
+    port.write(cmd)
+    return port, port
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decodifica a telemetria binária do firmware em CSV.")
+    ap.add_argument("input", help="porta serial, arquivo capturado ou - (stdin)")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("-o", "--out", default="telemetria", help="prefixo dos CSV")
+    ap.add_argument("-x", "--export", action="store_true", help="lê o log gravado na flash ('x')")
+    args = ap.parse_args()
+
+    stream, port = open_input(args.input, args.baud, b"x" if args.export else b"b")
+    w = Writer(args.out)
+    d = Deframer()
+    try:
+        while True:
+            chunk = stream.read(4096)
+            if not chunk and port is None:
+                break   # Fim do arquivo; na serial, vazio é só o timeout
+            for raw in d.feed(chunk):
+                w.frame(raw)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if port is not None:
+            port.write(b"t")
+        w.close()
+        s = w.stats
+        print(f"{s['quadros']} quadros, {s['crc']} CRC ruim, {s['cobs']} COBS ruim, "
+              f"{s['seq']} quebras de sequência", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -23,8 +23,8 @@ from litex.soc.cores.led import LedChaser
 # Imports necessários para o projeto
 from litex.soc.cores.spi import SPIMaster
 from litex.soc.cores.bitbang import I2CMaster
-from litex.soc.cores.gpio import GPIOOut
-from litex.build.generic_platform import Subsignal, Pins, IOStandard
+from litex.soc.cores.gpio import GPIOOut, GPIOIn
+from litex.build.generic_platform import Subsignal, Pins, IOStandard, Misc
 
 from litedram.modules import M12L64322A # Compatible with EM638325-6H.
 from litedram.modules import IS42S16160
@@ -72,6 +72,9 @@ class BaseSoC(SoCCore):
     def __init__(self, board="i5", revision="7.0", toolchain="trellis", sys_clk_freq=60e6,
         sdram_rate             = "1:1",
         with_led_chaser        = True,
+        max_int_pin            = None,
+        tcs_int_pin            = None,
+        with_pc_sampler        = False,
         **kwargs):
         board = board.lower()
         assert board in ["i5", "i9"]
@@ -96,6 +99,7 @@ class BaseSoC(SoCCore):
             integrated_rom_size=0x20000,
             integrated_sram_size=0x8000,
             integrated_main_ram_size=0,
+            timer_uptime=True,                # contador de ciclos 64 bits (timestamps e medições)
             with_uartboot=False,              #  correto
             cpu_reset_address=0x00200000,     #  ESSENCIAL
             **kwargs
@@ -178,6 +182,28 @@ class BaseSoC(SoCCore):
         self.submodules.i2c = I2CMaster(pads=platform.request("i2c"))
         self.add_csr("i2c")
 
+        # Pinos INT dos sensores (opcionais) ------------------------------------------
+        # Dreno aberto e ativos em nível baixo: pull-up interno e IRQ por borda (firmware
+        # seleciona descida). Geram os CSRs 'max_int'/'tcs_int' e <NOME>_INTERRUPT.
+        if max_int_pin is not None:
+            self.add_sensor_int(platform, "max_int", max_int_pin)
+        if tcs_int_pin is not None:
+            self.add_sensor_int(platform, "tcs_int", tcs_int_pin)
+
+        # Timer da amostragem de PC (opcional) ----------------------------------------
+        # O timer0 é do busy_wait_us e do uptime: o perfil estatístico do firmware
+        # (incs/pcprof) usa um segundo timer, com IRQ própria. Gera TIMER1_INTERRUPT.
+        if with_pc_sampler:
+            self.add_timer(name="timer1")
+
+    def add_sensor_int(self, platform, name, pin):
+        platform.add_extension([
+            (name, 0, Pins(pin), IOStandard("LVCMOS33"), Misc("PULLMODE=UP"))
+        ])
+        setattr(self.submodules, name, GPIOIn(platform.request(name), with_irq=True))
+        self.add_csr(name)
+        self.irq.add(name, use_loc_if_exists=True)
+
 # Build --------------------------------------------------------------------------------------------
 
 def main():
@@ -187,6 +213,9 @@ def main():
     parser.add_target_argument("--revision",         default="7.0",            help="Board revision (7.0).")
     parser.add_target_argument("--sys-clk-freq",     default=60e6, type=float, help="System clock frequency.")
     parser.add_target_argument("--sdram-rate",       default="1:1",            help="SDRAM Rate (1:1 Full Rate or 1:2 Half Rate).")
+    parser.add_target_argument("--max-int-pin",      default=None,             help="FPGA pin wired to the MAX3010x INT output (enables IRQ sampling).")
+    parser.add_target_argument("--tcs-int-pin",      default=None,             help="FPGA pin wired to the TCS34725 INT output (enables threshold IRQ).")
+    parser.add_target_argument("--with-pc-sampler",  action="store_true",      help="Add timer1 for the firmware PC-sampling profiler.")
     
     
     args = parser.parse_args()
@@ -195,6 +224,9 @@ def main():
         toolchain              = args.toolchain,
         sys_clk_freq           = args.sys_clk_freq,
         sdram_rate             = args.sdram_rate,
+        max_int_pin            = args.max_int_pin,
+        tcs_int_pin            = args.tcs_int_pin,
+        with_pc_sampler        = args.with_pc_sampler,
         **parser.soc_argdict
     )
 
@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+
+#
+# Simulação (Verilator) do SoC da colorlight_i5.py, para rodar imagens do
+# firmware sem a placa e comparar variantes de CPU e tamanhos de L2 antes de
+# gerar um bitstream.
+#
+# Mesmo mapa de memória (ROM 128 KB, SRAM 32 KB, SDRAM M12L64322A de 8 MB
+# atrás do L2), mesmo timer0 com uptime e os mesmos CSRs do display (spi,
+# lcd_dc/reset/blk), do I2C e, opcionais, dos pinos INT: o firmware compila
+# sem mudanças contra os headers gerados aqui (BUILD_DIR). Fica de fora a
+# flash SPI (o flashlog não monta).
+#
+# Nos pads ficam modelos em C do litex_sim (litex/sim_modules): BH1750,
+# AHT10, TCS34725 e MAX3010x no I2C (o PPG pode repetir um CSV gravado) e um
+# ST7789 no SPI que grava a tela em PPM a cada --frame-ms de tempo simulado.
+#
+#   python3 litex/colorlight_i5_sim.py --no-compile-gateware          # headers + BIOS, sem rodar
+#   make -C firmware BUILD_DIR=../build/sim
+#   python3 litex/colorlight_i5_sim.py --sdram-init firmware/main.bin --ppg captura_ppg.csv
+#
+# A imagem vai para o modelo da SDRAM na elaboração e a BIOS salta para ela
+# (ROM_BOOT_ADDRESS); trocar a imagem refaz o Verilator.
+
+import os
+import argparse
+
+from migen import *
+
+from litex.gen import *
+
+from litex.build.generic_platform import Pins, Subsignal
+from litex.build.sim import SimPlatform
+from litex.build.sim.config import SimConfig
+from litex.build.sim.verilator import verilator_build_args, verilator_build_argdict
+
+from litex.soc.integration.common import get_mem_data
+from litex.soc.integration.soc_core import *
+from litex.soc.integration.builder import *
+from litex.soc.interconnect.csr import CSRStorage, CSRStatus, CSRField
+from litex.soc.cores.spi import SPIMaster
+from litex.soc.cores.gpio import GPIOOut, GPIOIn
+
+from litedram.modules import M12L64322A
+from litedram.phy.model import SDRAMPHYModel
+
+# IOs ----------------------------------------------------------------------------------------------
+
+_io = [
+    ("sys_clk", 0, Pins(1)),
+    ("sys_rst", 0, Pins(1)),
+    ("serial", 0,
+        Subsignal("source_valid", Pins(1)),
+        Subsignal("source_ready", Pins(1)),
+        Subsignal("source_data",  Pins(8)),
+        Subsignal("sink_valid",   Pins(1)),
+        Subsignal("sink_ready",   Pins(1)),
+        Subsignal("sink_data",    Pins(8)),
+    ),
+    ("spi", 0,
+        Subsignal("clk",  Pins(1)),
+        Subsignal("mosi", Pins(1)),
+        Subsignal("miso", Pins(1)),
+        Subsignal("cs_n", Pins(1)),
+    ),
+    ("lcd_dc",    0, Pins(1)),
+    ("lcd_reset", 0, Pins(1)),
+    ("lcd_blk",   0, Pins(1)),
+    ("i2c", 0,
+        Subsignal("scl",     Pins(1)),
+        Subsignal("sda_out", Pins(1)),
+        Subsignal("sda_in",  Pins(1)),
+    ),
+    ("max_int", 0, Pins(1)),
+    ("tcs_int", 0, Pins(1)),
+]
+
+SIM_MODULES = os.path.join(os.path.dirname(os.path.abspath(__file__)), "sim_modules")
+
+class Platform(SimPlatform):
+    def __init__(self):
+        SimPlatform.__init__(self, "SIM", _io)
+
+# I2C ----------------------------------------------------------------------------------------------
+
+class SimI2CMaster(LiteXModule):
+    """
+    Mesmos CSRs do I2CMaster bit-bang da placa (i2c_w: scl/oe/sda, i2c_r: sda),
+    com o dreno aberto resolvido por dentro: o Verilator não modela Tristate.
+    SDA fica em 1 (pull-up) a menos que o mestre ou um dispositivo puxe para 0.
+    Nos pads, scl e sda_out saem do mestre e sda_in volta dos modelos
+    (sim_modules/i2c_sensors), já com o AND de quem estiver no barramento.
+    """
+    def __init__(self, pads):
+        self._w = CSRStorage(fields=[
+            CSRField("scl", size=1, offset=0, reset=1),
+            CSRField("oe",  size=1, offset=1),
+            CSRField("sda", size=1, offset=2, reset=1),
+        ], name="w")
+        self._r = CSRStatus(fields=[
+            CSRField("sda", size=1, offset=0),
+        ], name="r")
+
+        sda_out = Signal()
+
+        # # #
+
+        self.comb += [
+            pads.scl.eq(self._w.fields.scl),
+            sda_out.eq(~(self._w.fields.oe & ~self._w.fields.sda)),
+            pads.sda_out.eq(sda_out),
+            self._r.fields.sda.eq(sda_out & pads.sda_in),
+        ]
+
+# SimSoC -------------------------------------------------------------------------------------------
+
+class SimSoC(SoCCore):
+    def __init__(self, sys_clk_freq=60e6,
+        sdram_init             = [],
+        l2_cache_size          = 8192,
+        with_pc_sampler        = False,
+        with_sensor_ints       = False,
+        **kwargs):
+        platform = Platform()
+
+        # CRG --------------------------------------------------------------------------------------
+        self.crg = CRG(platform.request("sys_clk"))
+
+        # SoCCore ----------------------------------------------------------------------------------
+
+        # Mesmas memórias da placa; o resto (CPU, variante) vem dos argumentos
+        kwargs.pop("integrated_rom_size", None)
+        kwargs.pop("integrated_sram_size", None)
+        kwargs.pop("integrated_main_ram_size", None)
+        kwargs.pop("timer_uptime", None)
+        kwargs.pop("ident", None)
+        kwargs["uart_name"] = "sim"
+
+        cpu_variant = kwargs.get("cpu_variant", None) or "standard"
+        SoCCore.__init__(
+            self,
+            platform,
+            int(sys_clk_freq),
+            ident="LiteX SoC sim Colorlight ({} {}, L2 {})".format(
+                kwargs.get("cpu_type", None) or "vexriscv", cpu_variant, l2_cache_size),
+            integrated_rom_size=0x20000,
+            integrated_sram_size=0x8000,
+            integrated_main_ram_size=0,
+            timer_uptime=True,
+            **kwargs
+        )
+
+        # SDR SDRAM (modelo) -----------------------------------------------------------------------
+        sdram_module = M12L64322A(sys_clk_freq, "1:1")
+        self.sdrphy = SDRAMPHYModel(
+            module     = sdram_module,
+            data_width = 32,
+            clk_freq   = sys_clk_freq,
+            init       = sdram_init,
+        )
+        self.add_sdram("sdram",
+            phy           = self.sdrphy,
+            module        = sdram_module,
+            l2_cache_size = l2_cache_size,
+        )
+        if sdram_init != []:
+            # Imagem já carregada: sem memtest por cima e boot direto nela
+            self.add_constant("SDRAM_TEST_DISABLE")
+            self.add_constant("ROM_BOOT_ADDRESS", self.mem_map["main_ram"])
+        else:
+            self.add_constant("MEMTEST_DATA_SIZE", 8*1024)
+            self.add_constant("MEMTEST_ADDR_SIZE", 8*1024)
+
+        # Display (modelo do painel em sim_modules/st7789) -----------------------------------------
+        self.spi = SPIMaster(pads=platform.request("spi"), data_width=8, sys_clk_freq=sys_clk_freq, spi_clk_freq=40e6)
+        self.add_csr("spi")
+
+        self.submodules.lcd_dc = GPIOOut(platform.request("lcd_dc"))
+        self.add_csr("lcd_dc")
+
+        self.submodules.lcd_reset = GPIOOut(platform.request("lcd_reset"))
+        self.add_csr("lcd_reset")
+
+        self.submodules.lcd_blk = GPIOOut(platform.request("lcd_blk"))
+        self.add_csr("lcd_blk")
+
+        # I2C (sensores em sim_modules/i2c_sensors) ------------------------------------------------
+        self.submodules.i2c = SimI2CMaster(platform.request("i2c"))
+        self.add_csr("i2c")
+
+        # Pinos INT dos sensores (opcionais), como --max-int-pin/--tcs-int-pin na placa ------------
+        if with_sensor_ints:
+            for name in ["max_int", "tcs_int"]:
+                setattr(self.submodules, name, GPIOIn(platform.request(name), with_irq=True))
+                self.add_csr(name)
+                self.irq.add(name, use_loc_if_exists=True)
+
+        # Timer da amostragem de PC (opcional), como na placa --------------------------------------
+        if with_pc_sampler:
+            self.add_timer(name="timer1")
+
+# Build --------------------------------------------------------------------------------------------
+
+def main():
+    parser = argparse.ArgumentParser(description="Verilator simulation of the Colorlight I5 SoC.")
+    builder_args(parser)
+    soc_core_args(parser)
+    verilator_build_args(parser)
+    parser.add_argument("--sys-clk-freq",     default=60e6, type=float, help="Simulated system clock frequency.")
+    parser.add_argument("--l2-cache-size",    default=8192, type=int,   help="SDRAM L2 cache size in bytes (0 disables it).")
+    parser.add_argument("--sdram-init",       default=None,             help="Firmware image (.bin) preloaded at main_ram and booted by the BIOS.")
+    parser.add_argument("--with-pc-sampler",  action="store_true",      help="Add timer1 for the firmware PC-sampling profiler.")
+    parser.add_argument("--with-sensor-ints", action="store_true",      help="Add the MAX3010x/TCS34725 INT pins (GPIOIn with IRQ).")
+    parser.add_argument("--lux",              default=300.0, type=float, help="BH1750 model: illuminance (lux).")
+    parser.add_argument("--temp",             default=25.0,  type=float, help="AHT10 model: temperature (C).")
+    parser.add_argument("--rh",               default=50.0,  type=float, help="AHT10 model: relative humidity (%%).")
+    parser.add_argument("--tcs",              default="8,3,3,2",        help="TCS34725 model: C,R,G,B counts per 2.4 ms cycle at 1x gain.")
+    parser.add_argument("--ppg",              default=None,             help="MAX3010x model: CSV with red/ir columns to replay (synthetic pulse if omitted).")
+    parser.add_argument("--ppg-fs",           default=100.0, type=float, help="Sample rate of the --ppg CSV when it has no fs column.")
+    parser.add_argument("--frames-dir",       default="frames",         help="ST7789 model: directory for the captured PPM frames.")
+    parser.add_argument("--frame-ms",         default=250,   type=int,   help="ST7789 model: capture period in simulated ms.")
+    args = parser.parse_args()
+
+    soc_kwargs = soc_core_argdict(args)
+    sdram_init = []
+    if args.sdram_init is not None:
+        sdram_init = get_mem_data(args.sdram_init, data_width=32, endianness="little")
+
+    sim_config = SimConfig()
+    sim_config.add_clocker("sys_clk", freq_hz=int(args.sys_clk_freq))
+    sim_config.add_module("serial2console", "serial")
+    sim_config.add_module("i2c_sensors", ["i2c"] + (["max_int", "tcs_int"] if args.with_sensor_ints else []), args={
+        "lux"    : args.lux,
+        "temp"   : args.temp,
+        "rh"     : args.rh,
+        "tcs"    : [int(x) for x in args.tcs.split(",")],
+        "ppg"    : os.path.abspath(args.ppg) if args.ppg else "",
+        "ppg_fs" : args.ppg_fs,
+    })
+    sim_config.add_module("st7789", ["spi", "lcd_dc", "lcd_reset"], args={
+        "dir"      : os.path.abspath(args.frames_dir),
+        "frame_ms" : args.frame_ms,
+    })
+
+    soc = SimSoC(
+        sys_clk_freq           = args.sys_clk_freq,
+        sdram_init             = sdram_init,
+        l2_cache_size          = args.l2_cache_size,
+        with_pc_sampler        = args.with_pc_sampler,
+        with_sensor_ints       = args.with_sensor_ints,
+        **soc_kwargs
+    )
+
+    builder = Builder(soc, **builder_argdict(args))
+    builder.build(
+        sim_config      = sim_config,
+        extra_mods      = ["i2c_sensors", "st7789"],
+        extra_mods_path = SIM_MODULES,
+        **verilator_build_argdict(args)
+    )
+
+if __name__ == "__main__":
+    main()
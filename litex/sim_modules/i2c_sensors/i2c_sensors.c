@@ -0,0 +1,843 @@
+/*
+ * i2c_sensors.c - Módulo do litex_sim com os sensores I2C do firmware
+ *
+ * Escravo I2C amostrado a cada subida do sys_clk sobre os pads "i2c" do
+ * SimI2CMaster (litex/colorlight_i5_sim.py): scl e sda_out vêm do mestre,
+ * sda_in volta com o AND de quem estiver puxando a linha. Quatro dispositivos,
+ * no nível de registrador e com o tempo de conversão em tempo simulado:
+ *
+ *   BH1750    0x23  lux fixo ("lux"), modos H/H2/L, MTreg
+ *   AHT10     0x38  temperatura/umidade fixas ("temp", "rh"), BUSY, CRC8
+ *   TCS34725  0x29  contagens C/R/G/B por ciclo de 2,4 ms a 1x ("tcs"),
+ *                   ATIME, ganho, AVALID, AINT com limiares e persistência
+ *   MAX3010x  0x57  FIFO de 32 amostras enchida na taxa configurada, com a
+ *                   forma de onda de um CSV gravado ("ppg", colunas red e ir;
+ *                   o _ppg.csv do telemetry_decode.py serve) ou um pulso
+ *                   sintético de 1,2 Hz
+ *
+ * Se o SoC tiver os pinos INT (--with-sensor-ints), max_int e tcs_int seguem
+ * os registradores de status, ativos em nível baixo.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <json-c/json.h>
+
+#include "error.h"
+#include "modules.h"
+
+#define PS_PER_MS  1000000000ULL
+#define PS_PER_S   1000000000000ULL
+
+/* ================= DISPOSITIVOS ================= */
+
+struct session_s;
+
+typedef struct {
+  uint8_t addr;
+  void    (*start)(struct session_s *s, int rd);
+  int     (*write)(struct session_s *s, uint8_t b);   /* 1 = ACK */
+  uint8_t (*read)(struct session_s *s);
+  void    (*stop)(struct session_s *s);
+} device_t;
+
+typedef struct {
+  int      powered;
+  uint8_t  mode;          /* Último comando de medida (0 = nenhum) */
+  uint8_t  mtreg;
+  uint16_t data;
+  uint64_t ready_at;      /* Fim da conversão em curso */
+  int      idx;
+  double   lux;
+} bh1750_t;
+
+typedef struct {
+  int      calibrated;
+  uint8_t  cmd[3];
+  int      cmd_len;
+  uint64_t busy_until;
+  int      pending;       /* Medida disparada, dados ainda não calculados */
+  uint8_t  data[6];       /* Bytes 1..6: RH, T e CRC */
+  int      idx;
+  double   temp, rh;
+} aht10_t;
+
+typedef struct {
+  uint8_t  regs[32];
+  uint8_t  ptr;
+  int      autoinc;
+  int      first;         /* Próximo byte escrito é comando */
+  uint64_t next_cycle;    /* Fim da integração corrente (0 = parado) */
+  int      out_count;     /* Ciclos seguidos fora da janela (persistência) */
+  uint32_t base[4];       /* C, R, G, B por ciclo de 2,4 ms a 1x */
+} tcs_t;
+
+typedef struct {
+  uint8_t  regs[256];
+  uint8_t  ptr;
+  int      first;
+  uint32_t fifo[32][2];   /* RED, IR, 18 bits */
+  int      wr, rd, count, ovf, byte_idx;
+  uint64_t next_sample;   /* 0 = modo desligado */
+  uint64_t t0;
+  uint32_t *wave;         /* Pares red, ir */
+  int      wave_n;
+  double   wave_fs;
+} max_t;
+
+struct session_s {
+  char *scl;
+  char *sda_out;
+  char *sda_in;
+  char *max_int;
+  char *tcs_int;
+  char *sys_clk;
+  clk_edge_state_t edge;
+  uint64_t now;
+
+  /* Motor do escravo */
+  int state;
+  int prev_scl, prev_sda;
+  int drive;              /* Nossa saída em dreno aberto: 0 puxa a linha */
+  int bit;
+  uint8_t byte;
+  int pending_ack;
+  int next_state;
+  int master_ack;
+  device_t *dev;
+
+  bh1750_t bh;
+  aht10_t  aht;
+  tcs_t    tcs;
+  max_t    max;
+};
+
+enum { ST_IDLE, ST_ADDR, ST_WRITE, ST_ACK_OUT, ST_READ, ST_READ_ACK, ST_IGNORE };
+
+static struct ext_module_s ext_mod;
+
+/* ================= BH1750 ================= */
+
+static void bh_start(struct session_s *s, int rd) {
+  s->bh.idx = 0;
+  if(rd && s->bh.mode && s->now >= s->bh.ready_at) {
+    double counts = s->bh.lux * 1.2 * s->bh.mtreg / 69.0;
+    if(s->bh.mode == 0x11 || s->bh.mode == 0x21)
+      counts *= 2.0;
+    if(counts > 65535.0)
+      counts = 65535.0;
+    s->bh.data = (uint16_t)(counts + 0.5);
+    if((s->bh.mode & 0x0F) == 0x03)
+      s->bh.data &= ~3;   /* Resolução de 4 lx */
+    /* Contínuo: a próxima conversão termina um período à frente */
+    if(s->bh.mode & 0x10)
+      s->bh.ready_at = s->now + ((s->bh.mode & 0x0F) == 0x03 ? 16 : 120) * PS_PER_MS * s->bh.mtreg / 69;
+  }
+}
+
+static int bh_write(struct session_s *s, uint8_t b) {
+  bh1750_t *bh = &s->bh;
+
+  if((b & 0xF8) == 0x40) {
+    bh->mtreg = (bh->mtreg & 0x1F) | ((b & 0x07) << 5);
+  } else if((b & 0xE0) == 0x60) {
+    bh->mtreg = (bh->mtreg & 0xE0) | (b & 0x1F);
+  } else if(b == 0x00) {
+    bh->powered = 0;
+  } else if(b == 0x01) {
+    bh->powered = 1;
+  } else if(b == 0x07) {
+    bh->data = 0;
+  } else if(b == 0x10 || b == 0x11 || b == 0x13 || b == 0x20 || b == 0x21 || b == 0x23) {
+    bh->mode = b;
+    bh->powered = !(b & 0x20);   /* Medida única desliga no fim */
+    bh->ready_at = s->now + ((b & 0x0F) == 0x03 ? 16 : 120) * PS_PER_MS * bh->mtreg / 69;
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+static uint8_t bh_read(struct session_s *s) {
+  uint8_t v = s->bh.idx == 0 ? s->bh.data >> 8 : s->bh.data & 0xFF;
+  s->bh.idx++;
+  return v;
+}
+
+/* ================= AHT10 ================= */
+
+static uint8_t crc8(const uint8_t *p, int n) {
+  uint8_t crc = 0xFF;
+  for(int i = 0; i < n; i++) {
+    crc ^= p[i];
+    for(int b = 0; b < 8; b++)
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+static void aht_convert(aht10_t *a) {
+  uint32_t hum = (uint32_t)(a->rh / 100.0 * 1048576.0);
+  uint32_t tmp = (uint32_t)((a->temp + 50.0) / 200.0 * 1048576.0);
+  uint8_t buf[6];
+
+  if(hum > 0xFFFFF) hum = 0xFFFFF;
+  if(tmp > 0xFFFFF) tmp = 0xFFFFF;
+  buf[0] = 0x18;
+  buf[1] = hum >> 12;
+  buf[2] = hum >> 4;
+  buf[3] = ((hum & 0x0F) << 4) | (tmp >> 16);
+  buf[4] = tmp >> 8;
+  buf[5] = tmp;
+  memcpy(a->data, &buf[1], 5);
+  a->data[5] = crc8(buf, 6);
+}
+
+static void aht_start(struct session_s *s, int rd) {
+  s->aht.idx = 0;
+  s->aht.cmd_len = 0;
+  if(rd && s->aht.pending && s->now >= s->aht.busy_until) {
+    aht_convert(&s->aht);
+    s->aht.pending = 0;
+  }
+}
+
+static int aht_write(struct session_s *s, uint8_t b) {
+  if(s->aht.cmd_len < 3)
+    s->aht.cmd[s->aht.cmd_len++] = b;
+  return 1;
+}
+
+static uint8_t aht_read(struct session_s *s) {
+  aht10_t *a = &s->aht;
+  uint8_t v;
+
+  if(a->idx == 0) {
+    v = (a->calibrated ? 0x08 : 0x00) | 0x10;
+    if(s->now < a->busy_until)
+      v |= 0x80;
+  } else {
+    v = a->idx <= 6 ? a->data[a->idx - 1] : 0xFF;
+  }
+  a->idx++;
+  return v;
+}
+
+static void aht_stop(struct session_s *s) {
+  aht10_t *a = &s->aht;
+
+  if(a->cmd_len == 0)
+    return;
+  switch(a->cmd[0]) {
+    case 0xBE:
+    case 0xE1:
+      a->calibrated = 1;
+      break;
+    case 0xAC:
+      a->busy_until = s->now + 75 * PS_PER_MS;
+      a->pending = 1;
+      break;
+    case 0xBA:
+      a->busy_until = s->now + 20 * PS_PER_MS;
+      break;
+  }
+  a->cmd_len = 0;
+}
+
+/* ================= TCS34725 ================= */
+
+#define TCS_ENABLE   0x00
+#define TCS_ATIME    0x01
+#define TCS_AILTL    0x04
+#define TCS_PERS     0x0C
+#define TCS_CONTROL  0x0F
+#define TCS_ID       0x12
+#define TCS_STATUS   0x13
+#define TCS_CDATAL   0x14
+
+static uint64_t tcs_period(tcs_t *t) {
+  return (uint64_t)(256 - t->regs[TCS_ATIME]) * 2400000000ULL;   /* 2,4 ms por ciclo */
+}
+
+static void tcs_update_int(struct session_s *s) {
+  tcs_t *t = &s->tcs;
+  if(s->tcs_int)
+    *s->tcs_int = !((t->regs[TCS_STATUS] & 0x10) && (t->regs[TCS_ENABLE] & 0x10));
+}
+
+static void tcs_integrate(struct session_s *s) {
+  static const int gains[4] = { 1, 4, 16, 60 };
+  static const int pers[16] = { 1, 1, 2, 3, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60 };
+  tcs_t *t = &s->tcs;
+  uint32_t cycles = 256 - t->regs[TCS_ATIME];
+  uint32_t full = cycles * 1024 > 65535 ? 65535 : cycles * 1024;
+  uint16_t v[4];
+
+  for(int i = 0; i < 4; i++) {
+    uint64_t c = (uint64_t)t->base[i] * gains[t->regs[TCS_CONTROL] & 3] * cycles;
+    v[i] = c > full ? full : (uint16_t)c;
+    t->regs[TCS_CDATAL + 2 * i]     = v[i] & 0xFF;
+    t->regs[TCS_CDATAL + 2 * i + 1] = v[i] >> 8;
+  }
+  t->regs[TCS_STATUS] |= 0x01;
+
+  uint16_t lo = t->regs[TCS_AILTL] | (t->regs[TCS_AILTL + 1] << 8);
+  uint16_t hi = t->regs[TCS_AILTL + 2] | (t->regs[TCS_AILTL + 3] << 8);
+  if(v[0] < lo || v[0] > hi) {
+    if(++t->out_count >= pers[t->regs[TCS_PERS] & 0x0F])
+      t->regs[TCS_STATUS] |= 0x10;
+  } else {
+    t->out_count = 0;
+  }
+  tcs_update_int(s);
+}
+
+static void tcs_tick(struct session_s *s) {
+  tcs_t *t = &s->tcs;
+
+  if((t->regs[TCS_ENABLE] & 0x03) != 0x03) {
+    t->next_cycle = 0;
+    return;
+  }
+  if(t->next_cycle == 0) {
+    t->next_cycle = s->now + tcs_period(t);
+  } else if(s->now >= t->next_cycle) {
+    tcs_integrate(s);
+    t->next_cycle += tcs_period(t);
+  }
+}
+
+static void tcs_start(struct session_s *s, int rd) {
+  if(!rd)
+    s->tcs.first = 1;
+}
+
+static int tcs_write(struct session_s *s, uint8_t b) {
+  tcs_t *t = &s->tcs;
+
+  if(t->first) {
+    t->first = 0;
+    if(!(b & 0x80))
+      return 0;
+    if((b & 0x60) == 0x60) {
+      if((b & 0x1F) == 0x06) {
+        t->regs[TCS_STATUS] &= ~0x10;
+        t->out_count = 0;
+        tcs_update_int(s);
+      }
+    } else {
+      t->ptr = b & 0x1F;
+      t->autoinc = (b & 0x60) == 0x20;
+    }
+    return 1;
+  }
+  if(t->ptr != TCS_ID && t->ptr != TCS_STATUS && t->ptr < TCS_CDATAL)
+    t->regs[t->ptr] = b;
+  if(t->ptr == TCS_ENABLE)
+    tcs_update_int(s);
+  if(t->autoinc)
+    t->ptr = (t->ptr + 1) & 0x1F;
+  return 1;
+}
+
+static uint8_t tcs_read(struct session_s *s) {
+  tcs_t *t = &s->tcs;
+  uint8_t v = t->ptr == TCS_ID ? 0x44 : t->regs[t->ptr];
+
+  if(t->autoinc)
+    t->ptr = (t->ptr + 1) & 0x1F;
+  return v;
+}
+
+/* ================= MAX3010x ================= */
+
+#define MAX_INT_STATUS1  0x00
+#define MAX_INT_STATUS2  0x01
+#define MAX_INT_ENABLE1  0x02
+#define MAX_FIFO_WR_PTR  0x04
+#define MAX_OVF_COUNTER  0x05
+#define MAX_FIFO_RD_PTR  0x06
+#define MAX_FIFO_DATA    0x07
+#define MAX_FIFO_CONFIG  0x08
+#define MAX_MODE_CONFIG  0x09
+#define MAX_SPO2_CONFIG  0x0A
+
+static void max_update_int(struct session_s *s) {
+  max_t *m = &s->max;
+  if(s->max_int)
+    *s->max_int = !((m->regs[MAX_INT_STATUS1] & (m->regs[MAX_INT_ENABLE1] | 0x01)) & 0xE1);
+}
+
+static void max_reset(struct session_s *s) {
+  max_t *m = &s->max;
+
+  memset(m->regs, 0, sizeof(m->regs));
+  m->regs[0xFE] = 0x03;
+  m->regs[0xFF] = 0x15;
+  m->wr = m->rd = m->count = m->ovf = m->byte_idx = 0;
+  m->next_sample = 0;
+  max_update_int(s);
+}
+
+static int max_active(max_t *m) {
+  uint8_t mode = m->regs[MAX_MODE_CONFIG];
+  return !(mode & 0x80) && ((mode & 0x07) == 2 || (mode & 0x07) == 3 || (mode & 0x07) == 7);
+}
+
+static uint64_t max_period(max_t *m) {
+  static const uint32_t sr_hz[8] = { 50, 100, 200, 400, 800, 1000, 1600, 3200 };
+  uint32_t avg = 1u << ((m->regs[MAX_FIFO_CONFIG] >> 5) & 0x07);
+  if(avg > 32)
+    avg = 32;
+  return PS_PER_S * avg / sr_hz[(m->regs[MAX_SPO2_CONFIG] >> 2) & 0x07];
+}
+
+static void max_wave(max_t *m, uint64_t t, uint32_t *red, uint32_t *ir) {
+  if(m->wave_n > 0) {
+    uint64_t i = (uint64_t)((double)t / PS_PER_S * m->wave_fs) % m->wave_n;
+    *red = m->wave[2 * i];
+    *ir  = m->wave[2 * i + 1];
+  } else {
+    /* Pulso triangular de 1,2 Hz em cima do nível DC, como no bench */
+    uint64_t fase = (t / (PS_PER_S / 100)) % 83;
+    uint32_t tri = fase < 41 ? (uint32_t)fase : (uint32_t)(83 - fase);
+    *red = 90000 + tri * 110;
+    *ir  = 120000 + tri * 150;
+  }
+  *red &= 0x3FFFF;
+  *ir  &= 0x3FFFF;
+}
+
+static void max_push(struct session_s *s) {
+  max_t *m = &s->max;
+  int a_full = m->regs[MAX_FIFO_CONFIG] & 0x0F;
+
+  if(m->count == 32) {
+    if(m->ovf < 31)
+      m->ovf++;
+    if(!(m->regs[MAX_FIFO_CONFIG] & 0x10))
+      return;   /* Sem rollover: a amostra nova se perde */
+    m->rd = (m->rd + 1) & 31;
+    m->count--;
+  }
+  max_wave(m, s->now - m->t0, &m->fifo[m->wr][0], &m->fifo[m->wr][1]);
+  m->wr = (m->wr + 1) & 31;
+  m->count++;
+
+  m->regs[MAX_INT_STATUS1] |= 0x40;
+  if(m->count >= 32 - a_full)
+    m->regs[MAX_INT_STATUS1] |= 0x80;
+  max_update_int(s);
+}
+
+static void max_tick(struct session_s *s) {
+  max_t *m = &s->max;
+
+  if(!max_active(m)) {
+    m->next_sample = 0;
+    return;
+  }
+  if(m->next_sample == 0) {
+    m->next_sample = s->now + max_period(m);
+  } else if(s->now >= m->next_sample) {
+    max_push(s);
+    m->next_sample += max_period(m);
+  }
+}
+
+static void max_start(struct session_s *s, int rd) {
+  if(!rd)
+    s->max.first = 1;
+}
+
+static int max_write(struct session_s *s, uint8_t b) {
+  max_t *m = &s->max;
+
+  if(m->first) {
+    m->first = 0;
+    m->ptr = b;
+    return 1;
+  }
+  switch(m->ptr) {
+    case MAX_INT_STATUS1:
+    case MAX_INT_STATUS2:
+    case MAX_FIFO_DATA:
+    case 0xFE:
+    case 0xFF:
+      break;
+    case MAX_FIFO_WR_PTR:
+      m->wr = b & 31;
+      m->count = (m->wr - m->rd) & 31;
+      break;
+    case MAX_OVF_COUNTER:
+      m->ovf = b & 31;
+      break;
+    case MAX_FIFO_RD_PTR:
+      m->rd = b & 31;
+      m->count = (m->wr - m->rd) & 31;
+      m->byte_idx = 0;
+      break;
+    case MAX_MODE_CONFIG:
+      if(b & 0x40) {
+        max_reset(s);
+        break;
+      }
+      m->regs[MAX_MODE_CONFIG] = b;
+      break;
+    default:
+      m->regs[m->ptr] = b;
+      if(m->ptr == MAX_INT_ENABLE1)
+        max_update_int(s);
+      break;
+  }
+  if(m->ptr != MAX_FIFO_DATA)
+    m->ptr++;
+  return 1;
+}
+
+static uint8_t max_read(struct session_s *s) {
+  max_t *m = &s->max;
+  uint8_t v;
+
+  switch(m->ptr) {
+    case MAX_FIFO_DATA: {
+      int per = (m->regs[MAX_MODE_CONFIG] & 0x07) == 2 ? 3 : 6;
+      uint32_t x = m->fifo[m->rd][m->byte_idx / 3];
+      v = (uint8_t)(x >> (8 * (2 - m->byte_idx % 3)));
+      if(m->count == 0)
+        return v;   /* FIFO vazia: repete, sem andar o ponteiro */
+      if(++m->byte_idx == per) {
+        m->byte_idx = 0;
+        m->rd = (m->rd + 1) & 31;
+        m->count--;
+        m->ovf = 0;
+      }
+      return v;
+    }
+    case MAX_INT_STATUS1:
+    case MAX_INT_STATUS2:
+      v = m->regs[m->ptr];
+      m->regs[m->ptr] = 0;   /* Leitura limpa */
+      max_update_int(s);
+      break;
+    case MAX_FIFO_WR_PTR:
+      v = m->wr;
+      break;
+    case MAX_OVF_COUNTER:
+      v = m->ovf;
+      break;
+    case MAX_FIFO_RD_PTR:
+      v = m->rd;
+      break;
+    default:
+      v = m->regs[m->ptr];
+      break;
+  }
+  m->ptr++;
+  return v;
+}
+
+/* CSV com cabeçalho: usa as colunas red e ir (e fs, se houver); sem
+ * cabeçalho, as duas primeiras colunas */
+static int max_load_wave(max_t *m, const char *path) {
+  FILE *f = fopen(path, "r");
+  char line[512];
+  int c_red = 0, c_ir = 1, c_fs = -1, cap = 0;
+
+  if(!f) {
+    fprintf(stderr, "[i2c_sensors] %s: nao abriu\n", path);
+    return RC_ERROR;
+  }
+  while(fgets(line, sizeof(line), f)) {
+    char *tok, *save;
+    double col[16];
+    int n = 0;
+
+    if(line[0] == '#' || line[0] == '\n')
+      continue;
+    if((line[0] < '0' || line[0] > '9') && line[0] != '-') {
+      /* Cabeçalho */
+      for(tok = strtok_r(line, ",\r\n", &save); tok && n < 16; tok = strtok_r(NULL, ",\r\n", &save), n++) {
+        if(!strcmp(tok, "red")) c_red = n;
+        else if(!strcmp(tok, "ir")) c_ir = n;
+        else if(!strcmp(tok, "fs")) c_fs = n;
+      }
+      continue;
+    }
+    for(tok = strtok_r(line, ",\r\n", &save); tok && n < 16; tok = strtok_r(NULL, ",\r\n", &save))
+      col[n++] = atof(tok);
+    if(n <= c_red || n <= c_ir)
+      continue;
+    if(c_fs >= 0 && c_fs < n && col[c_fs] > 0)
+      m->wave_fs = col[c_fs];
+    if(m->wave_n == cap) {
+      cap = cap ? 2 * cap : 4096;
+      m->wave = realloc(m->wave, cap * 2 * sizeof(uint32_t));
+      if(!m->wave) {
+        fclose(f);
+        return RC_NOENMEM;
+      }
+    }
+    m->wave[2 * m->wave_n]     = (uint32_t)col[c_red];
+    m->wave[2 * m->wave_n + 1] = (uint32_t)col[c_ir];
+    m->wave_n++;
+  }
+  fclose(f);
+  fprintf(stderr, "[i2c_sensors] PPG: %d amostras a %.0f Hz de %s\n", m->wave_n, m->wave_fs, path);
+  return RC_OK;
+}
+
+/* ================= MOTOR I2C ================= */
+
+static device_t devices[] = {
+  { 0x23, bh_start,  bh_write,  bh_read,  NULL     },
+  { 0x38, aht_start, aht_write, aht_read, aht_stop },
+  { 0x29, tcs_start, tcs_write, tcs_read, NULL     },
+  { 0x57, max_start, max_write, max_read, NULL     },
+};
+
+static device_t *find_device(uint8_t addr) {
+  for(unsigned i = 0; i < sizeof(devices) / sizeof(devices[0]); i++)
+    if(devices[i].addr == addr)
+      return &devices[i];
+  return NULL;
+}
+
+static void bus_stop(struct session_s *s) {
+  if(s->dev && s->dev->stop)
+    s->dev->stop(s);
+  s->dev = NULL;
+  s->state = ST_IDLE;
+  s->drive = 1;
+}
+
+/* Uma amostra dos pads por ciclo do sys_clk: o bit-bang do firmware troca
+ * SDA com SCL baixo, START/STOP são SDA mudando com SCL alto */
+static void bus_step(struct session_s *s) {
+  int scl = *s->scl & 1;
+  int sda = *s->sda_out & 1;
+
+  if(scl && s->prev_scl && sda != s->prev_sda) {
+    if(!sda) {
+      if(s->dev && s->dev->stop)
+        s->dev->stop(s);   /* START repetido fecha a escrita anterior */
+      s->dev = NULL;
+      s->state = ST_ADDR;
+      s->bit = 0;
+      s->byte = 0;
+      s->pending_ack = 0;
+      s->drive = 1;
+    } else {
+      bus_stop(s);
+    }
+  } else if(scl && !s->prev_scl) {
+    /* Subida: o lado que recebe amostra */
+    switch(s->state) {
+      case ST_ADDR:
+      case ST_WRITE:
+        s->byte = (s->byte << 1) | sda;
+        if(++s->bit < 8)
+          break;
+        if(s->state == ST_ADDR) {
+          s->dev = find_device(s->byte >> 1);
+          if(!s->dev) {
+            s->state = ST_IGNORE;
+            break;
+          }
+          s->dev->start(s, s->byte & 1);
+          s->next_state = (s->byte & 1) ? ST_READ : ST_WRITE;
+          s->pending_ack = 1;
+        } else {
+          s->next_state = ST_WRITE;
+          s->pending_ack = s->dev->write(s, s->byte);
+          if(!s->pending_ack)
+            s->state = ST_IGNORE;
+        }
+        break;
+      case ST_READ_ACK:
+        s->master_ack = !sda;
+        break;
+    }
+  } else if(!scl && s->prev_scl) {
+    /* Descida: o lado que transmite troca o bit */
+    if(s->pending_ack) {
+      s->pending_ack = 0;
+      s->drive = 0;
+      s->state = ST_ACK_OUT;
+    } else if(s->state == ST_ACK_OUT || (s->state == ST_READ_ACK && s->master_ack)) {
+      s->state = s->next_state;
+      s->bit = 0;
+      s->byte = 0;
+      s->drive = 1;
+      if(s->state == ST_READ) {
+        s->byte = s->dev->read(s);
+        s->drive = s->byte >> 7;
+      }
+    } else if(s->state == ST_READ_ACK) {
+      s->state = ST_IGNORE;   /* NACK: fim da leitura, espera o STOP */
+      s->drive = 1;
+    } else if(s->state == ST_READ) {
+      if(++s->bit < 8) {
+        s->drive = (s->byte >> (7 - s->bit)) & 1;
+      } else {
+        s->drive = 1;
+        s->state = ST_READ_ACK;
+      }
+    }
+  }
+
+  s->prev_scl = scl;
+  s->prev_sda = sda;
+  *s->sda_in = s->drive;
+}
+
+/* ================= MÓDULO ================= */
+
+static int json_get_double(json_object *args, const char *key, double *val) {
+  json_object *obj;
+  if(!args || !json_object_object_get_ex(args, key, &obj))
+    return 0;
+  *val = json_object_get_double(obj);
+  return 1;
+}
+
+static int i2c_sensors_start(void *b) {
+  printf("[i2c_sensors] loaded (%p)\n", b);
+  return RC_OK;
+}
+
+static int i2c_sensors_new(void **sess, char *args) {
+  int ret = RC_OK;
+  struct session_s *s = NULL;
+  json_object *jargs = NULL, *obj;
+
+  if(!sess) {
+    ret = RC_INVARG;
+    goto out;
+  }
+
+  s = (struct session_s *)malloc(sizeof(struct session_s));
+  if(!s) {
+    ret = RC_NOENMEM;
+    goto out;
+  }
+  memset(s, 0, sizeof(struct session_s));
+  s->prev_scl = s->prev_sda = 1;
+  s->drive = 1;
+
+  s->bh.lux = 300.0;
+  s->bh.mtreg = 69;
+  s->aht.temp = 25.0;
+  s->aht.rh = 50.0;
+  s->aht.calibrated = 1;
+  s->tcs.base[0] = 8;
+  s->tcs.base[1] = 3;
+  s->tcs.base[2] = 3;
+  s->tcs.base[3] = 2;
+  s->tcs.regs[TCS_ATIME] = 0xFF;
+  s->tcs.regs[TCS_AILTL + 2] = s->tcs.regs[TCS_AILTL + 3] = 0xFF;
+  s->max.wave_fs = 100.0;
+
+  if(args)
+    jargs = json_tokener_parse(args);
+  json_get_double(jargs, "lux", &s->bh.lux);
+  json_get_double(jargs, "temp", &s->aht.temp);
+  json_get_double(jargs, "rh", &s->aht.rh);
+  json_get_double(jargs, "ppg_fs", &s->max.wave_fs);
+  if(jargs && json_object_object_get_ex(jargs, "tcs", &obj) && json_object_is_type(obj, json_type_array)) {
+    for(int i = 0; i < 4 && i < (int)json_object_array_length(obj); i++)
+      s->tcs.base[i] = json_object_get_int(json_object_array_get_idx(obj, i));
+  }
+  if(jargs && json_object_object_get_ex(jargs, "ppg", &obj)) {
+    const char *path = json_object_get_string(obj);
+    if(path && *path && (ret = max_load_wave(&s->max, path)) != RC_OK)
+      goto out;
+  }
+
+  max_reset(s);
+  s->max.regs[MAX_INT_STATUS1] = 0x01;   /* PWR_RDY da energização */
+
+out:
+  if(jargs)
+    json_object_put(jargs);
+  if(ret != RC_OK && s) {
+    free(s->max.wave);
+    free(s);
+    s = NULL;
+  }
+  if(sess)
+    *sess = (void *)s;
+  return ret;
+}
+
+static int i2c_sensors_add_pads(void *sess, struct pad_list_s *plist) {
+  int ret = RC_OK;
+  struct session_s *s = (struct session_s *)sess;
+  struct pad_s *pads;
+
+  if(!sess || !plist) {
+    ret = RC_INVARG;
+    goto out;
+  }
+  pads = plist->pads;
+
+  if(!strcmp(plist->name, "i2c")) {
+    litex_sim_module_pads_get(pads, "scl", (void **)&s->scl);
+    litex_sim_module_pads_get(pads, "sda_out", (void **)&s->sda_out);
+    litex_sim_module_pads_get(pads, "sda_in", (void **)&s->sda_in);
+    *s->sda_in = 1;
+  }
+  if(!strcmp(plist->name, "max_int")) {
+    litex_sim_module_pads_get(pads, "max_int", (void **)&s->max_int);
+    max_update_int(s);
+  }
+  if(!strcmp(plist->name, "tcs_int")) {
+    litex_sim_module_pads_get(pads, "tcs_int", (void **)&s->tcs_int);
+    tcs_update_int(s);
+  }
+  if(!strcmp(plist->name, "sys_clk"))
+    litex_sim_module_pads_get(pads, "sys_clk", (void **)&s->sys_clk);
+
+out:
+  return ret;
+}
+
+static int i2c_sensors_tick(void *sess, uint64_t time_ps) {
+  struct session_s *s = (struct session_s *)sess;
+
+  if(!clk_pos_edge(&s->edge, *s->sys_clk))
+    return RC_OK;
+
+  s->now = time_ps;
+  bus_step(s);
+  tcs_tick(s);
+  max_tick(s);
+  return RC_OK;
+}
+
+static int i2c_sensors_close(void *sess) {
+  struct session_s *s = (struct session_s *)sess;
+
+  if(s) {
+    free(s->max.wave);
+    free(s);
+  }
+  return RC_OK;
+}
+
+static struct ext_module_s ext_mod = {
+  "i2c_sensors",
+  i2c_sensors_start,
+  i2c_sensors_new,
+  i2c_sensors_add_pads,
+  i2c_sensors_close,
+  i2c_sensors_tick
+};
+
+int litex_sim_ext_module_init(int (*register_module)(struct ext_module_s *)) {
+  int ret = RC_OK;
+  ret = register_module(&ext_mod);
+  return ret;
+}
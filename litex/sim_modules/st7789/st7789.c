@@ -0,0 +1,355 @@
+/*
+ * st7789.c - Módulo do litex_sim: painel ST7789 nos pads do display
+ *
+ * Escuta o SPI modo 0 do SPIMaster (clk, mosi, cs_n) e o lcd_dc, monta os
+ * bytes (DC amostrado no oitavo bit) e interpreta o que o driver do
+ * firmware usa: SWRESET, CASET/RASET/RAMWR, MADCTL (só MV, a troca de
+ * largura; MX/MY são guardados e não espelham a imagem), INVON/INVOFF,
+ * DISPON/DISPOFF; o resto só consome os parâmetros. lcd_reset em 0 volta
+ * o controlador ao estado de reset (a memória fica como está).
+ *
+ * Painel IPS, como em firmware/host/st7789_host.c: INVON dá as cores
+ * certas e INVOFF (o estado de reset) as mostra invertidas.
+ *
+ * A memória é guardada como o firmware a endereça (largura 320 com MV,
+ * 240 sem), então a imagem sai na orientação da rotação escolhida. A cada
+ * "frame_ms" de tempo simulado, se algo mudou, grava
+ * <dir>/frame_NNNNN.ppm (P6, RGB565 expandido, inversão aplicada).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <json-c/json.h>
+
+#include "error.h"
+#include "modules.h"
+
+#define PS_PER_MS  1000000000ULL
+
+#define LCD_W  240
+#define LCD_H  320
+
+#define CMD_SWRESET  0x01
+#define CMD_INVOFF   0x20
+#define CMD_INVON    0x21
+#define CMD_DISPOFF  0x28
+#define CMD_DISPON   0x29
+#define CMD_CASET    0x2A
+#define CMD_RASET    0x2B
+#define CMD_RAMWR    0x2C
+#define CMD_MADCTL   0x36
+
+#define MADCTL_MY  0x80
+#define MADCTL_MX  0x40
+#define MADCTL_MV  0x20
+
+struct session_s {
+  char *clk;
+  char *mosi;
+  char *cs_n;
+  char *dc;
+  char *reset;
+  char *sys_clk;
+  clk_edge_state_t edge;
+
+  /* SPI */
+  int prev_clk;
+  int bits;
+  uint8_t shift;
+
+  /* Controlador */
+  uint8_t cmd;
+  int nparam;
+  uint8_t param[4];
+  uint8_t madctl;
+  int invon;        /* INVON recebido: cores certas no IPS */
+  int display_on;
+  uint16_t xs, xe, ys, ye;
+  uint16_t x, y;
+  int pixel_hi;
+  uint8_t hi;
+  uint16_t fb[LCD_W * LCD_H];
+
+  /* Captura */
+  char dir[256];
+  uint64_t frame_ps;
+  uint64_t next_dump;
+  int dirty;
+  int frame;
+};
+
+static struct ext_module_s ext_mod;
+
+/* ================= CONTROLADOR ================= */
+
+static int fb_width(struct session_s *s) {
+  return (s->madctl & MADCTL_MV) ? LCD_H : LCD_W;
+}
+
+static void lcd_reset(struct session_s *s) {
+  s->cmd = 0;
+  s->nparam = 0;
+  s->madctl = 0;
+  s->invon = 0;
+  s->display_on = 0;
+  s->xs = s->ys = 0;
+  s->xe = LCD_W - 1;
+  s->ye = LCD_H - 1;
+  s->x = s->y = 0;
+  s->pixel_hi = 1;
+}
+
+static void lcd_pixel(struct session_s *s, uint16_t color) {
+  int w = fb_width(s);
+  int h = LCD_W * LCD_H / w;
+
+  if(s->x < w && s->y < h) {
+    s->fb[s->y * w + s->x] = color;
+    s->dirty = 1;
+  }
+  /* Coluna primeiro, depois a linha, dentro da janela */
+  if(s->x >= s->xe) {
+    s->x = s->xs;
+    s->y = s->y >= s->ye ? s->ys : s->y + 1;
+  } else {
+    s->x++;
+  }
+}
+
+static void lcd_command(struct session_s *s, uint8_t cmd) {
+  s->cmd = cmd;
+  s->nparam = 0;
+  switch(cmd) {
+    case CMD_SWRESET:
+      lcd_reset(s);
+      break;
+    case CMD_INVOFF:
+    case CMD_INVON:
+      s->invon = cmd == CMD_INVON;
+      s->dirty = 1;
+      break;
+    case CMD_DISPOFF:
+    case CMD_DISPON:
+      s->display_on = cmd == CMD_DISPON;
+      s->dirty = 1;
+      break;
+    case CMD_RAMWR:
+      s->x = s->xs;
+      s->y = s->ys;
+      s->pixel_hi = 1;
+      break;
+  }
+}
+
+static void lcd_data(struct session_s *s, uint8_t b) {
+  if(s->cmd == CMD_RAMWR) {
+    if(s->pixel_hi) {
+      s->hi = b;
+    } else {
+      lcd_pixel(s, (s->hi << 8) | b);
+    }
+    s->pixel_hi = !s->pixel_hi;
+    return;
+  }
+
+  if(s->nparam < 4)
+    s->param[s->nparam] = b;
+  s->nparam++;
+
+  switch(s->cmd) {
+    case CMD_CASET:
+      if(s->nparam == 2) s->xs = (s->param[0] << 8) | s->param[1];
+      if(s->nparam == 4) s->xe = (s->param[2] << 8) | s->param[3];
+      break;
+    case CMD_RASET:
+      if(s->nparam == 2) s->ys = (s->param[0] << 8) | s->param[1];
+      if(s->nparam == 4) s->ye = (s->param[2] << 8) | s->param[3];
+      break;
+    case CMD_MADCTL:
+      if(s->nparam == 1 && ((s->madctl ^ b) & MADCTL_MV)) {
+        /* Troca de orientação: a memória passa a ser lida na outra largura */
+        memset(s->fb, 0, sizeof(s->fb));
+        s->dirty = 1;
+      }
+      if(s->nparam == 1)
+        s->madctl = b;
+      break;
+  }
+}
+
+/* ================= CAPTURA ================= */
+
+static void dump_frame(struct session_s *s) {
+  char path[300];
+  FILE *f;
+  int w = fb_width(s);
+  int h = LCD_W * LCD_H / w;
+
+  snprintf(path, sizeof(path), "%s/frame_%05d.ppm", s->dir, s->frame++);
+  f = fopen(path, "wb");
+  if(!f) {
+    fprintf(stderr, "[st7789] %s: %s\n", path, strerror(errno));
+    return;
+  }
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  for(int i = 0; i < w * h; i++) {
+    uint16_t c = s->display_on ? s->fb[i] : 0;
+    uint8_t rgb[3];
+
+    if(s->display_on && !s->invon)
+      c = ~c;
+    rgb[0] = ((c >> 11) & 0x1F) * 255 / 31;
+    rgb[1] = ((c >> 5) & 0x3F) * 255 / 63;
+    rgb[2] = (c & 0x1F) * 255 / 31;
+    fwrite(rgb, 1, 3, f);
+  }
+  fclose(f);
+  s->dirty = 0;
+}
+
+/* ================= MÓDULO ================= */
+
+static int st7789_start(void *b) {
+  printf("[st7789] loaded (%p)\n", b);
+  return RC_OK;
+}
+
+static int st7789_new(void **sess, char *args) {
+  int ret = RC_OK;
+  struct session_s *s = NULL;
+  json_object *jargs = NULL, *obj;
+  const char *dir = "frames";
+  int frame_ms = 250;
+
+  if(!sess) {
+    ret = RC_INVARG;
+    goto out;
+  }
+
+  s = (struct session_s *)malloc(sizeof(struct session_s));
+  if(!s) {
+    ret = RC_NOENMEM;
+    goto out;
+  }
+  memset(s, 0, sizeof(struct session_s));
+  lcd_reset(s);
+
+  if(args)
+    jargs = json_tokener_parse(args);
+  if(jargs && json_object_object_get_ex(jargs, "dir", &obj))
+    dir = json_object_get_string(obj);
+  if(jargs && json_object_object_get_ex(jargs, "frame_ms", &obj))
+    frame_ms = json_object_get_int(obj);
+
+  snprintf(s->dir, sizeof(s->dir), "%s", dir);
+  s->frame_ps = (uint64_t)(frame_ms > 0 ? frame_ms : 250) * PS_PER_MS;
+  s->next_dump = s->frame_ps;
+  if(mkdir(s->dir, 0755) && errno != EEXIST) {
+    fprintf(stderr, "[st7789] %s: %s\n", s->dir, strerror(errno));
+    ret = RC_ERROR;
+  }
+
+out:
+  if(jargs)
+    json_object_put(jargs);
+  if(ret != RC_OK && s) {
+    free(s);
+    s = NULL;
+  }
+  if(sess)
+    *sess = (void *)s;
+  return ret;
+}
+
+static int st7789_add_pads(void *sess, struct pad_list_s *plist) {
+  int ret = RC_OK;
+  struct session_s *s = (struct session_s *)sess;
+  struct pad_s *pads;
+
+  if(!sess || !plist) {
+    ret = RC_INVARG;
+    goto out;
+  }
+  pads = plist->pads;
+
+  if(!strcmp(plist->name, "spi")) {
+    litex_sim_module_pads_get(pads, "clk", (void **)&s->clk);
+    litex_sim_module_pads_get(pads, "mosi", (void **)&s->mosi);
+    litex_sim_module_pads_get(pads, "cs_n", (void **)&s->cs_n);
+  }
+  if(!strcmp(plist->name, "lcd_dc"))
+    litex_sim_module_pads_get(pads, "lcd_dc", (void **)&s->dc);
+  if(!strcmp(plist->name, "lcd_reset"))
+    litex_sim_module_pads_get(pads, "lcd_reset", (void **)&s->reset);
+  if(!strcmp(plist->name, "sys_clk"))
+    litex_sim_module_pads_get(pads, "sys_clk", (void **)&s->sys_clk);
+
+out:
+  return ret;
+}
+
+static int st7789_tick(void *sess, uint64_t time_ps) {
+  struct session_s *s = (struct session_s *)sess;
+  int clk;
+
+  if(!clk_pos_edge(&s->edge, *s->sys_clk))
+    return RC_OK;
+
+  if(time_ps >= s->next_dump) {
+    if(s->dirty)
+      dump_frame(s);
+    s->next_dump += s->frame_ps;
+  }
+
+  if(s->reset && !(*s->reset & 1)) {
+    lcd_reset(s);
+    s->bits = 0;
+    return RC_OK;
+  }
+
+  clk = *s->clk & 1;
+  if(*s->cs_n & 1) {
+    s->bits = 0;   /* CS alto descarta byte parcial */
+  } else if(clk && !s->prev_clk) {
+    s->shift = (s->shift << 1) | (*s->mosi & 1);
+    if(++s->bits == 8) {
+      s->bits = 0;
+      if(*s->dc & 1)
+        lcd_data(s, s->shift);
+      else
+        lcd_command(s, s->shift);
+    }
+  }
+  s->prev_clk = clk;
+  return RC_OK;
+}
+
+static int st7789_close(void *sess) {
+  struct session_s *s = (struct session_s *)sess;
+
+  if(s) {
+    if(s->dirty)
+      dump_frame(s);
+    free(s);
+  }
+  return RC_OK;
+}
+
+static struct ext_module_s ext_mod = {
+  "st7789",
+  st7789_start,
+  st7789_new,
+  st7789_add_pads,
+  st7789_close,
+  st7789_tick
+};
+
+int litex_sim_ext_module_init(int (*register_module)(struct ext_module_s *)) {
+  int ret = RC_OK;
+  ret = register_module(&ext_mod);
+  return ret;
+}